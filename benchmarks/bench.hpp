@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+#ifndef __LOG_PP_BENCH_HPP__
+#define __LOG_PP_BENCH_HPP__
+
+namespace bench {
+
+/**
+ * @brief Keeps `value` alive so the optimizer cannot drop the benchmarked
+ * work.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Runs `body` `iterations` times and prints nanoseconds per call.
+ * @return Nanoseconds per iteration.
+ */
+template <typename F>
+double run(const char* name, std::size_t iterations, F&& body) {
+    for (std::size_t i = 0; i < iterations / 10; ++i) {
+        body();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        body();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto ns = std::chrono::duration<double, std::nano>(elapsed).count() /
+              static_cast<double>(iterations);
+    std::printf("%-40s %10.1f ns/op\n", name, ns);
+    return ns;
+}
+
+}  // namespace bench
+
+#endif  // !__LOG_PP_BENCH_HPP__
@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "bench.hpp"
+#include "binary_encoder.hpp"
+#include "block_compress.hpp"
+#include "encoder.hpp"
+#include "log.hpp"
+
+namespace {
+
+constexpr std::size_t ITERATIONS = 500;
+constexpr std::size_t BLOCK_SIZE = 256 * 1024;
+
+// Fills one block with records like a busy service would emit.
+std::string make_block(const log_pp::Encoder& encoder) {
+    std::string block;
+    for (int i = 0; block.size() < BLOCK_SIZE; ++i) {
+        int rows = i % 97;
+        double elapsed = (i * 7 % 1000) / 10.0;
+        auto args = std::make_format_args(rows, elapsed);
+        log_pp::KVList kvs{{"request_id", 100'000 + i},
+                           {"user", i % 3 == 0 ? "alice" : "bob"},
+                           {"cached", i % 5 == 0}};
+        auto record = log_pp::RecordBuilder{}
+                          .set_level(log_pp::Level::Info)
+                          .set_target("http")
+                          .set_format_string("served {} rows in {}ms")
+                          .set_args(args)
+                          .set_kvs(kvs)
+                          .set_timestamp(log_pp::Timestamp{
+                              1'760'000'000'000'000'000ull + i * 13'000ull})
+                          .build();
+        encoder.encode(record, block);
+    }
+    return block;
+}
+
+void run_block(const char* name, const std::string& block) {
+    std::string compressed;
+    std::string label = std::string(name) + ", compress 256 KiB";
+    auto compress_ns = bench::run(label.c_str(), ITERATIONS, [&] {
+        compressed.clear();
+        log_pp::append_block(compressed, block, true);
+        bench::do_not_optimize(compressed);
+    });
+    std::string restored;
+    label = std::string(name) + ", decompress 256 KiB";
+    auto decompress_ns = bench::run(label.c_str(), ITERATIONS, [&] {
+        restored.clear();
+        log_pp::read_block(compressed, restored);
+        bench::do_not_optimize(restored);
+    });
+    std::printf("%-40s %10.2f x, %.0f / %.0f MB/s\n", name,
+                static_cast<double>(block.size()) /
+                    static_cast<double>(compressed.size()),
+                static_cast<double>(block.size()) / compress_ns * 1000.0,
+                static_cast<double>(block.size()) / decompress_ns * 1000.0);
+}
+
+}  // namespace
+
+int main() {
+    run_block("text records", make_block(log_pp::TextEncoder{}));
+    run_block("binary records", make_block(log_pp::BinaryEncoder{}));
+    return 0;
+}
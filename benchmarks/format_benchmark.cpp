@@ -0,0 +1,111 @@
+#include <array>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <string>
+
+#include "bench.hpp"
+#include "encoder.hpp"
+#include "log.hpp"
+
+namespace {
+
+constexpr std::size_t ITERATIONS = 1'000'000;
+
+}  // namespace
+
+int main() {
+    std::string out;
+
+    // Message-heavy: scalar arguments with default and common specs.
+    int status = 200;
+    unsigned id = 0xBEEF;
+    double elapsed = 12.3456;
+    bool cached = true;
+    const std::string format =
+        "status={} id={:08X} elapsed={:.2f}ms cached={} rows={}";
+    auto args = std::make_format_args(status, id, elapsed, cached, status);
+    auto message = log_pp::RecordBuilder{}
+                       .set_level(log_pp::Level::Info)
+                       .set_target("http")
+                       .set_format_string(format)
+                       .set_args(args)
+                       .build();
+    bench::run("message, std::vformat_to", ITERATIONS, [&] {
+        out.clear();
+        std::vformat_to(std::back_inserter(out), format, args);
+        bench::do_not_optimize(out);
+    });
+    bench::run("message, to_chars fast path", ITERATIONS, [&] {
+        out.clear();
+        log_pp::detail::append_message(out, message);
+        bench::do_not_optimize(out);
+    });
+
+    // KV-heavy: explicit value formats on every field.
+    const std::string hex = "0x{:04X}";
+    const std::string fixed = "{:.3f}";
+    bench::run("kv specs, std::vformat_to", ITERATIONS, [&] {
+        out.clear();
+        std::vformat_to(std::back_inserter(out), hex,
+                        std::make_format_args(id));
+        std::vformat_to(std::back_inserter(out), fixed,
+                        std::make_format_args(elapsed));
+        std::vformat_to(std::back_inserter(out), hex,
+                        std::make_format_args(status));
+        bench::do_not_optimize(out);
+    });
+    bench::run("kv specs, to_chars fast path", ITERATIONS, [&] {
+        out.clear();
+        log_pp::detail::format_kv_value_to<char>(out, id, hex);
+        log_pp::detail::format_kv_value_to<char>(out, elapsed, fixed);
+        log_pp::detail::format_kv_value_to<char>(out, status, hex);
+        bench::do_not_optimize(out);
+    });
+
+    log_pp::KVList kvs{{"id", id, "0x{:04X}"},
+                       {"elapsed_ms", elapsed, "{:.3f}"},
+                       {"status", status},
+                       {"ratio", 0.25},
+                       {"cached", cached}};
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_target("http")
+                      .set_format_string("request done")
+                      .set_kvs(kvs)
+                      .build();
+    log_pp::TextEncoder encoder;
+    bench::run("TextEncoder, kv-heavy record", ITERATIONS, [&] {
+        out.clear();
+        encoder.encode(record, out);
+        bench::do_not_optimize(out);
+    });
+
+    // Binary payloads: hand-built hex string versus a lazy bytes KV.
+    std::array<uint8_t, 32> digest{};
+    for (std::size_t i = 0; i < digest.size(); ++i) {
+        digest[i] = static_cast<uint8_t>(i * 73 + 5);
+    }
+    bench::run("digest, hex via std::format", ITERATIONS, [&] {
+        std::string text;
+        for (auto byte : digest) {
+            text += std::format("{:02x}", byte);
+        }
+        out.clear();
+        log_pp::KV("sha256", std::move(text)).append_value(out);
+        bench::do_not_optimize(out);
+    });
+    bench::run("digest, bytes KV hex", ITERATIONS, [&] {
+        out.clear();
+        log_pp::KV("sha256", log_pp::bytes(digest)).append_value(out);
+        bench::do_not_optimize(out);
+    });
+    bench::run("digest, bytes KV base64", ITERATIONS, [&] {
+        out.clear();
+        log_pp::KV("sha256",
+                   log_pp::bytes(digest, log_pp::BytesEncoding::Base64))
+            .append_value(out);
+        bench::do_not_optimize(out);
+    });
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <string>
+
+#include "bench.hpp"
+#include "json_encoder.hpp"
+#include "log.hpp"
+#include "text_scan.hpp"
+
+namespace {
+
+constexpr std::size_t ITERATIONS = 1'000'000;
+
+// Byte-at-a-time escaping, the baseline the vector scan replaces.
+void escape_scalar(std::string& out, std::string_view text) {
+    for (char ch : text) {
+        auto byte = static_cast<unsigned char>(ch);
+        if (ch == '"' || ch == '\\' || byte < 0x20) {
+            log_pp::detail::append_json_escape(out, byte);
+        } else {
+            out.push_back(ch);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    const std::string message =
+        "GET /api/v1/orders?customer=18842&status=open served in 12ms by "
+        "worker-7 (cache hit, 3 rows, \"fast path\")";
+
+    std::string out;
+    bench::run("escape, scalar", ITERATIONS, [&] {
+        out.clear();
+        escape_scalar(out, message);
+        bench::do_not_optimize(out);
+    });
+    bench::run("escape, vector scan", ITERATIONS, [&] {
+        out.clear();
+        log_pp::detail::append_json_escaped(out, std::string_view(message));
+        bench::do_not_optimize(out);
+    });
+
+    int rows = 3;
+    log_pp::KVList kvs{{"rows", rows}, {"cache", true}, {"worker", "w-7"}};
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_target("http")
+                      .set_format_string(message)
+                      .set_kvs(kvs)
+                      .build();
+    log_pp::JsonEncoder encoder;
+    bench::run("JsonEncoder, reused buffer", ITERATIONS, [&] {
+        out.clear();
+        encoder.encode(record, out);
+        bench::do_not_optimize(out);
+    });
+    return 0;
+}
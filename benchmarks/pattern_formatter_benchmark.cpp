@@ -0,0 +1,95 @@
+#include <chrono>
+#include <format>
+#include <string>
+
+#include "bench.hpp"
+#include "log.hpp"
+#include "pattern_formatter.hpp"
+#include "timestamp_renderer.hpp"
+
+namespace {
+
+constexpr std::size_t ITERATIONS = 1'000'000;
+
+// The per-logger layout code the pattern formatter replaces.
+std::string hand_written(const log_pp::Record& record) {
+    std::string kvs;
+    for (const auto& kv : record.get_kvs()) {
+        if (!kvs.empty()) {
+            kvs += ' ';
+        }
+        kvs += std::format("{}={}", kv.get_key_str(), kv.get_value_string());
+    }
+    using namespace std::chrono;
+    auto now = system_clock::now();
+    auto day_start = floor<days>(now);
+    year_month_day ymd{day_start};
+    hh_mm_ss hms{floor<seconds>(now - day_start)};
+    return std::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02} {} {} {}:{} {} {}\n",
+                       static_cast<int>(ymd.year()),
+                       static_cast<unsigned>(ymd.month()),
+                       static_cast<unsigned>(ymd.day()), hms.hours().count(),
+                       hms.minutes().count(), hms.seconds().count(),
+                       record.get_level(), record.get_target(),
+                       record.get_file().value_or(""),
+                       record.get_line().value_or(0),
+                       std::vformat(record.get_format_string(),
+                                    record.get_args()),
+                       kvs);
+}
+
+}  // namespace
+
+int main() {
+    int id = 42;
+    auto args = std::make_format_args(id);
+    log_pp::KVList kvs{{"user", "alice"}, {"ok", true}};
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_target("http")
+                      .set_format_string("request {} served")
+                      .set_args(args)
+                      .set_kvs(kvs)
+                      .set_module(std::source_location::current())
+                      .build();
+
+    bench::run("std::format per record", ITERATIONS, [&] {
+        auto out = hand_written(record);
+        bench::do_not_optimize(out);
+    });
+
+    log_pp::PatternFormatter formatter("%Y-%m-%dT%H:%M:%S %l %n %s:%# %v %k");
+    std::string buffer;
+    bench::run("PatternFormatter, reused buffer", ITERATIONS, [&] {
+        buffer.clear();
+        formatter.encode(record, buffer);
+        bench::do_not_optimize(buffer);
+    });
+
+    // Timestamps only: a fresh calendar conversion per record against the
+    // renderer's per-second prefix cache.
+    auto now = std::chrono::system_clock::now();
+    bench::run("timestamp, std::format per record", ITERATIONS, [&] {
+        using namespace std::chrono;
+        now += microseconds(1);
+        auto day_start = floor<days>(now);
+        year_month_day ymd{day_start};
+        hh_mm_ss hms{floor<microseconds>(now - day_start)};
+        auto out = std::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}.{:06}Z",
+                               static_cast<int>(ymd.year()),
+                               static_cast<unsigned>(ymd.month()),
+                               static_cast<unsigned>(ymd.day()),
+                               hms.hours().count(), hms.minutes().count(),
+                               hms.seconds().count(),
+                               hms.subseconds().count());
+        bench::do_not_optimize(out);
+    });
+    log_pp::TimestampRenderer renderer;
+    bench::run("timestamp, TimestampRenderer", ITERATIONS, [&] {
+        now += std::chrono::microseconds(1);
+        buffer.clear();
+        renderer.append(buffer, now);
+        bench::do_not_optimize(buffer);
+    });
+    return 0;
+}
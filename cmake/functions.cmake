@@ -50,3 +50,19 @@ function(log_pp_create_test target_name)
     log_pp_copy_dependency_dlls(${target_name})
 endfunction()
 
+
+function(log_pp_create_benchmark target_name)
+    add_executable(${target_name})
+    log_pp_set_compiler_options(${target_name})
+    target_link_libraries(
+        ${target_name}
+        PRIVATE
+        log_pp
+    )
+    target_sources(
+        ${target_name}
+        PRIVATE
+        ${target_name}.cpp
+    )
+    log_pp_copy_dependency_dlls(${target_name})
+endfunction()
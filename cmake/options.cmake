@@ -6,6 +6,8 @@ endif()
 
 option(BUILD_EXAMPLES "Build examples" ${PROJECT_IS_TOP_LEVEL})
 
+option(BUILD_BENCHMARKS "Build benchmarks" OFF)
+
 option(LOG_PP_LEVEL_FILTER_TRACE "compile time log level filter with trace" OFF)
 option(LOG_PP_LEVEL_FILTER_DEBUG "compile time log level filter with debug" OFF)
 option(LOG_PP_LEVEL_FILTER_INFO "compile time log level filter with info" OFF)
@@ -18,6 +20,11 @@ option(LOG_PP_RELEASE_LEVEL_FILTER_INFO "compile time log level filter with info
 option(LOG_PP_RELEASE_LEVEL_FILTER_WARN "compile time log level filter with warn in release mode" OFF)
 option(LOG_PP_RELEASE_LEVEL_FILTER_ERROR "compile time log level filter with error in release mode" OFF)
 
+set(LOG_PP_TARGET_LEVEL_FILTER "" CACHE STRING
+    "compile time per-target log levels, e.g. wire=info,db::pool=off")
+set(LOG_PP_RELEASE_TARGET_LEVEL_FILTER "" CACHE STRING
+    "compile time per-target log levels in release mode")
+
 set(_log_pp_level_filter_non_release_defines "")
 if(LOG_PP_LEVEL_FILTER_TRACE)
     list(APPEND _log_pp_level_filter_non_release_defines LOG_PP_LEVEL_FILTER_TRACE)
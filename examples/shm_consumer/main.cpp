@@ -0,0 +1,62 @@
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "log.hpp"
+#include "shm_ring.hpp"
+
+namespace {
+
+volatile std::sig_atomic_t running = 1;
+
+void stop(int) {
+    running = 0;
+}
+
+// Reads records in place from the ring and ships them to stdout.
+int consume(const std::string& name) {
+    log_pp::ShmRingReader reader(name);
+    if (!reader.is_open()) {
+        std::cerr << "cannot map " << name << "\n";
+        return 1;
+    }
+    while (running) {
+        auto count = reader.drain(
+            [](std::string_view record) { std::cout << record; });
+        if (count == 0) {
+            std::cout.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    std::cerr << "writer dropped " << reader.dropped_count() << " records\n";
+    return 0;
+}
+
+// Publishes a few records through the global logger.
+int produce(const std::string& name) {
+    static log_pp::ShmRingSink sink(std::make_shared<log_pp::TextEncoder>(),
+                                    {.name = name, .unlink_on_close = false});
+    if (!sink.get_ring().is_open()) {
+        std::cerr << "cannot create " << name << "\n";
+        return 1;
+    }
+    log_pp::set_logger(sink);
+    for (int i = 0; running && i < 100; ++i) {
+        LOG_PP_INFO({"app"}, "request {} served", i);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return 0;
+}
+
+}  // namespace
+
+// Usage: shm_consumer produce|consume [name]
+int main(int argc, char** argv) {
+    std::signal(SIGINT, stop);
+    std::string mode = argc > 1 ? argv[1] : "consume";
+    std::string name = argc > 2 ? argv[2] : "/log_pp_ring";
+    return mode == "produce" ? produce(name) : consume(name);
+}
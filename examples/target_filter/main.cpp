@@ -3,20 +3,16 @@
 #include <numeric>
 #include <string>
 
+#include "directive_filter.hpp"
 #include "log.hpp"
 
+// Everything at Trace, except `disabled_target` (off) and `info_target`.
+static log_pp::DirectiveFilter filter(
+    "trace,disabled_target=off,info_target=info");
+
 struct SimpleLogger : public log_pp::ILogger {
     virtual bool enabled(const log_pp::Metadata& meta) const noexcept {
-        if (meta.get_target() == "enabled_target") {
-            return true;
-        }
-        if (meta.get_target() == "disabled_target") {
-            return false;
-        }
-        if (meta.get_target() == "info_target") {
-            return meta.get_level() <= log_pp::Level::Info;
-        }
-        return true;
+        return filter.enabled(meta);
     }
 
     virtual void log(const log_pp::Record& record) noexcept {
@@ -39,7 +35,7 @@ struct SimpleLogger : public log_pp::ILogger {
 int main() {
     static SimpleLogger logger;
     log_pp::set_logger(logger);
-    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+    log_pp::set_max_level(filter.max_level());
 
     LOG_PP_TRACE({"enabled_target"},
                  "This message will be logged because the target is enabled "
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <memory>
+#include <string_view>
+
+#include "file_sink.hpp"
+#include "log.hpp"
+#include "router_logger.hpp"
+
+struct ConsoleSink : public log_pp::Sink {
+    explicit ConsoleSink(std::shared_ptr<const log_pp::Encoder> encoder)
+        : log_pp::Sink(std::move(encoder)) {}
+
+    void write(std::string_view bytes) override { std::cout << bytes; }
+
+    void flush() override { std::cout.flush(); }
+};
+
+int main() {
+    auto text = std::make_shared<log_pp::TextEncoder>();
+
+    static log_pp::RouterLogger router;
+    // Every `db` target, including `db::pool`, goes to db.log.
+    router.add_route("db*", std::make_shared<log_pp::FileSink>(
+                                text, log_pp::FileSinkOptions{
+                                          .path = "db.log",
+                                          .max_file_size = 1024 * 1024,
+                                      }));
+    router.add_route("http", std::make_shared<log_pp::FileSink>(
+                                 text, log_pp::FileSinkOptions{
+                                           .path = "http.log",
+                                           .buffer_size = 4096,
+                                       }));
+    // Audit records are written as soon as they arrive.
+    router.add_route("audit", std::make_shared<log_pp::FileSink>(
+                                  text, log_pp::FileSinkOptions{
+                                            .path = "audit.log",
+                                            .buffer_size = 0,
+                                        }));
+    router.set_fallback(std::make_shared<ConsoleSink>(text));
+
+    log_pp::set_logger(router);
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+
+    LOG_PP_INFO({"db"}, "connected to {}", "primary");
+    LOG_PP_DEBUG({"db::pool"}, "pool size {}", 8);
+    LOG_PP_INFO({"http"}, {{"status", 200}}, "GET {}", "/index.html");
+    LOG_PP_WARN({"audit"}, {{"user", "alice"}}, "permission changed");
+    LOG_PP_INFO("This message has no route and goes to the console");
+
+    router.flush();
+    return 0;
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "bytes.hpp"
+#include "encoder.hpp"
+#include "kv.hpp"
+#include "record.hpp"
+
+#ifndef __LOG_PP_BINARY_ENCODER_HPP__
+#define __LOG_PP_BINARY_ENCODER_HPP__
+
+namespace log_pp {
+
+/** @brief Type tag of a key-value in @ref BinaryEncoder output. */
+enum class BinaryValueType : uint8_t {
+    /** @brief Zigzag varint. */
+    Int64,
+    /** @brief Varint. */
+    UInt64,
+    /** @brief 4 bytes, IEEE 754 little-endian. */
+    Float,
+    /** @brief 8 bytes, IEEE 754 little-endian. */
+    Double,
+    /** @brief 1 byte, 0 or 1. */
+    Bool,
+    /** @brief Length-prefixed UTF-8 text. */
+    String,
+    /** @brief Length-prefixed raw bytes from a @ref Bytes value. */
+    Bytes,
+    /** @brief Length-prefixed text rendered by `std::format`. */
+    Custom,
+};
+
+namespace detail {
+
+inline void append_varint(std::string& out, uint64_t value) {
+    char buffer[10];
+    std::size_t size = 0;
+    while (value >= 0x80) {
+        buffer[size++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    buffer[size++] = static_cast<char>(value);
+    out.append(buffer, size);
+}
+
+template <std::unsigned_integral T>
+void append_le(std::string& out, T value) {
+    char buffer[sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        buffer[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.append(buffer, sizeof(T));
+}
+
+inline void append_binary_string(std::string& out, std::string_view text) {
+    append_varint(out, text.size());
+    out.append(text);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Compact binary layout with native key-value types.
+ *
+ * Each record is a little-endian, length-prefixed frame (`varint` is
+ * unsigned LEB128, `str` is a varint length followed by the bytes):
+ * @code
+ * u32     size of the rest of the frame
+ * u8      level (1 = ERROR .. 5 = TRACE)
+ * u8      flags: 1 timestamp, 2 source location, 4 thread
+ * [u64    timestamp, nanoseconds since the Unix epoch]
+ * [str    file, varint line]
+ * [varint thread id, str thread name]
+ * str     target
+ * str     message
+ * varint  key-value count, then per key-value: str key, u8 type, value
+ * @endcode
+ *
+ * Key-values keep their native encoding (see @ref BinaryValueType): numbers
+ * are not rendered as text and @ref Bytes payloads are copied untouched,
+ * without the `max_size` truncation applied by text encoders.
+ *
+ * Usually paired with @ref CompressedFileSink.
+ */
+struct BinaryEncoder : public Encoder {
+    /** @brief Frame flag: a timestamp follows the flags byte. */
+    static constexpr uint8_t HAS_TIMESTAMP = 1;
+    /** @brief Frame flag: file and line are present. */
+    static constexpr uint8_t HAS_SOURCE = 2;
+    /** @brief Frame flag: thread id and name are present. */
+    static constexpr uint8_t HAS_THREAD = 4;
+
+    void encode(const Record& record, std::string& out) const override {
+        auto start = out.size();
+        detail::append_le<uint32_t>(out, 0);
+
+        auto timestamp = record.get_timestamp();
+        auto file = record.get_file();
+        auto thread_id = record.get_thread_id();
+        uint8_t flags = (timestamp ? HAS_TIMESTAMP : 0) |
+                        (file ? HAS_SOURCE : 0) | (thread_id ? HAS_THREAD : 0);
+        out.push_back(static_cast<char>(record.get_level()));
+        out.push_back(static_cast<char>(flags));
+        if (timestamp) {
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                timestamp->time_since_epoch());
+            detail::append_le(out, static_cast<uint64_t>(nanos.count()));
+        }
+        if (file) {
+            detail::append_binary_string(out, *file);
+            detail::append_varint(out, record.get_line().value_or(0));
+        }
+        if (thread_id) {
+            detail::append_varint(out, *thread_id);
+            detail::append_binary_string(
+                out, record.get_thread_name().value_or(""));
+        }
+        detail::append_binary_string(out, record.get_target());
+
+        auto& text = scratch();
+        detail::append_message(text, record);
+        detail::append_binary_string(out, text);
+
+        const auto& kvs = record.get_kvs();
+        detail::append_varint(out, kvs.size());
+        for (const auto& kv : kvs) {
+            detail::append_binary_string(out, kv.get_key_str());
+            kv.visit([&out](const auto& native) { append_value(out, native); });
+        }
+
+        auto size = static_cast<uint32_t>(out.size() - start - 4);
+        for (std::size_t i = 0; i < 4; ++i) {
+            out[start + i] = static_cast<char>(size >> (8 * i));
+        }
+    }
+
+   private:
+    // Text whose length is only known once rendered (message, custom values)
+    // is rendered here first so its varint length can precede it.
+    static std::string& scratch() {
+        thread_local std::string text;
+        text.clear();
+        return text;
+    }
+
+    template <typename T>
+    static void append_value(std::string& out, const T& value) {
+        auto tag = [&out](BinaryValueType type) {
+            out.push_back(static_cast<char>(type));
+        };
+        if constexpr (std::same_as<T, int64_t>) {
+            tag(BinaryValueType::Int64);
+            auto bits = static_cast<uint64_t>(value);
+            detail::append_varint(out, (bits << 1) ^ (value < 0 ? ~0ull : 0));
+        } else if constexpr (std::same_as<T, uint64_t>) {
+            tag(BinaryValueType::UInt64);
+            detail::append_varint(out, value);
+        } else if constexpr (std::same_as<T, float>) {
+            tag(BinaryValueType::Float);
+            detail::append_le(out, std::bit_cast<uint32_t>(value));
+        } else if constexpr (std::same_as<T, double>) {
+            tag(BinaryValueType::Double);
+            detail::append_le(out, std::bit_cast<uint64_t>(value));
+        } else if constexpr (std::same_as<T, bool>) {
+            tag(BinaryValueType::Bool);
+            out.push_back(value ? 1 : 0);
+        } else if constexpr (std::same_as<T, std::string_view>) {
+            tag(BinaryValueType::String);
+            detail::append_binary_string(out, value);
+        } else if constexpr (std::same_as<T, Bytes>) {
+            tag(BinaryValueType::Bytes);
+            detail::append_varint(out, value.data.size());
+            out.append(reinterpret_cast<const char*>(value.data.data()),
+                       value.data.size());
+        } else {
+            tag(BinaryValueType::Custom);
+            auto& text = scratch();
+            value.append_to(text);
+            detail::append_binary_string(out, text);
+        }
+    }
+};
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_BINARY_ENCODER_HPP__
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "text_scan.hpp"
+
+#if defined(LOG_PP_TEXT_SCAN_SSE2) && defined(__SSSE3__)
+#include <tmmintrin.h>
+#define LOG_PP_BYTES_SSSE3 1
+#endif
+#if defined(LOG_PP_TEXT_SCAN_NEON) && \
+    (defined(__aarch64__) || defined(_M_ARM64))
+#define LOG_PP_BYTES_NEON_A64 1
+#endif
+
+#ifndef __LOG_PP_BYTES_HPP__
+#define __LOG_PP_BYTES_HPP__
+
+namespace log_pp {
+
+/** @brief Text form of a @ref Bytes key-value. */
+enum class BytesEncoding : uint8_t {
+    /** @brief Lower-case hex, two characters per byte. */
+    Hex,
+    /** @brief Standard base64 with `=` padding. */
+    Base64,
+};
+
+/**
+ * @brief Binary key-value value: a view of bytes rendered lazily.
+ *
+ * Only the view is stored, so the bytes must outlive the record (as with
+ * string views). Text encoders render at most `max_size` bytes and append
+ * `...` when the payload is longer; binary encoders receive the full span.
+ *
+ * Example:
+ * @code
+ * using log_pp::BytesEncoding;
+ * LOG_PP_DEBUG({{"header", log_pp::bytes(packet.first(20))},
+ *               {"sha256", log_pp::bytes(digest, BytesEncoding::Base64)}},
+ *              "packet received");
+ * @endcode
+ */
+struct Bytes {
+    /** @brief Default number of bytes rendered by text encoders. */
+    static constexpr std::size_t DEFAULT_MAX_SIZE = 64;
+
+    std::span<const std::byte> data{};
+    BytesEncoding encoding = BytesEncoding::Hex;
+    std::size_t max_size = DEFAULT_MAX_SIZE;
+};
+
+/**
+ * @brief Wraps a contiguous range of trivially copyable elements as
+ * @ref Bytes.
+ *
+ * @param range Bytes to log (e.g. `std::array<uint8_t, N>`, `std::span`,
+ * `std::vector<std::byte>`, `std::string_view`).
+ * @param encoding Text form.
+ * @param max_size Bytes rendered by text encoders before truncation.
+ * @return Bytes view of `range`.
+ */
+template <std::ranges::contiguous_range R>
+    requires std::is_trivially_copyable_v<std::ranges::range_value_t<R>>
+Bytes bytes(const R& range,
+            BytesEncoding encoding = BytesEncoding::Hex,
+            std::size_t max_size = Bytes::DEFAULT_MAX_SIZE) noexcept {
+    return {std::as_bytes(std::span(std::ranges::data(range),
+                                    std::ranges::size(range))),
+            encoding, max_size};
+}
+
+/**
+ * @brief Wraps `size` bytes at `data` as @ref Bytes.
+ *
+ * @param data First byte.
+ * @param size Number of bytes.
+ * @param encoding Text form.
+ * @param max_size Bytes rendered by text encoders before truncation.
+ * @return Bytes view.
+ */
+inline Bytes bytes(const void* data,
+                   std::size_t size,
+                   BytesEncoding encoding = BytesEncoding::Hex,
+                   std::size_t max_size = Bytes::DEFAULT_MAX_SIZE) noexcept {
+    return {std::span(static_cast<const std::byte*>(data), size), encoding,
+            max_size};
+}
+
+namespace detail {
+
+inline constexpr char HEX_DIGITS[] = "0123456789abcdef";
+inline constexpr char BASE64_ALPHABET[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+constexpr std::size_t hex_size(std::size_t size) noexcept {
+    return size * 2;
+}
+
+constexpr std::size_t base64_size(std::size_t size) noexcept {
+    return (size + 2) / 3 * 4;
+}
+
+/** @brief Writes `hex_size(size)` characters to `dst`, 16 bytes at a time. */
+inline void encode_hex(char* dst,
+                       const unsigned char* src,
+                       std::size_t size) noexcept {
+    std::size_t pos = 0;
+#if defined(LOG_PP_TEXT_SCAN_SSE2)
+    // nibble + '0', plus ('a' - '0' - 10) for nibbles above 9.
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero_char = _mm_set1_epi8('0');
+    const __m128i letter_gap = _mm_set1_epi8('a' - '0' - 10);
+    auto to_hex = [&](__m128i nibbles) {
+        __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, nine),
+                                        letter_gap);
+        return _mm_add_epi8(_mm_add_epi8(nibbles, zero_char), letters);
+    };
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+        __m128i hi = to_hex(_mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i lo = to_hex(_mm_and_si128(v, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pos * 2),
+                         _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pos * 2 + 16),
+                         _mm_unpackhi_epi8(hi, lo));
+    }
+#elif defined(LOG_PP_TEXT_SCAN_NEON)
+    const uint8x16_t mask = vdupq_n_u8(0x0F);
+    const uint8x16_t nine = vdupq_n_u8(9);
+    const uint8x16_t zero_char = vdupq_n_u8('0');
+    const uint8x16_t letter_gap = vdupq_n_u8('a' - '0' - 10);
+    auto to_hex = [&](uint8x16_t nibbles) {
+        uint8x16_t letters = vandq_u8(vcgtq_u8(nibbles, nine), letter_gap);
+        return vaddq_u8(vaddq_u8(nibbles, zero_char), letters);
+    };
+    for (; pos + 16 <= size; pos += 16) {
+        uint8x16_t v = vld1q_u8(src + pos);
+        uint8x16x2_t pair;
+        pair.val[0] = to_hex(vshrq_n_u8(v, 4));
+        pair.val[1] = to_hex(vandq_u8(v, mask));
+        vst2q_u8(reinterpret_cast<uint8_t*>(dst + pos * 2), pair);
+    }
+#endif
+    for (; pos < size; ++pos) {
+        dst[pos * 2] = HEX_DIGITS[src[pos] >> 4];
+        dst[pos * 2 + 1] = HEX_DIGITS[src[pos] & 0x0F];
+    }
+}
+
+/**
+ * @brief Writes `base64_size(size)` characters to `dst`.
+ *
+ * Uses SSSE3 (12 bytes per step) or AArch64 NEON (48 bytes per step) when
+ * available, the scalar loop elsewhere and for the tail.
+ */
+inline void encode_base64(char* dst,
+                          const unsigned char* src,
+                          std::size_t size) noexcept {
+    std::size_t pos = 0;
+#if defined(LOG_PP_BYTES_SSSE3)
+    // Wojciech Mula's pshufb/multiply-shift kernel; loads 16 bytes, uses 12.
+    const __m128i shuffle =
+        _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i shift_lut = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    for (; pos + 16 <= size; pos += 12, dst += 16) {
+        __m128i in = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos)),
+            shuffle);
+        __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+        __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+        __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t1, t3);
+        __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        __m128i below_26 = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        reduced = _mm_or_si128(
+            reduced, _mm_and_si128(below_26, _mm_set1_epi8(13)));
+        __m128i chars =
+            _mm_add_epi8(_mm_shuffle_epi8(shift_lut, reduced), indices);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), chars);
+    }
+#elif defined(LOG_PP_BYTES_NEON_A64)
+    const uint8x16x4_t alphabet = vld1q_u8_x4(
+        reinterpret_cast<const uint8_t*>(BASE64_ALPHABET));
+    const uint8x16_t six_bits = vdupq_n_u8(0x3F);
+    for (; pos + 48 <= size; pos += 48, dst += 64) {
+        uint8x16x3_t in = vld3q_u8(src + pos);
+        uint8x16x4_t out;
+        out.val[0] = vshrq_n_u8(in.val[0], 2);
+        out.val[1] = vandq_u8(
+            vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)),
+            six_bits);
+        out.val[2] = vandq_u8(
+            vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)),
+            six_bits);
+        out.val[3] = vandq_u8(in.val[2], six_bits);
+        for (auto& lane : out.val) {
+            lane = vqtbl4q_u8(alphabet, lane);
+        }
+        vst4q_u8(reinterpret_cast<uint8_t*>(dst), out);
+    }
+#endif
+    for (; pos + 3 <= size; pos += 3, dst += 4) {
+        uint32_t group = (uint32_t{src[pos]} << 16) |
+                         (uint32_t{src[pos + 1]} << 8) | src[pos + 2];
+        dst[0] = BASE64_ALPHABET[(group >> 18) & 0x3F];
+        dst[1] = BASE64_ALPHABET[(group >> 12) & 0x3F];
+        dst[2] = BASE64_ALPHABET[(group >> 6) & 0x3F];
+        dst[3] = BASE64_ALPHABET[group & 0x3F];
+    }
+    if (pos < size) {
+        uint32_t group = uint32_t{src[pos]} << 16;
+        if (pos + 1 < size) {
+            group |= uint32_t{src[pos + 1]} << 8;
+        }
+        dst[0] = BASE64_ALPHABET[(group >> 18) & 0x3F];
+        dst[1] = BASE64_ALPHABET[(group >> 12) & 0x3F];
+        dst[2] = pos + 1 < size ? BASE64_ALPHABET[(group >> 6) & 0x3F] : '=';
+        dst[3] = '=';
+    }
+}
+
+/**
+ * @brief Appends the text form of `value` to `out`, truncated to
+ * `value.max_size` bytes followed by `...`.
+ */
+template <typename CharT>
+void append_bytes(std::basic_string<CharT>& out, const Bytes& value) {
+    auto size = std::min(value.data.size(), value.max_size);
+    const auto* src = reinterpret_cast<const unsigned char*>(value.data.data());
+    bool hex = value.encoding == BytesEncoding::Hex;
+    auto length = hex ? hex_size(size) : base64_size(size);
+
+    auto encode = [&](char* dst) {
+        if (hex) {
+            encode_hex(dst, src, size);
+        } else {
+            encode_base64(dst, src, size);
+        }
+    };
+    if constexpr (std::same_as<CharT, char>) {
+        auto start = out.size();
+        out.resize(start + length);
+        encode(out.data() + start);
+    } else {
+        thread_local std::string scratch;
+        scratch.resize(length);
+        encode(scratch.data());
+        for (char ch : scratch) {
+            out.push_back(static_cast<CharT>(ch));
+        }
+    }
+    if (size < value.data.size()) {
+        for (char ch : std::string_view("...")) {
+            out.push_back(static_cast<CharT>(ch));
+        }
+    }
+}
+
+}  // namespace detail
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_BYTES_HPP__
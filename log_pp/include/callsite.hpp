@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "level.hpp"
+#include "target_intern.hpp"
+#include "log_pp_export.h"
+
+#ifndef __LOG_PP_CALLSITE_HPP__
+#define __LOG_PP_CALLSITE_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Level override for the callsites in matching files and functions.
+ *
+ * `file` is matched against the full path and against every suffix starting
+ * after a `/` or `\`, so `"src/net/io*"` matches `/app/src/net/io.cpp`.
+ * `function` is matched against the qualified function name without return
+ * type or parameters, e.g. `"Parser::parse*"`. Both are globs where `*`
+ * matches any run of characters (including `/`) and `?` one character.
+ */
+struct CallsiteRule {
+    /** @brief File glob. */
+    std::string file = "*";
+    /** @brief Qualified function name glob. */
+    std::string function = "*";
+    /**
+     * @brief Level allowed at matching callsites, replacing `max_level()`.
+     * It also takes precedence over `DirectiveFilter` and sink levels.
+     */
+    LevelFilter level = LevelFilter::Trace;
+};
+
+/**
+ * @brief Per-callsite cache of the @ref CallsiteRule result.
+ *
+ * The `LOG_PP_*` macros keep one in a function-local static per statement.
+ * The first call registers it and evaluates the rules once; later calls pay
+ * a single relaxed load. @ref set_callsite_rules re-evaluates every
+ * registered callsite. Statements also cache their target's @ref TargetId
+ * here.
+ */
+struct Callsite {
+    /** @brief Not evaluated yet. */
+    static constexpr int8_t UNRESOLVED = -1;
+    /** @brief No rule matched; the global `max_level()` applies. */
+    static constexpr int8_t NO_RULE = -2;
+
+    /** @brief Cached `LevelFilter`, or one of the sentinels above. */
+    std::atomic<int8_t> state{UNRESOLVED};
+    /** @brief Interned ID of the statement's last target. */
+    std::atomic<TargetId> target_id{NO_TARGET_ID};
+    /** @brief Location captured on first use. */
+    std::source_location location{};
+    /** @brief Next registered callsite. */
+    Callsite* next = nullptr;
+
+    constexpr Callsite() noexcept = default;
+    Callsite(const Callsite&) = delete;
+    Callsite& operator=(const Callsite&) = delete;
+};
+
+/**
+ * @brief Source location of a statement, with its callsite cache if any.
+ *
+ * Converts implicitly from `std::source_location`, so direct `log()` calls
+ * keep working; those evaluate no rules and use `max_level()`.
+ */
+struct CallsiteRef {
+    /** @brief Location of the statement. */
+    std::source_location location{};
+    /** @brief Cache shared by every call of the statement, or `nullptr`. */
+    Callsite* site = nullptr;
+
+    constexpr CallsiteRef(std::source_location loc) noexcept : location(loc) {}
+    constexpr CallsiteRef(Callsite& callsite,
+                          std::source_location loc) noexcept
+        : location(loc), site(&callsite) {}
+};
+
+namespace detail {
+
+/**
+ * @brief Registers `site` and evaluates the current rules for it.
+ *
+ * @param site Callsite cache.
+ * @param location Location of the statement.
+ * @return New cached state.
+ */
+LOG_PP_EXPORT int8_t resolve_callsite(Callsite& site,
+                                      std::source_location location) noexcept;
+
+}  // namespace detail
+
+/**
+ * @brief Replaces the callsite rules and re-evaluates every known callsite.
+ *
+ * When several rules match a callsite, the last one wins. Callsites without
+ * a matching rule use `max_level()`.
+ *
+ * Example:
+ * @code
+ * log_pp::set_callsite_rules({
+ *     {.file = "src/net/io*", .level = log_pp::LevelFilter::Trace},
+ *     {.function = "Parser::parse*", .level = log_pp::LevelFilter::Debug},
+ * });
+ * @endcode
+ *
+ * @param rules New rules; empty to remove every override.
+ * @return Nothing.
+ */
+LOG_PP_EXPORT void set_callsite_rules(std::vector<CallsiteRule> rules);
+
+/**
+ * @brief Matches `text` against a glob with `*` and `?` wildcards.
+ *
+ * @param pattern Glob pattern.
+ * @param text Text to match.
+ * @return `true` if the whole of `text` matches.
+ */
+LOG_PP_EXPORT bool glob_match(std::string_view pattern,
+                              std::string_view text) noexcept;
+
+/**
+ * @brief Extracts the qualified name from a `function_name()` signature.
+ *
+ * Example: `"void ns::Parser::parse(int)"` becomes `"ns::Parser::parse"`.
+ *
+ * @param signature Compiler-provided function signature.
+ * @return Qualified function name (a view into `signature`).
+ */
+LOG_PP_EXPORT std::string_view qualified_function_name(
+    std::string_view signature) noexcept;
+
+}  // namespace log_pp
+
+/**
+ * @brief Evaluates to a @ref log_pp::CallsiteRef with a per-statement cache.
+ *
+ * The cache is constant-initialized, so reading it needs no guard check.
+ */
+#define LOG_PP_CALLSITE()                                           \
+    log_pp::CallsiteRef(*[]() -> log_pp::Callsite* {                \
+        static constinit log_pp::Callsite site;                     \
+        return &site;                                               \
+    }(),                                                            \
+                        std::source_location::current())
+
+#endif  // !__LOG_PP_CALLSITE_HPP__
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "log_pp_export.h"
+
+#ifndef __LOG_PP_CLOCK_HPP__
+#define __LOG_PP_CLOCK_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Clock used to timestamp records at the call site.
+ */
+enum class ClockSource : uint8_t {
+    /** @brief `CLOCK_REALTIME` (`std::chrono::system_clock` elsewhere). */
+    Realtime,
+    /**
+     * @brief `CLOCK_REALTIME_COARSE`: cheaper, but only as precise as the
+     * kernel tick (typically 1-4 ms). Same as `Realtime` where unavailable.
+     */
+    RealtimeCoarse,
+    /**
+     * @brief Invariant TSC ticks, converted to wall time only when the
+     * timestamp is read. Available on x86 CPUs that report an invariant TSC.
+     *
+     * The conversion is anchored to `CLOCK_REALTIME` and re-anchored when a
+     * timestamp more than a second past the anchor is converted; the tick
+     * rate is refined over each such interval. Converted times therefore
+     * follow realtime steps and NTP slewing within about a second, and
+     * between anchors they drift by the rate error only (a few microseconds
+     * once refined).
+     */
+    Tsc,
+};
+
+/**
+ * @brief Raw timestamp captured when a record is created.
+ *
+ * Capturing stores the clock reading as-is; @ref to_time_point converts it to
+ * wall time on the consumer side.
+ */
+struct Timestamp {
+    /** @brief Nanoseconds since the Unix epoch, or TSC ticks for `Tsc`. */
+    uint64_t value = 0;
+    /** @brief Clock `value` was read from. */
+    ClockSource source = ClockSource::Realtime;
+};
+
+/**
+ * @brief Selects the clock used by @ref capture_timestamp.
+ *
+ * Switching to `ClockSource::Tsc` for the first time calibrates the TSC
+ * against `CLOCK_REALTIME`, which blocks the caller for about 10 ms.
+ *
+ * @param source Clock to use.
+ * @return `false` (keeping the current clock) when `source` is not available
+ * on this machine.
+ */
+LOG_PP_EXPORT bool set_clock_source(ClockSource source) noexcept;
+/**
+ * @brief Returns the clock used by @ref capture_timestamp.
+ *
+ * @return Current clock source (`Realtime` by default).
+ */
+LOG_PP_EXPORT ClockSource clock_source() noexcept;
+
+/**
+ * @brief Reads the current clock.
+ *
+ * Called once per enabled record by `LOG_PP_*`; disabled records never read
+ * the clock.
+ *
+ * @return Raw timestamp.
+ */
+LOG_PP_EXPORT Timestamp capture_timestamp() noexcept;
+/**
+ * @brief Converts a raw timestamp to wall time.
+ *
+ * @param timestamp Timestamp from @ref capture_timestamp.
+ * @return Wall-clock time point.
+ */
+LOG_PP_EXPORT std::chrono::system_clock::time_point to_time_point(
+    Timestamp timestamp) noexcept;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_CLOCK_HPP__
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "block_compress.hpp"
+#include "encoder.hpp"
+#include "log_pp_export.h"
+#include "sink.hpp"
+
+#ifndef __LOG_PP_COMPRESSED_FILE_SINK_HPP__
+#define __LOG_PP_COMPRESSED_FILE_SINK_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Options for @ref CompressedFileSink.
+ */
+struct CompressedFileSinkOptions {
+    /** @brief Output file path; blocks are appended to an existing file. */
+    std::filesystem::path path{};
+    /** @brief Raw bytes collected per block before it is sealed. */
+    std::size_t block_size = 256 * 1024;
+    /** @brief Compress blocks; when false they are framed but stored raw. */
+    bool compress = true;
+    /** @brief Sealed blocks queued for the writer before producers wait. */
+    std::size_t max_pending_blocks = 8;
+};
+
+/**
+ * @brief File sink that writes fixed-size, independently compressed blocks.
+ *
+ * Producers only append encoded records to the current block. Once it holds
+ * `block_size` bytes it is sealed and handed to a background thread, which
+ * compresses it with @ref lz_compress and writes it with a
+ * @ref BlockHeader (see @ref append_block). Records never straddle blocks, so
+ * each block can be located from the headers and decompressed on its own,
+ * in parallel, with @ref read_block. A block torn by a crash at the end of
+ * an existing file is cut off when the file is reopened, and
+ * @ref find_block resyncs readers past damage elsewhere. When the writer falls
+ * `max_pending_blocks` behind, producers wait instead of dropping records.
+ *
+ * Any encoder works; @ref BinaryEncoder gives the smallest output.
+ *
+ * Example:
+ * @code
+ * auto sink = std::make_shared<log_pp::CompressedFileSink>(
+ *     std::make_shared<log_pp::BinaryEncoder>(),
+ *     log_pp::CompressedFileSinkOptions{.path = "app.lpb"});
+ * @endcode
+ */
+struct LOG_PP_EXPORT CompressedFileSink : public Sink {
+   private:
+    CompressedFileSinkOptions options;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable space;
+    std::condition_variable drained;
+    std::string current{};
+    std::deque<std::string> sealed{};
+    std::vector<std::string> spare{};
+    std::size_t in_flight = 0;
+    bool stopping = false;
+
+    std::size_t written = 0;
+    std::size_t failed = 0;
+
+    // Owned by the worker thread once started.
+    std::FILE* file = nullptr;
+    std::uintmax_t file_size = 0;
+
+    std::thread worker;
+
+    void run();
+    void seal_locked(std::unique_lock<std::mutex>& lock);
+
+   public:
+    /**
+     * @brief Opens (or creates) the output file and starts the writer.
+     *
+     * @param encoder Encoder used to render records.
+     * @param in_options File, block and queue options.
+     */
+    CompressedFileSink(std::shared_ptr<const Encoder> encoder,
+                       CompressedFileSinkOptions in_options);
+    ~CompressedFileSink() override;
+
+    CompressedFileSink(const CompressedFileSink&) = delete;
+    CompressedFileSink& operator=(const CompressedFileSink&) = delete;
+
+    /** @brief Returns the output path. @return Output file path. */
+    const std::filesystem::path& get_path() const noexcept {
+        return options.path;
+    }
+
+    /** @brief Returns whether the file could be opened. @return Open state. */
+    bool is_open() const noexcept { return file != nullptr; }
+
+    void write(std::string_view bytes) override;
+
+    /**
+     * @brief Seals the partial block and waits until every block is written.
+     * @return Nothing.
+     */
+    void flush() override;
+
+    /**
+     * @brief Returns bytes written to the file so far, headers included.
+     * @return Byte count.
+     */
+    std::size_t written_bytes() noexcept;
+
+    /**
+     * @brief Returns blocks that could not be written, e.g. on a full disk.
+     *
+     * Their records are lost; the partial block is cut off the file again so
+     * later blocks stay readable.
+     *
+     * @return Block count.
+     */
+    std::size_t failed_blocks() noexcept;
+};
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_COMPRESSED_FILE_SINK_HPP__
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <string_view>
+
 #include "level.hpp"
 #ifndef __LOG_PP_COMPTILE_FILTER_HPP__
 #define __LOG_PP_COMPTILE_FILTER_HPP__
@@ -38,6 +42,154 @@ constexpr Level get_comptime_level() noexcept {
 
 #endif
 }
+
+/**
+ * @def LOG_PP_TARGET_LEVEL_FILTER
+ * @brief Per-target compile-time levels, e.g. `"wire=info,db::pool=off"`.
+ *
+ * Each `target=level` directive replaces the build-wide level for `target`
+ * and its `::` children; the longest matching target wins. Levels are the
+ * names accepted by @ref parse_level_filter, and
+ * `LOG_PP_RELEASE_TARGET_LEVEL_FILTER` takes precedence under `NDEBUG`.
+ * Statements whose literal target is filtered out compile to nothing once
+ * optimized, like statements below the build-wide level.
+ */
+#if defined(NDEBUG) && defined(LOG_PP_RELEASE_TARGET_LEVEL_FILTER)
+inline constexpr std::string_view comptime_target_level_spec =
+    LOG_PP_RELEASE_TARGET_LEVEL_FILTER;
+#elif defined(LOG_PP_TARGET_LEVEL_FILTER)
+inline constexpr std::string_view comptime_target_level_spec =
+    LOG_PP_TARGET_LEVEL_FILTER;
+#else
+inline constexpr std::string_view comptime_target_level_spec{};
+#endif
+
+namespace detail {
+
+struct ComptimeTargetLevel {
+    std::string_view target{};
+    LevelFilter level = LevelFilter::Trace;
+};
+
+template <std::size_t N>
+struct ComptimeTargetTable {
+    std::array<ComptimeTargetLevel, N> entries{};
+    bool valid = true;
+};
+
+constexpr std::string_view trim_directive(std::string_view text) noexcept {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+constexpr std::size_t count_directives(std::string_view spec) noexcept {
+    std::size_t count = 0;
+    while (!spec.empty()) {
+        auto comma = spec.find(',');
+        count += trim_directive(spec.substr(0, comma)).empty() ? 0 : 1;
+        spec.remove_prefix(comma == std::string_view::npos ? spec.size()
+                                                           : comma + 1);
+    }
+    return count;
+}
+
+template <std::size_t N>
+constexpr ComptimeTargetTable<N> parse_target_levels(
+    std::string_view spec) noexcept {
+    ComptimeTargetTable<N> table{};
+    std::size_t size = 0;
+    while (!spec.empty()) {
+        auto comma = spec.find(',');
+        auto directive = trim_directive(spec.substr(0, comma));
+        spec.remove_prefix(comma == std::string_view::npos ? spec.size()
+                                                           : comma + 1);
+        if (directive.empty()) {
+            continue;
+        }
+        auto equals = directive.find('=');
+        if (equals == std::string_view::npos) {
+            table.valid = false;
+            break;
+        }
+        auto target = trim_directive(directive.substr(0, equals));
+        auto level =
+            parse_level_filter(trim_directive(directive.substr(equals + 1)));
+        if (target.empty() || !level) {
+            table.valid = false;
+            break;
+        }
+        table.entries[size++] = {target, *level};
+    }
+    return table;
+}
+
+inline constexpr auto comptime_target_levels =
+    parse_target_levels<count_directives(comptime_target_level_spec)>(
+        comptime_target_level_spec);
+
+static_assert(comptime_target_levels.valid,
+              "LOG_PP_TARGET_LEVEL_FILTER must be a comma-separated list of "
+              "target=level directives");
+
+// `pattern` covers `target` itself and every `pattern::...` child.
+template <typename CharT>
+constexpr bool target_covers(std::string_view pattern,
+                             std::basic_string_view<CharT> target) noexcept {
+    if (target.size() < pattern.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        if (target[i] != static_cast<CharT>(pattern[i])) {
+            return false;
+        }
+    }
+    return target.size() == pattern.size() ||
+           (target.size() > pattern.size() + 1 &&
+            target[pattern.size()] == CharT(':') &&
+            target[pattern.size() + 1] == CharT(':'));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Returns the compile-time level for a target.
+ *
+ * Evaluates to the build-wide @ref get_comptime_level unless a
+ * `LOG_PP_TARGET_LEVEL_FILTER` directive covers `target`. The table is a
+ * constant, so the check folds away for literal targets.
+ *
+ * Example:
+ * @code
+ * static_assert(log_pp::get_comptime_level(std::string_view("wire")) <=
+ *               log_pp::LevelFilter::Info);
+ * @endcode
+ *
+ * @tparam CharT Character type.
+ * @param target Record target.
+ * @return Most verbose level compiled in for `target`.
+ */
+template <typename CharT>
+constexpr LevelFilter get_comptime_level(
+    std::basic_string_view<CharT> target) noexcept {
+    auto level = static_cast<LevelFilter>(get_comptime_level());
+    std::size_t matched = 0;
+    bool found = false;
+    for (const auto& entry : detail::comptime_target_levels.entries) {
+        if ((!found || entry.target.size() > matched) &&
+            detail::target_covers(entry.target, target)) {
+            level = entry.level;
+            matched = entry.target.size();
+            found = true;
+        }
+    }
+    return level;
+}
+
 }  // namespace log_pp
 
 #endif  // !__LOG_PP_COMPTILE_FILTER_HPP__
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "callsite.hpp"
+#include "directive_filter.hpp"
+#include "encoder.hpp"
+#include "level.hpp"
+#include "log_interface.hpp"
+#include "log_pp_export.h"
+#include "metadata.hpp"
+#include "rcu.hpp"
+#include "record.hpp"
+#include "sink.hpp"
+#include "tee_logger.hpp"
+
+#ifndef __LOG_PP_CONFIG_HPP__
+#define __LOG_PP_CONFIG_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief One `[sink.NAME]` section of a config file.
+ */
+struct SinkConfig {
+    /** @brief Section name after `sink.`; identifies the sink on reload. */
+    std::string name{};
+    /** @brief `file`, `compressed_file`, `stdout` or `stderr`. */
+    std::string type = "file";
+    /** @brief `text`, `json`, `logfmt`, `binary` or `pattern`. */
+    std::string encoder = "text";
+    /** @brief Layout for the `pattern` encoder. */
+    std::string pattern{};
+    /** @brief Output path for file sinks. */
+    std::string path{};
+    /** @brief @ref FileSinkOptions::max_file_size. */
+    std::size_t max_file_size = 0;
+    /** @brief @ref FileSinkOptions::max_files. */
+    std::size_t max_files = 5;
+    /** @brief Most verbose level the sink accepts. */
+    LevelFilter level = LevelFilter::Trace;
+
+    bool operator==(const SinkConfig&) const = default;
+};
+
+/**
+ * @brief Parsed logging configuration.
+ */
+struct LogConfig {
+    /** @brief Directive spec from `[log]` `level` and `targets`. */
+    std::string directives = "trace";
+    /** @brief `[callsite.NAME]` sections, in file order. */
+    std::vector<CallsiteRule> callsites{};
+    /** @brief `[sink.NAME]` sections, in file order. */
+    std::vector<SinkConfig> sinks{};
+};
+
+/**
+ * @brief Parses an INI-style logging configuration.
+ *
+ * Lines starting with `;` or `#` are comments. Values may be wrapped in
+ * double quotes to keep leading or trailing spaces. Unknown sections and
+ * keys are errors, so typos do not silently fall back to defaults.
+ *
+ * Example:
+ * @code{.ini}
+ * [log]
+ * level = info
+ * targets = db=debug, http::client=trace
+ *
+ * [callsite.parser]
+ * function = Parser::parse*
+ * level = debug
+ *
+ * [sink.main]
+ * type = file
+ * path = /var/log/app.log
+ * encoder = json
+ * max_file_size = 10485760
+ *
+ * [sink.console]
+ * type = stderr
+ * level = warn
+ * @endcode
+ *
+ * @param text Config file contents.
+ * @param error Receives `"line N: reason"` on failure; may be `nullptr`.
+ * @return Parsed config, or `std::nullopt` on the first error.
+ */
+LOG_PP_EXPORT std::optional<LogConfig> parse_config(
+    std::string_view text,
+    std::string* error = nullptr);
+
+/**
+ * @brief Logger configured from a file and reconfigured while it runs.
+ *
+ * Records pass through a @ref DirectiveFilter and fan out to the configured
+ * sinks through a @ref TeeLogger. Applying a config publishes the new
+ * directives and sink list together through RCU, so logging threads never
+ * wait and never pair one config's sinks with another's directives. Sinks
+ * whose section is unchanged are kept, with their buffers and open files; a
+ * changed `level` is applied in place. Callsite rules are re-evaluated
+ * without blocking logging threads; a `[callsite.NAME]` level takes
+ * precedence over `targets` and sink levels at the statements it matches.
+ *
+ * The global max level and the callsite rules are process-wide, not part of
+ * the logger: every applied config sets @ref set_max_level to its most
+ * verbose directive, and configs with `[callsite.NAME]` sections replace
+ * @ref set_callsite_rules (as does the first config without them after
+ * one that had them). Keep one ConfigLogger per process, the one installed
+ * as the global logger; rules set from code survive configs that never use
+ * callsite sections.
+ *
+ * On Linux, @ref watch follows the file with inotify, including editors
+ * that save by renaming a new file over it. Elsewhere call @ref load_file to
+ * reload. Until a config is applied, the logger has no sinks.
+ *
+ * Example:
+ * @code
+ * static log_pp::ConfigLogger logger;
+ * logger.watch("/etc/app/log.ini");
+ * log_pp::set_logger(logger);
+ * @endcode
+ */
+struct LOG_PP_EXPORT ConfigLogger : public ILogger {
+   private:
+    struct ActiveSink {
+        SinkConfig config;
+        std::shared_ptr<Sink> sink;
+    };
+
+    // Directives and sinks of one config, swapped as a unit.
+    struct State {
+        DirectiveFilter filter{};
+        TeeLogger tee{};
+    };
+
+    RcuPtr<State> state{std::make_unique<State>()};
+
+    // Guards everything below; held while applying a config.
+    mutable std::mutex update_mutex;
+    std::map<std::string, ActiveSink> sinks{};
+    bool owns_callsite_rules = false;
+    std::map<std::string, std::shared_ptr<const Encoder>> encoders{};
+    std::string last_error{};
+
+    std::thread watcher{};
+    int stop_fd = -1;
+
+    std::shared_ptr<const Encoder> encoder_for(const SinkConfig& config);
+    std::shared_ptr<Sink> make_sink(const SinkConfig& config);
+    bool fail_locked(std::string error);
+    void stop_watching() noexcept;
+
+   public:
+    ConfigLogger() = default;
+    ~ConfigLogger() override;
+
+    ConfigLogger(const ConfigLogger&) = delete;
+    ConfigLogger& operator=(const ConfigLogger&) = delete;
+
+    /**
+     * @brief Applies a parsed config.
+     *
+     * @param config New config.
+     * @return `false` (keeping the current config) if it is invalid.
+     */
+    bool apply(const LogConfig& config);
+
+    /**
+     * @brief Parses and applies config text.
+     *
+     * @param text Config file contents.
+     * @return `false` (keeping the current config) on a parse error.
+     */
+    bool load(std::string_view text);
+
+    /**
+     * @brief Reads, parses and applies a config file.
+     *
+     * @param path Config file path.
+     * @return `false` (keeping the current config) on a read or parse error.
+     */
+    bool load_file(const std::filesystem::path& path);
+
+    /**
+     * @brief Loads a config file and reloads it whenever it changes.
+     *
+     * Replaces any previous watch. Reload errors keep the last good config
+     * and are reported by @ref get_last_error.
+     *
+     * @param path Config file path.
+     * @return `false` if the initial load fails or watching is unsupported.
+     */
+    bool watch(const std::filesystem::path& path);
+
+    /**
+     * @brief Returns the sink built for a `[sink.NAME]` section.
+     *
+     * @param name Section name after `sink.`.
+     * @return Sink, or `nullptr` if the current config has no such section.
+     */
+    std::shared_ptr<Sink> get_sink(std::string_view name) const;
+
+    /**
+     * @brief Returns the error of the last failed load.
+     * @return Error text; empty after a successful load.
+     */
+    std::string get_last_error() const;
+
+    bool enabled(const Metadata& metadata) const noexcept override;
+    void log(const Record& record) override;
+    void log_batch(std::span<const Record> records) override;
+    void flush() override;
+};
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_CONFIG_HPP__
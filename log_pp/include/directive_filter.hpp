@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "level.hpp"
+#include "log.hpp"
+#include "metadata.hpp"
+#include "rcu.hpp"
+#include "target_trie.hpp"
+
+#ifndef __LOG_PP_DIRECTIVE_FILTER_HPP__
+#define __LOG_PP_DIRECTIVE_FILTER_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Per-target level filter configured by a directive string.
+ *
+ * A spec is a comma-separated list of directives:
+ * - `level` sets the default for targets no other directive matches.
+ * - `target=level` sets the level for `target` and everything below it in
+ *   the `::` hierarchy (`db` covers `db` and `db::pool`, but not `dbx`).
+ * - a bare `target` enables every level for that target.
+ *
+ * The most specific directive wins, so `"info,db=debug,db::pool=trace"`
+ * allows Trace for `db::pool::conn`, Debug for `db::query` and Info
+ * elsewhere. Directives are compiled into a byte trie, so @ref enabled walks
+ * a target once and then answers from a per-@ref TargetId cache. @ref reload
+ * publishes a new table through RCU: readers never lock and see either the
+ * old or the new directives, never a mix.
+ *
+ * A filter leaves the process-wide @ref set_max_level alone unless the reload
+ * asks for it, so a filter owned by one logger (or built during static
+ * initialization) cannot change what every other logger sees.
+ *
+ * Example:
+ * @code
+ * static log_pp::DirectiveFilter filter;
+ * filter.reload("warn,db=debug", true);
+ *
+ * bool enabled(const log_pp::Metadata& metadata) const noexcept override {
+ *     return filter.enabled(metadata);
+ * }
+ * @endcode
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicDirectiveFilter {
+   private:
+    using string_view = std::basic_string_view<CharT>;
+
+    struct Table {
+        detail::TargetTrie<CharT> trie{};
+        std::vector<LevelFilter> levels{};
+        LevelFilter default_level = LevelFilter::Error;
+        LevelFilter max_level = LevelFilter::Error;
+
+        detail::TargetIdCache<int8_t, -1> by_id{};
+
+        LevelFilter lookup(string_view target) const noexcept {
+            auto index = trie.find(target);
+            return index ? levels[*index] : default_level;
+        }
+
+        LevelFilter lookup(string_view target, TargetId id) const noexcept {
+            return static_cast<LevelFilter>(by_id.get(id, [&] {
+                return static_cast<int8_t>(lookup(target));
+            }));
+        }
+    };
+
+    std::mutex update_mutex;
+    RcuPtr<Table> table{std::make_unique<Table>()};
+
+    static constexpr bool is_space(CharT ch) noexcept {
+        return ch == CharT(' ') || ch == CharT('\t') || ch == CharT('\n') ||
+               ch == CharT('\r');
+    }
+
+    static constexpr string_view trim(string_view text) noexcept {
+        while (!text.empty() && is_space(text.front())) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && is_space(text.back())) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    static std::unique_ptr<Table> parse(string_view spec) {
+        auto next = std::make_unique<Table>();
+        std::vector<std::pair<string_view, LevelFilter>> directives;
+        while (!spec.empty()) {
+            auto comma = spec.find(CharT(','));
+            auto directive = trim(spec.substr(0, comma));
+            spec.remove_prefix(comma == string_view::npos ? spec.size()
+                                                          : comma + 1);
+            if (directive.empty()) {
+                continue;
+            }
+            auto equals = directive.find(CharT('='));
+            if (equals == string_view::npos) {
+                if (auto level = parse_level_filter(directive)) {
+                    next->default_level = *level;
+                } else {
+                    directives.emplace_back(directive, LevelFilter::Trace);
+                }
+                continue;
+            }
+            auto target = trim(directive.substr(0, equals));
+            auto level = parse_level_filter(trim(directive.substr(equals + 1)));
+            if (target.empty() || !level) {
+                return nullptr;
+            }
+            directives.emplace_back(target, *level);
+        }
+
+        next->max_level = next->default_level;
+        std::basic_string<CharT> children;
+        for (const auto& [target, level] : directives) {
+            // Later directives for the same target overwrite earlier ones.
+            auto index = static_cast<uint32_t>(next->levels.size());
+            next->levels.push_back(level);
+            next->trie.insert_exact(target, index);
+            children.assign(target);
+            children.push_back(CharT(':'));
+            children.push_back(CharT(':'));
+            next->trie.insert_prefix(children, index);
+            next->max_level = std::max(next->max_level, level);
+        }
+        next->trie.compile();
+        return next;
+    }
+
+   public:
+    /** @brief Creates a filter that allows Error records only. */
+    BasicDirectiveFilter() = default;
+
+    /**
+     * @brief Creates a filter from a directive spec.
+     *
+     * Does not touch the global max level. An invalid spec leaves the
+     * Error-only default in place.
+     *
+     * @param spec Directive spec such as `"info,db=debug"`.
+     */
+    explicit BasicDirectiveFilter(string_view spec) { reload(spec); }
+
+    BasicDirectiveFilter(const BasicDirectiveFilter&) = delete;
+    BasicDirectiveFilter& operator=(const BasicDirectiveFilter&) = delete;
+
+    /**
+     * @brief Replaces the directives.
+     *
+     * Safe to call while other threads are logging.
+     *
+     * @param spec Directive spec such as `"info,db=debug"`.
+     * @param set_global Also raise or lower the global max level to the most
+     * verbose level the directives allow, so other statements are rejected
+     * before a record is built. Only the filter that owns the process-wide
+     * level (e.g. the one behind the global logger) should pass `true`.
+     * @return `false` (keeping the current directives) when a level name is
+     * unknown or a `target=level` directive has an empty target.
+     */
+    bool reload(string_view spec, bool set_global = false) {
+        auto next = parse(spec);
+        if (!next) {
+            return false;
+        }
+        std::lock_guard lock(update_mutex);
+        auto max = next->max_level;
+        table.store(std::move(next));
+        if (set_global) {
+            set_max_level(max);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks a directive spec without applying it.
+     *
+     * @param spec Directive spec.
+     * @return `true` if @ref reload would accept it.
+     */
+    static bool valid(string_view spec) { return parse(spec) != nullptr; }
+
+    /**
+     * @brief Returns the level allowed for a target.
+     *
+     * @param target Record target.
+     * @return Level of the most specific matching directive, or the default.
+     */
+    LevelFilter level_for(string_view target) const noexcept {
+        rcu::ReadGuard guard;
+        return table.load()->lookup(target);
+    }
+
+    /**
+     * @brief Returns the most verbose level any directive allows.
+     *
+     * @return Level a reload with `set_global` feeds to @ref set_max_level.
+     */
+    LevelFilter max_level() const noexcept {
+        rcu::ReadGuard guard;
+        return table.load()->max_level;
+    }
+
+    /**
+     * @brief Checks whether a record passes the directives.
+     *
+     * @param metadata Record metadata.
+     * @return `true` if the record level is allowed for its target, or
+     * within the level its callsite rule or thread was granted (see
+     * @ref BasicMetadata::get_level_override).
+     */
+    bool enabled(const BasicMetadata<CharT>& metadata) const noexcept {
+        if (metadata.get_level() <= metadata.get_level_override()) {
+            return true;
+        }
+        rcu::ReadGuard guard;
+        return metadata.get_level() <=
+               table.load()->lookup(metadata.get_target(),
+                                    metadata.get_target_id());
+    }
+};
+
+/** @brief UTF-8 directive filter alias. */
+using DirectiveFilter = BasicDirectiveFilter<char>;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_DIRECTIVE_FILTER_HPP__
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "fast_format.hpp"
+#include "level.hpp"
+#include "record.hpp"
+
+#ifndef __LOG_PP_ENCODER_HPP__
+#define __LOG_PP_ENCODER_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Reference-counted immutable output buffer shared between sinks.
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+using BasicSharedBuffer = std::shared_ptr<const std::basic_string<CharT>>;
+
+namespace detail {
+
+template <typename CharT>
+void append_ascii(std::basic_string<CharT>& out, std::string_view text) {
+    if constexpr (std::same_as<CharT, char>) {
+        out.append(text);
+    } else {
+        for (char c : text) {
+            out.push_back(static_cast<CharT>(c));
+        }
+    }
+}
+
+template <typename CharT>
+void append_uint(std::basic_string<CharT>& out,
+                 uint64_t value,
+                 std::size_t width = 0) {
+    CharT digits[20];
+    std::size_t pos = std::size(digits);
+    do {
+        digits[--pos] = static_cast<CharT>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    for (auto len = std::size(digits) - pos; len < width && pos > 0; ++len) {
+        digits[--pos] = CharT('0');
+    }
+    out.append(digits + pos, std::size(digits) - pos);
+}
+
+template <typename CharT>
+void append_message(std::basic_string<CharT>& out,
+                    const BasicRecord<CharT>& record) {
+    if (append_fast_vformat(out, record.get_format_string(),
+                            record.get_args())) {
+        return;
+    }
+    if constexpr (std::same_as<CharT, char> || std::same_as<CharT, wchar_t>) {
+        std::vformat_to(std::back_inserter(out), record.get_format_string(),
+                        record.get_args());
+    } else {
+        out += std::vformat(record.get_format_string(), record.get_args());
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Renders records into an output byte layout.
+ *
+ * Encoders are stateless with respect to records and must be safe to call
+ * concurrently. Sinks that hold the same encoder instance share its output.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicEncoder {
+    constexpr virtual ~BasicEncoder() noexcept = default;
+
+    /**
+     * @brief Appends the encoded form of one record.
+     *
+     * @param record Record to encode.
+     * @param out Buffer the encoded bytes are appended to.
+     * @return Nothing.
+     */
+    virtual void encode(const BasicRecord<CharT>& record,
+                        std::basic_string<CharT>& out) const = 0;
+};
+
+/**
+ * @brief Default human-readable layout: `[LEVEL] [target] k: v, message`.
+ *
+ * Each record is terminated by a newline.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicTextEncoder : public BasicEncoder<CharT> {
+    void encode(const BasicRecord<CharT>& record,
+                std::basic_string<CharT>& out) const override {
+        out.push_back(CharT('['));
+        detail::append_ascii(out, to_str(record.get_level()));
+        detail::append_ascii(out, "] [");
+        out.append(record.get_target());
+        detail::append_ascii(out, "] ");
+        for (const auto& kv : record.get_kvs()) {
+            out.append(kv.get_key_str());
+            detail::append_ascii(out, ": ");
+            kv.append_value(out);
+            detail::append_ascii(out, ", ");
+        }
+        detail::append_message(out, record);
+        out.push_back(CharT('\n'));
+    }
+};
+
+/** @brief UTF-8 encoder interface alias. */
+using Encoder = BasicEncoder<char>;
+/** @brief UTF-8 text encoder alias. */
+using TextEncoder = BasicTextEncoder<char>;
+/** @brief UTF-8 shared buffer alias. */
+using SharedBuffer = BasicSharedBuffer<char>;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_ENCODER_HPP__
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "text_scan.hpp"
+
+#ifndef __LOG_PP_FAST_FORMAT_HPP__
+#define __LOG_PP_FAST_FORMAT_HPP__
+
+namespace log_pp {
+
+namespace detail {
+
+/**
+ * @brief Subset of the standard format spec rendered without `std::format`:
+ * `[0][width][.precision][type]`.
+ */
+struct FastSpec {
+    std::size_t width = 0;
+    int precision = -1;
+    char type = '\0';
+    bool zero_pad = false;
+
+    constexpr bool is_default() const noexcept {
+        return width == 0 && precision < 0 && type == '\0' && !zero_pad;
+    }
+};
+
+/**
+ * @brief Parses the text after `:` in a replacement field.
+ * @return Parsed spec, or empty when it uses anything outside @ref FastSpec
+ * (fill, alignment, sign, `#`, `L`, nested fields).
+ */
+template <typename CharT>
+constexpr std::optional<FastSpec> parse_fast_spec(
+    std::basic_string_view<CharT> spec) noexcept {
+    constexpr std::size_t MAX_WIDTH = 64;
+    constexpr int MAX_PRECISION = 64;
+    auto is_digit = [](CharT ch) {
+        return ch >= CharT('0') && ch <= CharT('9');
+    };
+
+    FastSpec out;
+    std::size_t pos = 0;
+    if (pos < spec.size() && spec[pos] == CharT('0')) {
+        out.zero_pad = true;
+        ++pos;
+    }
+    if (pos < spec.size() && is_digit(spec[pos]) && spec[pos] != CharT('0')) {
+        for (; pos < spec.size() && is_digit(spec[pos]); ++pos) {
+            out.width = out.width * 10 +
+                        static_cast<std::size_t>(spec[pos] - CharT('0'));
+            if (out.width > MAX_WIDTH) {
+                return std::nullopt;
+            }
+        }
+    }
+    if (pos < spec.size() && spec[pos] == CharT('.')) {
+        ++pos;
+        if (pos == spec.size() || !is_digit(spec[pos])) {
+            return std::nullopt;
+        }
+        out.precision = 0;
+        for (; pos < spec.size() && is_digit(spec[pos]); ++pos) {
+            out.precision = out.precision * 10 +
+                            static_cast<int>(spec[pos] - CharT('0'));
+            if (out.precision > MAX_PRECISION) {
+                return std::nullopt;
+            }
+        }
+    }
+    if (pos < spec.size()) {
+        constexpr std::string_view TYPES = "dxXbofFeEgGsc";
+        auto type = spec[pos++];
+        if (static_cast<std::make_unsigned_t<CharT>>(type) > 0x7F ||
+            TYPES.find(static_cast<char>(type)) == std::string_view::npos) {
+            return std::nullopt;
+        }
+        out.type = static_cast<char>(type);
+    }
+    if (pos != spec.size()) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+/**
+ * @brief Pads the number in `text[0..length)` to `spec.width` and appends it.
+ *
+ * Zero padding goes after the sign, as `std::format` does.
+ */
+template <typename CharT>
+void append_fast_number(std::basic_string<CharT>& out,
+                        const char* text,
+                        std::size_t length,
+                        const FastSpec& spec) {
+    std::size_t pad = spec.width > length ? spec.width - length : 0;
+    std::size_t pos = 0;
+    if (spec.zero_pad) {
+        if (length > 0 && text[0] == '-') {
+            out.push_back(CharT('-'));
+            pos = 1;
+        }
+        out.append(pad, CharT('0'));
+    } else {
+        out.append(pad, CharT(' '));
+    }
+    if constexpr (std::same_as<CharT, char>) {
+        out.append(text + pos, length - pos);
+    } else {
+        for (; pos < length; ++pos) {
+            out.push_back(static_cast<CharT>(text[pos]));
+        }
+    }
+}
+
+inline void upper_ascii(char* first, char* last) noexcept {
+    for (; first != last; ++first) {
+        if (*first >= 'a' && *first <= 'z') {
+            *first = static_cast<char>(*first - 'a' + 'A');
+        }
+    }
+}
+
+/**
+ * @brief Renders `value` with `spec` via `std::to_chars`.
+ *
+ * Handles integers (`d x X b o`), `float`/`double` (shortest, `f e g` and
+ * their upper-case forms), `bool`, characters and strings with the default
+ * presentation.
+ *
+ * @return `false`, leaving `out` untouched, when `std::format` is needed.
+ */
+template <typename CharT, typename T>
+bool append_fast(std::basic_string<CharT>& out,
+                 const T& value,
+                 const FastSpec& spec) {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::same_as<U, bool>) {
+        if (!spec.is_default()) {
+            return false;
+        }
+        std::string_view text = value ? "true" : "false";
+        append_fast_number(out, text.data(), text.size(), spec);
+        return true;
+    } else if constexpr (std::same_as<U, CharT>) {
+        if (!spec.is_default() && !(spec.type == 'c' && spec.width == 0 &&
+                                    spec.precision < 0 && !spec.zero_pad)) {
+            return false;
+        }
+        out.push_back(value);
+        return true;
+    } else if constexpr (std::integral<U> && !std::same_as<U, char> &&
+                         !std::same_as<U, wchar_t> &&
+                         !std::same_as<U, char8_t> &&
+                         !std::same_as<U, char16_t> &&
+                         !std::same_as<U, char32_t>) {
+        int base = 10;
+        switch (spec.type) {
+            case '\0':
+            case 'd':
+                break;
+            case 'x':
+            case 'X':
+                base = 16;
+                break;
+            case 'b':
+                base = 2;
+                break;
+            case 'o':
+                base = 8;
+                break;
+            default:
+                return false;
+        }
+        if (spec.precision >= 0) {
+            return false;
+        }
+        char buffer[72];
+        auto result =
+            std::to_chars(buffer, buffer + sizeof(buffer), value, base);
+        if (spec.type == 'X') {
+            upper_ascii(buffer, result.ptr);
+        }
+        append_fast_number(out, buffer,
+                           static_cast<std::size_t>(result.ptr - buffer), spec);
+        return true;
+    } else if constexpr (std::same_as<U, float> || std::same_as<U, double>) {
+        if (spec.zero_pad && !std::isfinite(value)) {
+            // std::format pads inf/nan with spaces.
+            return false;
+        }
+        char buffer[128];
+        std::to_chars_result result{};
+        int precision = spec.precision < 0 ? 6 : spec.precision;
+        switch (spec.type) {
+            case '\0':
+                if (spec.precision >= 0) {
+                    return false;
+                }
+                result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                break;
+            case 'f':
+            case 'F':
+                result = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                       std::chars_format::fixed, precision);
+                break;
+            case 'e':
+            case 'E':
+                result =
+                    std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                  std::chars_format::scientific, precision);
+                break;
+            case 'g':
+            case 'G':
+                result = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                       std::chars_format::general, precision);
+                break;
+            default:
+                return false;
+        }
+        if (result.ec != std::errc()) {
+            return false;
+        }
+        if (spec.type == 'F' || spec.type == 'E' || spec.type == 'G') {
+            upper_ascii(buffer, result.ptr);
+        }
+        append_fast_number(out, buffer,
+                           static_cast<std::size_t>(result.ptr - buffer), spec);
+        return true;
+    } else if constexpr (std::same_as<U, std::basic_string_view<CharT>> ||
+                         std::same_as<U, std::basic_string<CharT>>) {
+        // Padding strings needs display widths; leave it to std::format.
+        if (!spec.is_default() &&
+            !(spec.type == 's' && spec.width == 0 && spec.precision < 0 &&
+              !spec.zero_pad)) {
+            return false;
+        }
+        out.append(value);
+        return true;
+    } else if constexpr (std::same_as<U, const CharT*> ||
+                         std::same_as<U, CharT*>) {
+        if (value == nullptr) {
+            return false;
+        }
+        return append_fast(out, std::basic_string_view<CharT>(value), spec);
+    } else {
+        return false;
+    }
+}
+
+/**
+ * @brief Renders `format` when every replacement field is fast-pathable.
+ *
+ * Literal text and `{{`/`}}` are copied; each field is parsed into an
+ * argument index and a @ref FastSpec and handed to
+ * `render(out, index, spec)`, which returns `false` to give up. Named or
+ * nested fields and mixed manual/automatic indexing also give up.
+ *
+ * @return `false`, leaving `out` untouched, when the caller has to fall back
+ * to `std::vformat`.
+ */
+template <typename CharT, typename Render>
+bool append_fast_format(std::basic_string<CharT>& out,
+                        std::basic_string_view<CharT> format,
+                        Render&& render) {
+    const auto start = out.size();
+    auto fail = [&] {
+        out.resize(start);
+        return false;
+    };
+    std::size_t next_index = 0;
+    bool automatic = false;
+    bool manual = false;
+    std::size_t pos = 0;
+    while (pos < format.size()) {
+        std::size_t brace = pos;
+        if constexpr (std::same_as<CharT, char>) {
+            brace = find_byte_class(format, pos, FORMAT_BRACES);
+        } else {
+            while (brace < format.size() && format[brace] != CharT('{') &&
+                   format[brace] != CharT('}')) {
+                ++brace;
+            }
+        }
+        out.append(format.data() + pos, brace - pos);
+        if (brace == format.size()) {
+            break;
+        }
+        if (brace + 1 < format.size() && format[brace + 1] == format[brace]) {
+            out.push_back(format[brace]);
+            pos = brace + 2;
+            continue;
+        }
+        if (format[brace] == CharT('}')) {
+            return fail();
+        }
+        auto close = format.find(CharT('}'), brace + 1);
+        if (close == std::basic_string_view<CharT>::npos) {
+            return fail();
+        }
+        auto field = format.substr(brace + 1, close - brace - 1);
+        auto colon = field.find(CharT(':'));
+        auto id = field.substr(0, colon);
+        std::basic_string_view<CharT> spec_text;
+        if (colon != std::basic_string_view<CharT>::npos) {
+            spec_text = field.substr(colon + 1);
+        }
+        if (id.find(CharT('{')) != std::basic_string_view<CharT>::npos ||
+            spec_text.find(CharT('{')) != std::basic_string_view<CharT>::npos) {
+            return fail();
+        }
+
+        std::size_t index = 0;
+        if (id.empty()) {
+            automatic = true;
+            index = next_index++;
+        } else {
+            manual = true;
+            for (auto ch : id) {
+                if (ch < CharT('0') || ch > CharT('9') || index > 255) {
+                    return fail();
+                }
+                index = index * 10 + static_cast<std::size_t>(ch - CharT('0'));
+            }
+        }
+        auto spec = parse_fast_spec(spec_text);
+        if ((automatic && manual) || !spec || !render(out, index, *spec)) {
+            return fail();
+        }
+        pos = close + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Fast path for `std::vformat_to(out, format, args)`.
+ * @return `false`, leaving `out` untouched, when some field needs
+ * `std::format`.
+ */
+template <typename CharT, typename Args>
+bool append_fast_vformat(std::basic_string<CharT>& out,
+                         std::basic_string_view<CharT> format,
+                         const Args& args) {
+    return append_fast_format(
+        out, format,
+        [&args](std::basic_string<CharT>& buffer, std::size_t index,
+                const FastSpec& spec) {
+            return std::visit_format_arg(
+                [&](auto value) {
+                    return append_fast<CharT>(buffer, value, spec);
+                },
+                args.get(index));
+        });
+}
+
+}  // namespace detail
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_FAST_FORMAT_HPP__
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "encoder.hpp"
+#include "sink.hpp"
+
+#ifndef __LOG_PP_FILE_SINK_HPP__
+#define __LOG_PP_FILE_SINK_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Options for @ref FileSink.
+ */
+struct FileSinkOptions {
+    /** @brief Output file path. */
+    std::filesystem::path path{};
+    /** @brief Bytes buffered in memory before a write is issued. */
+    std::size_t buffer_size = 64 * 1024;
+    /** @brief Rotate when the file would grow past this size; 0 disables. */
+    std::size_t max_file_size = 0;
+    /** @brief Number of rotated files kept as `path.1` .. `path.N`. */
+    std::size_t max_files = 5;
+};
+
+/**
+ * @brief Buffered, size-rotated file sink.
+ *
+ * Encoded records are appended to an in-memory buffer and written out when it
+ * fills or on @ref flush. With `max_file_size` set, `app.log` is renamed to
+ * `app.log.1` (shifting older files up to `max_files`) before it would grow
+ * past the limit.
+ *
+ * Example:
+ * @code
+ * auto sink = std::make_shared<log_pp::FileSink>(
+ *     std::make_shared<log_pp::TextEncoder>(),
+ *     log_pp::FileSinkOptions{.path = "db.log", .max_file_size = 1 << 20});
+ * @endcode
+ */
+struct FileSink : public Sink {
+   private:
+    FileSinkOptions options;
+    std::mutex mutex;
+    std::string buffer{};
+    std::FILE* file = nullptr;
+    std::size_t file_size = 0;
+
+    void open_locked() {
+        file = std::fopen(options.path.string().c_str(), "ab");
+        file_size = 0;
+        if (file != nullptr) {
+            std::setvbuf(file, nullptr, _IONBF, 0);
+            std::error_code ec;
+            auto size = std::filesystem::file_size(options.path, ec);
+            file_size = ec ? 0 : static_cast<std::size_t>(size);
+        }
+    }
+
+    void rotate_locked() {
+        if (file != nullptr) {
+            std::fclose(file);
+            file = nullptr;
+        }
+        std::error_code ec;
+        auto rotated = [&](std::size_t index) {
+            auto p = options.path;
+            p += "." + std::to_string(index);
+            return p;
+        };
+        if (options.max_files == 0) {
+            std::filesystem::remove(options.path, ec);
+        } else {
+            std::filesystem::remove(rotated(options.max_files), ec);
+            for (std::size_t i = options.max_files - 1; i >= 1; --i) {
+                std::filesystem::rename(rotated(i), rotated(i + 1), ec);
+            }
+            std::filesystem::rename(options.path, rotated(1), ec);
+        }
+        open_locked();
+    }
+
+    void write_out_locked(std::string_view bytes) {
+        if (bytes.empty()) {
+            return;
+        }
+        if (options.max_file_size != 0 && file_size != 0 &&
+            file_size + bytes.size() > options.max_file_size) {
+            rotate_locked();
+        }
+        if (file == nullptr) {
+            return;
+        }
+        file_size += std::fwrite(bytes.data(), 1, bytes.size(), file);
+    }
+
+    void drain_locked() {
+        write_out_locked(buffer);
+        buffer.clear();
+    }
+
+   public:
+    /**
+     * @brief Opens (or creates) the output file in append mode.
+     *
+     * @param encoder Encoder used to render records.
+     * @param in_options File, buffering and rotation options.
+     */
+    FileSink(std::shared_ptr<const Encoder> encoder, FileSinkOptions in_options)
+        : Sink(std::move(encoder)), options(std::move(in_options)) {
+        buffer.reserve(options.buffer_size);
+        open_locked();
+    }
+
+    ~FileSink() override {
+        std::lock_guard lock(mutex);
+        drain_locked();
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    /** @brief Returns the output path. @return Output file path. */
+    const std::filesystem::path& get_path() const noexcept {
+        return options.path;
+    }
+
+    /** @brief Returns whether the file could be opened. @return Open state. */
+    bool is_open() noexcept {
+        std::lock_guard lock(mutex);
+        return file != nullptr;
+    }
+
+    void write(std::string_view bytes) override {
+        std::lock_guard lock(mutex);
+        // Keep whole records together so rotation never splits one.
+        if (options.max_file_size != 0 &&
+            file_size + buffer.size() + bytes.size() > options.max_file_size) {
+            drain_locked();
+        }
+        if (buffer.size() + bytes.size() > options.buffer_size) {
+            drain_locked();
+        }
+        if (bytes.size() >= options.buffer_size) {
+            write_out_locked(bytes);
+        } else {
+            buffer.append(bytes);
+        }
+    }
+
+    void flush() override {
+        std::lock_guard lock(mutex);
+        drain_locked();
+    }
+};
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_FILE_SINK_HPP__
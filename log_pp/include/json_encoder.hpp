@@ -0,0 +1,233 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "encoder.hpp"
+#include "kv.hpp"
+#include "level.hpp"
+#include "record.hpp"
+#include "text_scan.hpp"
+
+#ifndef __LOG_PP_JSON_ENCODER_HPP__
+#define __LOG_PP_JSON_ENCODER_HPP__
+
+namespace log_pp {
+
+namespace detail {
+
+template <typename CharT>
+void append_json_escape(std::basic_string<CharT>& out, unsigned code) {
+    switch (code) {
+        case '"':
+            append_ascii(out, "\\\"");
+            return;
+        case '\\':
+            append_ascii(out, "\\\\");
+            return;
+        case '\n':
+            append_ascii(out, "\\n");
+            return;
+        case '\r':
+            append_ascii(out, "\\r");
+            return;
+        case '\t':
+            append_ascii(out, "\\t");
+            return;
+        case '\b':
+            append_ascii(out, "\\b");
+            return;
+        case '\f':
+            append_ascii(out, "\\f");
+            return;
+        default: {
+            constexpr char hex[] = "0123456789abcdef";
+            char escaped[] = {'\\', 'u', '0', '0', hex[(code >> 4) & 0xF],
+                              hex[code & 0xF]};
+            append_ascii(out, std::string_view(escaped, sizeof(escaped)));
+        }
+    }
+}
+
+/**
+ * @brief Appends `text` as the body of a JSON string (without quotes).
+ *
+ * UTF-8 input is scanned 16 bytes at a time; clean runs are copied in bulk.
+ * Ill-formed UTF-8 is replaced with U+FFFD.
+ */
+template <typename CharT>
+void append_json_escaped(std::basic_string<CharT>& out,
+                         std::basic_string_view<CharT> text) {
+    if constexpr (std::same_as<CharT, char>) {
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            auto next = find_byte_class(text, pos, JSON_SPECIAL);
+            out.append(text.data() + pos, next - pos);
+            if (next == text.size()) {
+                break;
+            }
+            auto byte = static_cast<unsigned char>(text[next]);
+            if (byte >= 0x80) {
+                auto check = check_utf8(text, next);
+                if (check.valid) {
+                    out.append(text.data() + next, check.length);
+                } else {
+                    out.append("\xEF\xBF\xBD");
+                }
+                pos = next + check.length;
+            } else {
+                append_json_escape(out, byte);
+                pos = next + 1;
+            }
+        }
+    } else {
+        for (auto ch : text) {
+            if (ch == CharT('"') || ch == CharT('\\') || ch < CharT(0x20)) {
+                append_json_escape(out, static_cast<unsigned>(ch));
+            } else {
+                out.push_back(ch);
+            }
+        }
+    }
+}
+
+template <typename CharT>
+void append_json_string(std::basic_string<CharT>& out,
+                        std::basic_string_view<CharT> text) {
+    out.push_back(CharT('"'));
+    append_json_escaped(out, text);
+    out.push_back(CharT('"'));
+}
+
+/** @brief Escapes `out[start..]` in place; the common clean case is free. */
+template <typename CharT>
+void escape_json_tail(std::basic_string<CharT>& out, std::size_t start) {
+    if constexpr (std::same_as<CharT, char>) {
+        if (find_byte_class(out, start, JSON_SPECIAL) == out.size()) {
+            return;
+        }
+    }
+    thread_local std::basic_string<CharT> scratch;
+    scratch.assign(out, start);
+    out.resize(start);
+    append_json_escaped(out, std::basic_string_view<CharT>(scratch));
+}
+
+template <typename CharT, typename T>
+void append_json_value(std::basic_string<CharT>& out, const T& value) {
+    if constexpr (std::same_as<T, bool>) {
+        append_ascii(out, value ? "true" : "false");
+    } else if constexpr (std::same_as<T, std::basic_string_view<CharT>>) {
+        append_json_string(out, value);
+    } else if constexpr (std::same_as<T, Bytes>) {
+        // Hex and base64 output never needs escaping.
+        out.push_back(CharT('"'));
+        append_bytes(out, value);
+        out.push_back(CharT('"'));
+    } else if constexpr (std::same_as<T, BasicKVCustom<CharT>>) {
+        out.push_back(CharT('"'));
+        auto start = out.size();
+        value.append_to(out);
+        escape_json_tail(out, start);
+        out.push_back(CharT('"'));
+    } else if constexpr (std::floating_point<T>) {
+        // JSON has no literal for NaN or infinities.
+        bool finite = std::isfinite(value);
+        if (!finite) {
+            out.push_back(CharT('"'));
+        }
+        append_kv_chars(out, value);
+        if (!finite) {
+            out.push_back(CharT('"'));
+        }
+    } else {
+        append_kv_chars(out, value);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief JSON-lines layout: one JSON object per record.
+ *
+ * Output shape (`file`/`line` only when a source location is set,
+ * `thread`/`thread_name` only when the producing thread was captured, `fields`
+ * only when key-values are attached):
+ * @code
+ * {"level":"INFO","target":"db","file":"main.cpp","line":12,"thread":4711,
+ *  "thread_name":"io","message":"connected",
+ *  "fields":{"attempt":3,"ok":true,"host":"a"}}
+ * @endcode
+ *
+ * Numeric and boolean key-values are written as JSON numbers and literals
+ * straight from their native value (see @ref BasicKV::visit); strings and
+ * custom-formatted values are written as escaped strings.
+ * UTF-8 output is always valid: ill-formed input bytes become U+FFFD.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicJsonEncoder : public BasicEncoder<CharT> {
+    void encode(const BasicRecord<CharT>& record,
+                std::basic_string<CharT>& out) const override {
+        detail::append_ascii(out, "{\"level\":\"");
+        detail::append_ascii(out, to_str(record.get_level()));
+        detail::append_ascii(out, "\",\"target\":");
+        detail::append_json_string(out, record.get_target());
+        if (auto file = record.get_file()) {
+            detail::append_ascii(out, ",\"file\":\"");
+            if constexpr (std::same_as<CharT, char>) {
+                detail::append_json_escaped(out, *file);
+            } else {
+                auto path_start = out.size();
+                detail::append_ascii(out, *file);
+                detail::escape_json_tail(out, path_start);
+            }
+            detail::append_ascii(out, "\",\"line\":");
+            detail::append_uint(out, record.get_line().value_or(0));
+        }
+        if (auto id = record.get_thread_id()) {
+            detail::append_ascii(out, ",\"thread\":");
+            detail::append_uint(out, *id);
+            detail::append_ascii(out, ",\"thread_name\":\"");
+            auto name_start = out.size();
+            detail::append_ascii(out, record.get_thread_name().value_or(""));
+            detail::escape_json_tail(out, name_start);
+            out.push_back(CharT('"'));
+        }
+        detail::append_ascii(out, ",\"message\":\"");
+        auto message_start = out.size();
+        detail::append_message(out, record);
+        detail::escape_json_tail(out, message_start);
+        out.push_back(CharT('"'));
+
+        const auto& kvs = record.get_kvs();
+        if (!kvs.empty()) {
+            detail::append_ascii(out, ",\"fields\":{");
+            bool first = true;
+            for (const auto& kv : kvs) {
+                if (!first) {
+                    out.push_back(CharT(','));
+                }
+                first = false;
+                detail::append_json_string(out, kv.get_key_str());
+                out.push_back(CharT(':'));
+                kv.visit([&out](const auto& native) {
+                    detail::append_json_value<CharT>(out, native);
+                });
+            }
+            out.push_back(CharT('}'));
+        }
+        detail::append_ascii(out, "}\n");
+    }
+};
+
+/** @brief UTF-8 JSON encoder alias. */
+using JsonEncoder = BasicJsonEncoder<char>;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_JSON_ENCODER_HPP__
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <charconv>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <format>
 #include <functional>
 #include <iterator>
@@ -8,8 +11,12 @@
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include "bytes.hpp"
+#include "fast_format.hpp"
+
 #ifndef __LOG_PP_KV_HPP__
 #define __LOG_PP_KV_HPP__
 
@@ -28,6 +35,9 @@ std::basic_string<CharT> default_kv_value_format() {
     }
 }
 
+template <typename CharT>
+inline constexpr CharT DEFAULT_KV_VALUE_FORMAT[] = {CharT('{'), CharT('}')};
+
 template <typename CharT, typename T>
 std::basic_string<CharT> format_kv_value(T&& value,
                                          std::basic_string_view<CharT> format) {
@@ -46,12 +56,66 @@ std::basic_string<CharT> format_kv_value(T&& value,
     }
 }
 
+template <typename CharT, typename T>
+void format_kv_value_to(std::basic_string<CharT>& out,
+                        const T& value,
+                        std::basic_string_view<CharT> format) {
+    // Common specs such as `{:04X}` or `{:.2f}` skip std::format entirely.
+    bool fast = append_fast_format(
+        out, format,
+        [&value](std::basic_string<CharT>& buffer, std::size_t index,
+                 const FastSpec& spec) {
+            return index == 0 && append_fast<CharT>(buffer, value, spec);
+        });
+    if (fast) {
+        return;
+    }
+    if constexpr (std::same_as<CharT, char>) {
+        std::vformat_to(std::back_inserter(out), format,
+                        std::make_format_args(value));
+    } else if constexpr (std::same_as<CharT, wchar_t>) {
+        std::vformat_to(std::back_inserter(out), format,
+                        std::make_wformat_args(value));
+    } else {
+        out += format_kv_value<CharT>(value, format);
+    }
+}
+
 template <typename CharT, typename T>
 std::basic_string<CharT> format_kv_value(T&& value) {
     return format_kv_value<CharT>(std::forward<T>(value),
                                   default_kv_value_format<CharT>());
 }
 
+template <typename T>
+constexpr bool is_kv_character_v =
+    std::same_as<T, char> || std::same_as<T, wchar_t> ||
+    std::same_as<T, char8_t> || std::same_as<T, char16_t> ||
+    std::same_as<T, char32_t>;
+
+template <typename CharT>
+void append_kv_ascii(std::basic_string<CharT>& out, std::string_view text) {
+    if constexpr (std::same_as<CharT, char>) {
+        out.append(text);
+    } else {
+        for (char c : text) {
+            out.push_back(static_cast<CharT>(c));
+        }
+    }
+}
+
+template <typename CharT, typename T>
+void append_kv_chars(std::basic_string<CharT>& out, T value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    append_kv_ascii(out, std::string_view(buffer, result.ptr));
+}
+
+template <typename T, typename CharT>
+concept KVStringLike =
+    std::convertible_to<const T&, std::basic_string_view<CharT>> &&
+    !std::same_as<std::remove_cvref_t<T>, std::nullptr_t>;
+
 template <typename T>
 auto make_kv_value_holder(T&& value) {
     if constexpr (std::is_lvalue_reference_v<T>) {
@@ -73,6 +137,59 @@ decltype(auto) unwrap_kv_value_holder(const T& value) {
 
 }  // namespace detail
 
+template <typename CharT>
+struct BasicKV;
+
+/**
+ * @brief Key-value whose value is rendered by its format string or by
+ * `std::formatter` (user types, or any value given an explicit format).
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicKVCustom {
+   private:
+    const std::function<void(std::basic_string<CharT>&)>* formatter;
+
+   public:
+    explicit BasicKVCustom(
+        const std::function<void(std::basic_string<CharT>&)>& in_formatter)
+        : formatter(&in_formatter) {}
+
+    /**
+     * @brief Appends the formatted value to `out`.
+     * @param out Output buffer.
+     * @return Nothing.
+     */
+    void append_to(std::basic_string<CharT>& out) const { (*formatter)(out); }
+    /** @brief Returns the formatted value. @return Formatted value text. */
+    std::basic_string<CharT> to_string() const {
+        std::basic_string<CharT> out;
+        append_to(out);
+        return out;
+    }
+};
+
+/**
+ * @brief Native value of a key-value pair, as returned by
+ * @ref BasicKV::get_value.
+ *
+ * Signed and unsigned integers are widened to 64 bits. Strings are views
+ * that stay valid as long as the key-value pair (and, for lvalue strings, the
+ * referenced string) does. @ref Bytes values keep the caller's span.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+using BasicKVValue = std::variant<int64_t,
+                                  uint64_t,
+                                  float,
+                                  double,
+                                  bool,
+                                  std::basic_string_view<CharT>,
+                                  Bytes,
+                                  BasicKVCustom<CharT>>;
+
 template <typename CharT>
 /**
  * @brief Key-value pair stored in a log record.
@@ -89,8 +206,75 @@ template <typename CharT>
  */
 struct BasicKV {
    private:
+    using Formatter = std::function<void(std::basic_string<CharT>&)>;
+    using Storage = std::variant<int64_t,
+                                 uint64_t,
+                                 float,
+                                 double,
+                                 bool,
+                                 std::basic_string_view<CharT>,
+                                 Bytes,
+                                 const std::basic_string<CharT>*,
+                                 std::basic_string<CharT>,
+                                 Formatter>;
+
     std::basic_string_view<CharT> key;
-    std::function<std::basic_string<CharT>()> value_formatter;
+    Storage value;
+
+    template <typename T>
+    static Storage make_storage(T&& in_value) {
+        using U = std::remove_cvref_t<T>;
+        if constexpr (std::same_as<U, bool>) {
+            return Storage(std::in_place_type<bool>, in_value);
+        } else if constexpr (std::integral<U> &&
+                             !detail::is_kv_character_v<U>) {
+            if constexpr (std::is_signed_v<U>) {
+                return Storage(std::in_place_type<int64_t>, in_value);
+            } else {
+                return Storage(std::in_place_type<uint64_t>, in_value);
+            }
+        } else if constexpr (std::same_as<U, float> ||
+                             std::same_as<U, double> ||
+                             std::same_as<U, Bytes>) {
+            return Storage(std::in_place_type<U>, in_value);
+        } else if constexpr (std::same_as<U, std::basic_string<CharT>>) {
+            if constexpr (std::is_lvalue_reference_v<T>) {
+                // Lvalue strings keep reference semantics.
+                return Storage(std::in_place_type<const U*>, &in_value);
+            } else {
+                return Storage(std::in_place_type<U>, std::move(in_value));
+            }
+        } else if constexpr (std::is_pointer_v<std::decay_t<T>> &&
+                             detail::KVStringLike<T, CharT>) {
+            const CharT* text = in_value;
+            return Storage(std::in_place_type<std::basic_string_view<CharT>>,
+                           text == nullptr ? std::basic_string_view<CharT>()
+                                           : std::basic_string_view<CharT>(
+                                                 text));
+        } else if constexpr (detail::KVStringLike<T, CharT> &&
+                             (std::is_lvalue_reference_v<T> ||
+                              std::same_as<U, std::basic_string_view<CharT>>)) {
+            return Storage(std::in_place_type<std::basic_string_view<CharT>>,
+                           std::basic_string_view<CharT>(in_value));
+        } else if constexpr (detail::KVStringLike<T, CharT>) {
+            // A view of a temporary (`std::pmr::string`, a type with
+            // `operator string_view`, ...) would dangle; own a copy.
+            return Storage(std::in_place_type<std::basic_string<CharT>>,
+                           std::basic_string_view<CharT>(in_value));
+        } else {
+            auto stored_value =
+                detail::make_kv_value_holder<T>(std::forward<T>(in_value));
+            return Storage(
+                std::in_place_type<Formatter>,
+                [stored_value = std::move(stored_value)](
+                    std::basic_string<CharT>& out) {
+                    detail::format_kv_value_to<CharT>(
+                        out, detail::unwrap_kv_value_holder(stored_value),
+                        std::basic_string_view<CharT>(
+                            detail::DEFAULT_KV_VALUE_FORMAT<CharT>, 2));
+                });
+        }
+    }
 
    public:
     using char_type = CharT;
@@ -100,19 +284,18 @@ struct BasicKV {
     /**
      * @brief Creates a key-value pair using the default format string (`{}`).
      *
+     * Integers, floating-point values, `bool`, strings and @ref Bytes are
+     * stored natively; lvalue strings are referenced, rvalue strings other
+     * than `std::basic_string_view` are copied. Other types are formatted with
+     * `std::formatter` on access.
+     *
      * @tparam T Value type.
      * @param in_key Key text.
-     * @param in_value Value to be formatted and stored.
+     * @param in_value Value to be stored.
      */
     template <typename T>
-    BasicKV(std::basic_string_view<CharT> in_key, T&& in_value) : key(in_key) {
-        auto stored_value =
-            detail::make_kv_value_holder<T>(std::forward<T>(in_value));
-        value_formatter = [stored_value = std::move(stored_value)]() {
-            return detail::format_kv_value<CharT>(
-                detail::unwrap_kv_value_holder(stored_value));
-        };
-    }
+    BasicKV(std::basic_string_view<CharT> in_key, T&& in_value)
+        : key(in_key), value(make_storage<T>(std::forward<T>(in_value))) {}
 
     /**
      * @brief Creates a key-value pair using a custom value format string.
@@ -130,11 +313,13 @@ struct BasicKV {
         auto stored_value =
             detail::make_kv_value_holder<T>(std::forward<T>(in_value));
         auto format = std::basic_string<CharT>(in_format);
-        value_formatter = [stored_value = std::move(stored_value),
-                           format = std::move(format)]() {
-            return detail::format_kv_value<CharT>(
-                detail::unwrap_kv_value_holder(stored_value), format);
-        };
+        value.template emplace<Formatter>(
+            [stored_value = std::move(stored_value),
+             format = std::move(format)](std::basic_string<CharT>& out) {
+                detail::format_kv_value_to<CharT>(
+                    out, detail::unwrap_kv_value_holder(stored_value),
+                    std::basic_string_view<CharT>(format));
+            });
     }
 
     /**
@@ -142,7 +327,7 @@ struct BasicKV {
      *
      * @tparam T Value type.
      * @param in_key Key text.
-     * @param in_value Value to be formatted and stored.
+     * @param in_value Value to be stored.
      */
     template <typename T>
     BasicKV(const CharT* in_key, T&& in_value)
@@ -165,9 +350,85 @@ struct BasicKV {
 
     /** @brief Returns the key. @return Key text. */
     std::basic_string_view<CharT> get_key_str() const noexcept { return key; }
+
+    /**
+     * @brief Returns the native value.
+     *
+     * Example:
+     * @code
+     * if (auto* id = std::get_if<int64_t>(&kv.get_value())) { ... }
+     * @endcode
+     *
+     * @return Value variant.
+     */
+    BasicKVValue<CharT> get_value() const noexcept {
+        return std::visit(
+            [this](const auto& stored) -> BasicKVValue<CharT> {
+                using S = std::remove_cvref_t<decltype(stored)>;
+                if constexpr (std::same_as<S, const std::basic_string<CharT>*>) {
+                    return std::basic_string_view<CharT>(*stored);
+                } else if constexpr (std::same_as<S,
+                                                  std::basic_string<CharT>>) {
+                    return std::basic_string_view<CharT>(stored);
+                } else if constexpr (std::same_as<S, Formatter>) {
+                    return BasicKVCustom<CharT>(stored);
+                } else {
+                    return stored;
+                }
+            },
+            value);
+    }
+
+    /**
+     * @brief Calls `visitor` with the native value.
+     *
+     * The visitor must accept every @ref BasicKVValue alternative.
+     *
+     * Example:
+     * @code
+     * kv.visit([&](const auto& v) { write_native(v); });
+     * @endcode
+     *
+     * @param visitor Callable overloaded for each value type.
+     * @return Result of the visitor.
+     */
+    template <typename Visitor>
+    decltype(auto) visit(Visitor&& visitor) const {
+        return std::visit(std::forward<Visitor>(visitor), get_value());
+    }
+
     /** @brief Returns the formatted value. @return Formatted value text. */
     std::basic_string<CharT> get_value_string() const noexcept {
-        return value_formatter();
+        std::basic_string<CharT> out;
+        append_value(out);
+        return out;
+    }
+
+    /**
+     * @brief Formats the value directly onto the end of `out`.
+     *
+     * Native values are rendered with `std::to_chars` and @ref Bytes as hex or
+     * base64; only custom values go through `std::format`.
+     *
+     * @param out Buffer the formatted value is appended to.
+     * @return Nothing.
+     */
+    void append_value(std::basic_string<CharT>& out) const {
+        visit([&out](const auto& native) {
+            using V = std::remove_cvref_t<decltype(native)>;
+            if constexpr (std::same_as<V, bool>) {
+                detail::append_kv_ascii(out, native ? "true" : "false");
+            } else if constexpr (std::same_as<V,
+                                              std::basic_string_view<CharT>>) {
+                out.append(native);
+            } else if constexpr (std::same_as<V, Bytes>) {
+                detail::append_bytes(out, native);
+            } else if constexpr (std::same_as<V, BasicKVCustom<CharT>>) {
+                native.append_to(out);
+            } else {
+                detail::append_kv_chars<CharT>(out, native);
+            }
+        });
     }
 };
 
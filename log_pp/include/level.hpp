@@ -3,6 +3,9 @@
 #include <algorithm>
 #include <compare>
 #include <format>
+#include <optional>
+#include <string_view>
+#include <utility>
 
 #ifndef __LOG_PP_LEVEL_HPP__
 #define __LOG_PP_LEVEL_HPP__
@@ -132,6 +135,48 @@ enum class LevelFilter {
     Trace,
 };
 
+/**
+ * @brief Parses a level filter name.
+ *
+ * Accepts `off`, `error`, `warn` (or `warning`), `info`, `debug` and `trace`
+ * in any letter case.
+ *
+ * Example: `auto filter = log_pp::parse_level_filter("debug");`
+ *
+ * @tparam CharT Character type.
+ * @param text Level name.
+ * @return Level filter, or empty when `text` is not a level name.
+ */
+template <typename CharT>
+constexpr std::optional<LevelFilter> parse_level_filter(
+    std::basic_string_view<CharT> text) noexcept {
+    constexpr std::pair<std::string_view, LevelFilter> names[] = {
+        {"off", LevelFilter::Off},     {"error", LevelFilter::Error},
+        {"warn", LevelFilter::Warn},   {"warning", LevelFilter::Warn},
+        {"info", LevelFilter::Info},   {"debug", LevelFilter::Debug},
+        {"trace", LevelFilter::Trace},
+    };
+    auto same_letter = [](char lhs, CharT rhs) {
+        if (rhs >= CharT('A') && rhs <= CharT('Z')) {
+            rhs += CharT('a' - 'A');
+        }
+        return CharT(lhs) == rhs;
+    };
+    for (const auto& [name, filter] : names) {
+        if (name.size() == text.size() &&
+            std::equal(name.begin(), name.end(), text.begin(), same_letter)) {
+            return filter;
+        }
+    }
+    return std::nullopt;
+}
+
+/** @brief Parses a level filter name. @see parse_level_filter */
+constexpr std::optional<LevelFilter> parse_level_filter(
+    std::string_view text) noexcept {
+    return parse_level_filter<char>(text);
+}
+
 constexpr std::strong_ordering operator<=>(const LevelFilter lhs,
                                            const LevelFilter rhs) noexcept {
     return static_cast<int>(lhs) <=> static_cast<int>(rhs);
@@ -1,14 +1,21 @@
 #pragma once
 
+#include <algorithm>
 #include <concepts>
 #include <format>
 #include <functional>
 #include <initializer_list>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <source_location>
 #include <string_view>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "callsite.hpp"
+#include "clock.hpp"
 #include "comptime_filter.hpp"
 #include "kv.hpp"
 #include "level.hpp"
@@ -17,10 +24,24 @@
 
 #include "log_pp_export.h"
 #include "record.hpp"
+#include "target_intern.hpp"
+#include "thread_info.hpp"
 
 #ifndef __LOG_PP_LOG_HPP__
 #define __LOG_PP_LOG_HPP__
 
+/**
+ * @brief Forces inlining of the `log()` entry points, so compile-time filtered
+ * statements fold away at the call site instead of calling into `log()`.
+ */
+#if defined(_MSC_VER)
+#define LOG_PP_ALWAYS_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#define LOG_PP_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define LOG_PP_ALWAYS_INLINE inline
+#endif
+
 namespace log_pp {
 
 /**
@@ -35,16 +56,108 @@ LOG_PP_EXPORT void set_max_level(LevelFilter level) noexcept;
 /**
  * @brief Returns the current runtime maximum log level filter.
  *
- * @return Current runtime level filter.
+ * @return Level set by @ref set_thread_max_level on this thread, otherwise
+ * the process-wide level, raised to the thread's @ref thread_level_floor.
  */
 LOG_PP_EXPORT LevelFilter max_level() noexcept;
+/**
+ * @brief Returns the calling thread's @ref set_thread_max_level override.
+ *
+ * @return Override, or `std::nullopt` when the thread follows
+ * @ref set_max_level.
+ */
+LOG_PP_EXPORT std::optional<LevelFilter> thread_max_level() noexcept;
+/**
+ * @brief Overrides `max_level()` for the calling thread only.
+ *
+ * At statements a @ref CallsiteRule matches, the more verbose of the rule
+ * and the override applies. Records logged under the override carry it as
+ * @ref BasicMetadata::get_level_override, so `DirectiveFilter` and sink
+ * levels let them through too. Prefer @ref ThreadLevelGuard.
+ *
+ * @param level Level for this thread, or `std::nullopt` to follow
+ * @ref set_max_level again.
+ * @return Previous override of this thread, if any.
+ */
+LOG_PP_EXPORT std::optional<LevelFilter> set_thread_max_level(
+    std::optional<LevelFilter> level) noexcept;
+/**
+ * @brief Returns the least verbose level the calling thread allows.
+ *
+ * @return Level set by @ref set_thread_level_floor; `Off` by default.
+ */
+LOG_PP_EXPORT LevelFilter thread_level_floor() noexcept;
+/**
+ * @brief Raises verbosity for the calling thread without lowering it.
+ *
+ * Unlike @ref set_thread_max_level, the thread keeps following the live
+ * process-wide level wherever that is more verbose. Used by
+ * @ref SamplingScope.
+ *
+ * @param level Least verbose level for this thread; `Off` removes the floor.
+ * @return Nothing.
+ */
+LOG_PP_EXPORT void set_thread_level_floor(LevelFilter level) noexcept;
+
+namespace detail {
+
+/** @brief Runtime levels of the calling thread. */
+struct ThreadLevels {
+    /** @brief Value of `max_level()`. */
+    LevelFilter max = LevelFilter::Trace;
+    /**
+     * @brief Level the thread's override or floor grants past logger-side
+     * filters; `Off` when the thread has neither.
+     */
+    LevelFilter granted = LevelFilter::Off;
+};
+
+/**
+ * @brief Returns `max_level()` and the thread's granted level in one call.
+ * @return Thread levels.
+ */
+LOG_PP_EXPORT ThreadLevels thread_levels() noexcept;
+
+}  // namespace detail
+
+/**
+ * @brief Scoped @ref set_thread_max_level; restores the previous override.
+ *
+ * Example:
+ * @code
+ * void handle(const Request& req) {
+ *     std::optional<log_pp::ThreadLevelGuard> verbose;
+ *     if (req.debug) {
+ *         verbose.emplace(log_pp::LevelFilter::Trace);
+ *     }
+ *     ...
+ * }
+ * @endcode
+ */
+struct ThreadLevelGuard {
+   private:
+    std::optional<LevelFilter> previous;
+
+   public:
+    explicit ThreadLevelGuard(LevelFilter level) noexcept
+        : previous(set_thread_max_level(level)) {}
+    ~ThreadLevelGuard() noexcept { set_thread_max_level(previous); }
+
+    ThreadLevelGuard(const ThreadLevelGuard&) = delete;
+    ThreadLevelGuard& operator=(const ThreadLevelGuard&) = delete;
+};
 
 /**
  * @brief Target/category wrapper used by `log()` overloads.
  *
+ * Each statement caches its target's @ref TargetId in its callsite and
+ * confirms it with one compare per enabled call. Targets written with
+ * @ref LOG_PP_TARGET are known to be string literals and skip the compare.
+ *
  * Example:
  * @code
  * LOG_PP_INFO({"http"}, "request done");
+ * LOG_PP_INFO(LOG_PP_TARGET("http"), "request done");  // cached ID
  * @endcode
  *
  * @tparam CharT Character type.
@@ -52,9 +165,39 @@ LOG_PP_EXPORT LevelFilter max_level() noexcept;
 template <typename CharT = char>
 struct basic_target_t {
     /** @brief Target/category text. */
-    std::basic_string_view<CharT> val;
+    std::basic_string_view<CharT> val{};
+    /** @brief Whether `val` is a string literal; set by @ref LOG_PP_TARGET. */
+    bool literal = false;
+
+    constexpr basic_target_t() noexcept = default;
+    template <std::size_t N>
+    constexpr basic_target_t(const CharT (&text)[N]) noexcept : val(text) {}
+    constexpr basic_target_t(std::basic_string_view<CharT> text) noexcept
+        : val(text) {}
 };
 
+namespace detail {
+
+/**
+ * @brief Builds a target flagged as a string literal.
+ *
+ * Only @ref LOG_PP_TARGET may call this: a `const` array that is not a
+ * literal (e.g. a `char name[16]` member) can change between calls, and a
+ * cached ID would then name the wrong target.
+ *
+ * @param text String literal.
+ * @return Target whose ID may be cached per statement.
+ */
+template <typename CharT, std::size_t N>
+constexpr basic_target_t<CharT> literal_target(
+    const CharT (&text)[N]) noexcept {
+    basic_target_t<CharT> target(text);
+    target.literal = true;
+    return target;
+}
+
+}  // namespace detail
+
 template <typename T, typename CharT>
 /**
  * @brief Constraint for logger-like types accepted by `log()` overloads.
@@ -74,29 +217,140 @@ struct default_logger_t : public BasicLogger<CharT> {
     void flush() override {}
 };
 
+/**
+ * @brief Process-wide logger slot behind @ref set_logger and
+ * @ref replace_logger.
+ *
+ * Readers pay one acquire load of `current` and nothing else. Writers
+ * serialize on `update_mutex` and keep every replaced owner in `retired`
+ * instead of destroying it, so a `log()` call that loaded it can never see
+ * it freed. Replacing the global logger is a rare reconfiguration step, so
+ * the retained loggers are bounded by how often that happens.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct GlobalLogger {
+    /** @brief Active logger. */
+    std::atomic<BasicLogger<CharT>*> current;
+    /** @brief Keeps `current` alive; empty for non-owned loggers. */
+    std::shared_ptr<BasicLogger<CharT>> owner{};
+    /** @brief Consumed by the first @ref set_logger or @ref replace_logger. */
+    std::once_flag set_once{};
+    /** @brief Serializes writers. */
+    std::mutex update_mutex{};
+    /** @brief Replaced owners, kept alive for the life of the process. */
+    std::vector<std::shared_ptr<BasicLogger<CharT>>> retired{};
+
+    explicit GlobalLogger(BasicLogger<CharT>& initial) noexcept
+        : current(&initial) {}
+
+    /**
+     * @brief Publishes `next` and keeps the previous owner alive.
+     *
+     * @param next New logger; `next.get()` must not be `nullptr`.
+     * @return Previous logger, non-owning if it was never owned.
+     */
+    std::shared_ptr<BasicLogger<CharT>> exchange(
+        std::shared_ptr<BasicLogger<CharT>> next) {
+        using owner_t = std::shared_ptr<BasicLogger<CharT>>;
+        std::lock_guard lock(update_mutex);
+        auto* previous =
+            current.exchange(next.get(), std::memory_order_acq_rel);
+        auto replaced = std::exchange(owner, std::move(next));
+        if (!replaced) {
+            return owner_t(std::shared_ptr<void>{}, previous);
+        }
+        retired.push_back(replaced);
+        return replaced;
+    }
+};
+
 template <typename CharT>
-std::reference_wrapper<BasicLogger<CharT>>& global_logger() noexcept {
+GlobalLogger<CharT>& global_logger() noexcept {
+    // Intentionally leaked so statements running during static destruction
+    // still find a logger.
     static default_logger_t<CharT> default_logger{};
-    static std::reference_wrapper<BasicLogger<CharT>> current = default_logger;
-    return current;
+    static auto* instance = new GlobalLogger<CharT>(default_logger);
+    return *instance;
 }
 
-template <typename CharT>
-std::once_flag& logger_flag() noexcept {
-    static std::once_flag flag{};
-    return flag;
+namespace detail {
+
+/**
+ * @brief Returns the runtime levels for a statement.
+ *
+ * A matching @ref CallsiteRule grants its level past logger-side filters,
+ * like a thread override does, so a rule can make a statement more verbose
+ * than the `DirectiveFilter` would allow.
+ *
+ * @param callsite Statement location and cache.
+ * @return `max` is the level of the matching @ref CallsiteRule, raised to
+ * the thread's granted level, otherwise `max_level()`. `granted` is the
+ * more verbose of the rule's level and the thread's granted level.
+ */
+inline ThreadLevels statement_levels(const CallsiteRef& callsite) noexcept {
+    auto levels = thread_levels();
+    if (callsite.site != nullptr) {
+        auto state = callsite.site->state.load(std::memory_order_relaxed);
+        if (state == Callsite::UNRESOLVED) {
+            state = resolve_callsite(*callsite.site, callsite.location);
+        }
+        if (state >= 0) {
+            levels.max =
+                std::max(static_cast<LevelFilter>(state), levels.granted);
+            levels.granted = levels.max;
+        }
+    }
+    return levels;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Returns the runtime level for a statement.
+ *
+ * @param callsite Statement location and cache.
+ * @return Level of the matching @ref CallsiteRule, raised to the thread's
+ * override or floor if more verbose; otherwise `max_level()`.
+ */
+inline LevelFilter callsite_level(const CallsiteRef& callsite) noexcept {
+    return detail::statement_levels(callsite).max;
 }
 
+/**
+ * @brief Returns the interned ID of a statement's target.
+ *
+ * The ID is cached in the callsite. @ref LOG_PP_TARGET targets are literals
+ * and use it as is; any other target is checked against the cached ID's text
+ * with one compare, since a `const` array (e.g. a `char name[16]` member) can
+ * hold different text on each call.
+ *
+ * @param target Statement target.
+ * @param callsite Statement location and cache.
+ * @return Target ID.
+ */
 template <typename CharT>
-bool enabled(const BasicLogger<CharT>& logger,
-             Level level,
-             std::basic_string_view<CharT> target) {
-    return level <= log_pp::get_comptime_level() &&
-           level <= log_pp::max_level() &&
-           logger.enabled(log_pp::BasicMetadataBuilder<CharT>()
-                              .set_level(level)
-                              .set_target(target)
-                              .build());
+TargetId callsite_target_id(const basic_target_t<CharT>& target,
+                            const CallsiteRef& callsite) {
+    if (callsite.site == nullptr) {
+        return intern_target(target.val);
+    }
+    auto id = callsite.site->target_id.load(std::memory_order_relaxed);
+    if (id != NO_TARGET_ID) {
+        if (target.literal) {
+            return id;
+        }
+        auto name = target_name<CharT>(id);
+        if (name && name->size() == target.val.size() &&
+            std::char_traits<CharT>::compare(name->data(), target.val.data(),
+                                             name->size()) == 0) {
+            return id;
+        }
+    }
+    id = intern_target(target.val);
+    callsite.site->target_id.store(id, std::memory_order_relaxed);
+    return id;
 }
 
 template <typename CharT = char>
@@ -104,6 +358,7 @@ template <typename CharT = char>
  * @brief Sets process-wide global logger once.
  *
  * The first successful call wins; subsequent calls keep the original logger.
+ * A prior @ref replace_logger also counts as the first call.
  *
  * Example:
  * @code
@@ -111,19 +366,54 @@ template <typename CharT = char>
  * log_pp::set_logger(logger);
  * @endcode
  *
- * @param logger Logger instance to set as the global logger.
+ * @param logger Logger instance to set as the global logger. Not owned; it
+ * must outlive every logging call.
  * @return `true` when `logger` is the active global logger.
  */
 bool set_logger(BasicLogger<CharT>& logger) noexcept {
-    std::call_once(logger_flag<CharT>(),
-                   [&]() { global_logger<CharT>() = logger; });
-    return &(global_logger<CharT>().get()) == &logger;
+    auto& global = global_logger<CharT>();
+    std::call_once(global.set_once, [&]() {
+        global.exchange(std::shared_ptr<BasicLogger<CharT>>(
+            std::shared_ptr<void>{}, &logger));
+    });
+    return global.current.load(std::memory_order_acquire) == &logger;
+}
+
+template <typename CharT = char>
+/**
+ * @brief Replaces the process-wide global logger at any time.
+ *
+ * Statements that already loaded the previous logger finish on it, and
+ * neither side blocks the other. The previous logger is never destroyed, so
+ * statements need no read-side protection; flush it through the returned
+ * pointer if it buffers records. Use it to reconfigure after startup, e.g.
+ * to move from a synchronous to an asynchronous sink.
+ *
+ * Example:
+ * @code
+ * auto previous = log_pp::replace_logger<char>(
+ *     std::make_shared<MyAsyncLogger>());
+ * @endcode
+ *
+ * @param logger New global logger; shared ownership is taken.
+ * @return Previous logger, which stays alive until the process exits.
+ * Loggers installed by @ref set_logger are returned as non-owning pointers.
+ * Records still in flight may reach it after this call returns.
+ */
+std::shared_ptr<BasicLogger<CharT>> replace_logger(
+    std::shared_ptr<BasicLogger<CharT>> logger) {
+    auto& global = global_logger<CharT>();
+    std::call_once(global.set_once, []() {});
+    return global.exchange(std::move(logger));
 }
 
 template <typename CharT = char>
 /**
  * @brief Returns the active global logger reference.
  *
+ * The reference stays valid after a @ref replace_logger, but no longer
+ * names the active logger.
+ *
  * Example:
  * @code
  * auto& lg = log_pp::logger();
@@ -133,25 +423,62 @@ template <typename CharT = char>
  * @return Active global logger reference.
  */
 BasicLogger<CharT>& logger() noexcept {
-    return global_logger<CharT>();
+    return *global_logger<CharT>().current.load(std::memory_order_acquire);
 }
 
+namespace detail {
+
+/**
+ * @brief Returns the logger a forwarding logger currently sends to.
+ *
+ * Forwarding loggers such as @ref BasicNamedLogger expose it as
+ * `get_logger()`; other loggers are returned as is.
+ *
+ * @param logger Statement logger.
+ * @return Logger to call for the whole statement.
+ */
+template <typename L>
+decltype(auto) statement_logger(L& logger) noexcept {
+    if constexpr (requires { logger.get_logger(); }) {
+        return logger.get_logger();
+    } else {
+        return (logger);
+    }
+}
+
+}  // namespace detail
+
 template <typename CharT, LoggerType<CharT> L>
-void log_impl(L& logger,
+void log_impl(L& statement,
               Level level,
-              std::basic_string_view<CharT> target,
-              std::source_location module,
+              basic_target_t<CharT> target,
+              CallsiteRef module,
               std::initializer_list<BasicKV<CharT>> kvs,
               std::basic_string_view<CharT> fmt,
               FormatArgs<CharT> args) {
-    if (enabled(logger, level, target)) {
+    auto levels = detail::statement_levels(module);
+    if (level > levels.max) {
+        return;
+    }
+    // Resolved once, so enabled() and log() reach the same logger even if a
+    // forwarding logger is retargeted in between.
+    auto& logger = detail::statement_logger(statement);
+    auto metadata = BasicMetadataBuilder<CharT>()
+                        .set_level(level)
+                        .set_target(target.val)
+                        .set_target_id(callsite_target_id(target, module))
+                        .set_module(module.location)
+                        .set_level_override(levels.granted)
+                        .build();
+    if (logger.enabled(metadata)) {
         auto record_builder = BasicRecordBuilder<CharT>()
-                                  .set_level(level)
-                                  .set_target(target)
+                                  .set_metadata(metadata)
                                   .set_args(args)
                                   .set_kvs(BasicKVList<CharT>(kvs))
                                   .set_format_string(fmt)
-                                  .set_module(module);
+                                  .set_module(module.location)
+                                  .set_timestamp(capture_timestamp())
+                                  .set_thread(current_thread());
         logger.log(record_builder.build());
     }
 }
@@ -179,22 +506,26 @@ template <typename CharT, LoggerType<CharT> L, typename... Args>
  * @param args Format arguments.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         L& logger,
-         basic_target_t<CharT> target,
-         std::initializer_list<BasicKV<CharT>> kvs,
-         const CharT* fmt,
-         Args&&... args) {
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              L& logger,
+                              basic_target_t<CharT> target,
+                              std::initializer_list<BasicKV<CharT>> kvs,
+                              const CharT* fmt,
+                              Args&&... args) {
+    // Folds to a constant for literal targets; see LOG_PP_TARGET_LEVEL_FILTER.
+    if (level > get_comptime_level(target.val)) {
+        return;
+    }
     if constexpr (std::same_as<CharT, char>) {
-        log_impl(logger, level, target.val, module, kvs, {fmt},
+        log_impl(logger, level, target, module, kvs, {fmt},
                  std::make_format_args(args...));
     } else if constexpr (std::same_as<CharT, wchar_t>) {
-        log_impl(logger, level, target.val, module, kvs, {fmt},
+        log_impl(logger, level, target, module, kvs, {fmt},
                  std::make_wformat_args(args...));
     } else {
         auto store = std::make_format_args<CharT>(args...);
-        log_impl(logger, level, target.val, module, kvs, {fmt},
+        log_impl(logger, level, target, module, kvs, {fmt},
                  FormatArgs<CharT>(store));
     }
 }
@@ -220,12 +551,12 @@ template <typename CharT, LoggerType<CharT> L, typename... Args>
  * @param args Format arguments.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         L& logger,
-         basic_target_t<CharT> target,
-         const CharT* fmt,
-         Args&&... args) {
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              L& logger,
+                              basic_target_t<CharT> target,
+                              const CharT* fmt,
+                              Args&&... args) {
     log(level, module, logger, target, {}, fmt, std::forward<Args>(args)...);
 }
 
@@ -250,12 +581,12 @@ template <typename CharT, LoggerType<CharT> L, typename... Args>
  * @param args Format arguments.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         L& logger,
-         std::initializer_list<BasicKV<CharT>> kvs,
-         const CharT* fmt,
-         Args&&... args) {
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              L& logger,
+                              std::initializer_list<BasicKV<CharT>> kvs,
+                              const CharT* fmt,
+                              Args&&... args) {
     log(level, module, logger, basic_target_t<CharT>{}, kvs, fmt,
         std::forward<Args>(args)...);
 }
@@ -278,11 +609,11 @@ template <typename CharT, LoggerType<CharT> L, typename... Args>
  * @param args Format arguments.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         L& logger,
-         const CharT* fmt,
-         Args&&... args) {
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              L& logger,
+                              const CharT* fmt,
+                              Args&&... args) {
     log(level, module, logger, basic_target_t<CharT>{}, {}, fmt,
         std::forward<Args>(args)...);
 }
@@ -307,20 +638,24 @@ template <typename CharT, LoggerType<CharT> L>
  * @param kvs Key-value pairs.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         L& logger,
-         basic_target_t<CharT> target,
-         std::initializer_list<BasicKV<CharT>> kvs) {
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              L& logger,
+                              basic_target_t<CharT> target,
+                              std::initializer_list<BasicKV<CharT>> kvs) {
+    // Folds to a constant for literal targets; see LOG_PP_TARGET_LEVEL_FILTER.
+    if (level > get_comptime_level(target.val)) {
+        return;
+    }
     if constexpr (std::same_as<CharT, char>) {
-        log_impl(logger, level, target.val, module, kvs, {},
+        log_impl(logger, level, target, module, kvs, {},
                  std::make_format_args());
     } else if constexpr (std::same_as<CharT, wchar_t>) {
-        log_impl(logger, level, target.val, module, kvs, {},
+        log_impl(logger, level, target, module, kvs, {},
                  std::make_wformat_args());
     } else {
         auto store = std::make_format_args<CharT>();
-        log_impl(logger, level, target.val, module, kvs, {},
+        log_impl(logger, level, target, module, kvs, {},
                  FormatArgs<CharT>(store));
     }
 }
@@ -345,11 +680,11 @@ template <typename CharT, LoggerType<CharT> L>
  * @param kvs Key-value pairs.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         L& logger,
-         std::initializer_list<const CharT*> target,
-         std::initializer_list<BasicKV<CharT>> kvs) {
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              L& logger,
+                              std::initializer_list<const CharT*> target,
+                              std::initializer_list<BasicKV<CharT>> kvs) {
     if (target.size() > 0) {
         log(level, module, logger, basic_target_t<CharT>{*target.begin()}, kvs);
     } else {
@@ -379,10 +714,10 @@ template <typename CharT, LoggerType<CharT> L>
  * @param kvs Key-value pairs.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         L& logger,
-         std::initializer_list<BasicKV<CharT>> kvs) {
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              L& logger,
+                              std::initializer_list<BasicKV<CharT>> kvs) {
     log(level, module, logger, basic_target_t<CharT>{}, kvs);
 }
 
@@ -409,12 +744,18 @@ template <typename CharT, typename... Args>
  * @param args Format arguments.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         basic_target_t<CharT> target,
-         std::initializer_list<BasicKV<CharT>> kvs,
-         const CharT* fmt,
-         Args&&... args) {
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              basic_target_t<CharT> target,
+                              std::initializer_list<BasicKV<CharT>> kvs,
+                              const CharT* fmt,
+                              Args&&... args) {
+    // Checked before touching the global logger so filtered statements
+    // leave nothing behind.
+    if (level > get_comptime_level(target.val) ||
+        level > callsite_level(module)) {
+        return;
+    }
     log(level, module, logger<CharT>(), target, kvs, fmt,
         std::forward<Args>(args)...);
 }
@@ -438,13 +779,12 @@ template <typename CharT, typename... Args>
  * @param args Format arguments.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         basic_target_t<CharT> target,
-         const CharT* fmt,
-         Args&&... args) {
-    log(level, module, logger<CharT>(), target, {}, fmt,
-        std::forward<Args>(args)...);
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              basic_target_t<CharT> target,
+                              const CharT* fmt,
+                              Args&&... args) {
+    log(level, module, target, {}, fmt, std::forward<Args>(args)...);
 }
 
 template <typename CharT, typename... Args>
@@ -466,12 +806,12 @@ template <typename CharT, typename... Args>
  * @param args Format arguments.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         std::initializer_list<BasicKV<CharT>> kvs,
-         const CharT* fmt,
-         Args&&... args) {
-    log(level, module, logger<CharT>(), basic_target_t<CharT>{}, kvs, fmt,
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              std::initializer_list<BasicKV<CharT>> kvs,
+                              const CharT* fmt,
+                              Args&&... args) {
+    log(level, module, basic_target_t<CharT>{}, kvs, fmt,
         std::forward<Args>(args)...);
 }
 
@@ -493,16 +833,54 @@ template <typename CharT, typename... Args>
  * @param args Format arguments.
  * @return Nothing.
  */
-void log(Level level,
-         std::source_location module,
-         const CharT* fmt,
-         Args&&... args) {
-    log(level, module, logger<CharT>(), basic_target_t<CharT>{}, {}, fmt,
+LOG_PP_ALWAYS_INLINE void log(Level level,
+                              CallsiteRef module,
+                              const CharT* fmt,
+                              Args&&... args) {
+    log(level, module, basic_target_t<CharT>{}, {}, fmt,
         std::forward<Args>(args)...);
 }
 
 }  // namespace log_pp
 
+/**
+ * @def LOG_PP_MODULE_LEVEL
+ * @brief Caps the level of the `LOG_PP_*` statements in one translation unit.
+ *
+ * Define it to a `log_pp::LevelFilter` enumerator name before the first
+ * include of `log.hpp`. Statements above it are removed at the call site,
+ * arguments included, on top of the build-wide and per-target filters.
+ * `LOG_PP_RELEASE_MODULE_LEVEL` takes precedence under `NDEBUG`, like the
+ * `LOG_PP_RELEASE_LEVEL_FILTER_*` group does for @ref get_comptime_level.
+ *
+ * Example:
+ * @code
+ * #define LOG_PP_MODULE_LEVEL Warn  // hot packet parser
+ * #include "log.hpp"
+ * @endcode
+ */
+#if defined(NDEBUG) && defined(LOG_PP_RELEASE_MODULE_LEVEL)
+#define LOG_PP_DETAIL_MODULE_LEVEL \
+    log_pp::LevelFilter::LOG_PP_RELEASE_MODULE_LEVEL
+#elif defined(LOG_PP_MODULE_LEVEL)
+#define LOG_PP_DETAIL_MODULE_LEVEL log_pp::LevelFilter::LOG_PP_MODULE_LEVEL
+#endif
+
+/**
+ * @brief Target given as a string literal, with its ID cached per statement.
+ *
+ * The `""` concatenation rejects anything but a string literal at compile
+ * time.
+ *
+ * Example:
+ * @code
+ * LOG_PP_INFO(LOG_PP_TARGET("db::pool"), "acquired {}", id);
+ * @endcode
+ *
+ * @param name String literal.
+ */
+#define LOG_PP_TARGET(name) log_pp::detail::literal_target("" name)
+
 /**
  * @brief Base logging macro used by severity macros.
  *
@@ -514,8 +892,15 @@ void log(Level level,
  * @param level Severity level.
  * @return Nothing.
  */
+#ifdef LOG_PP_DETAIL_MODULE_LEVEL
+#define LOG_PP(level, ...)                                                 \
+    if (!((level) <= LOG_PP_DETAIL_MODULE_LEVEL)) {                        \
+    } else                                                                 \
+        log_pp::log(level, LOG_PP_CALLSITE(), __VA_ARGS__);
+#else
 #define LOG_PP(level, ...) \
-    log_pp::log(level, std::source_location::current(), __VA_ARGS__);
+    log_pp::log(level, LOG_PP_CALLSITE(), __VA_ARGS__);
+#endif
 
 /**
  * @brief Logs at TRACE severity.
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
+
 #include "metadata.hpp"
 #include "record.hpp"
 
@@ -52,6 +55,21 @@ struct BasicLogger {
      * @return Nothing.
      */
     virtual void log(const BasicRecord<CharT>& record) = 0;
+    /**
+     * @brief Emits several records with one call.
+     *
+     * Like @ref log, records are expected to have passed @ref enabled. The
+     * default implementation calls @ref log for each record; sinks override
+     * it to encode the batch into one buffer and write it at once.
+     *
+     * @param records Records to emit, in order.
+     * @return Nothing.
+     */
+    virtual void log_batch(std::span<const BasicRecord<CharT>> records) {
+        for (const auto& record : records) {
+            log(record);
+        }
+    }
     /**
      * @brief Flushes buffered output.
      *
@@ -63,6 +81,46 @@ struct BasicLogger {
 /** @brief UTF-8 logger interface alias. */
 using ILogger = BasicLogger<char>;
 
+namespace detail {
+
+/**
+ * @brief Forwards a batch in runs that share a destination.
+ *
+ * Composite loggers use it to keep batches intact: each maximal run of
+ * consecutive records that `route` maps to the same logger, and that logger
+ * accepts, is handed over with one @ref BasicLogger::log_batch call.
+ *
+ * @tparam CharT Character type.
+ * @tparam F Callable returning the destination of a record, or `nullptr` to
+ * drop it.
+ * @param records Records to forward.
+ * @param route Destination lookup.
+ * @return Nothing.
+ */
+template <typename CharT, typename F>
+void log_batch_runs(std::span<const BasicRecord<CharT>> records, F&& route) {
+    BasicLogger<CharT>* current = nullptr;
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        BasicLogger<CharT>* next = route(records[i]);
+        if (next != nullptr && !next->enabled(records[i].get_metadata())) {
+            next = nullptr;
+        }
+        if (next != current) {
+            if (current != nullptr) {
+                current->log_batch(records.subspan(start, i - start));
+            }
+            current = next;
+            start = i;
+        }
+    }
+    if (current != nullptr) {
+        current->log_batch(records.subspan(start));
+    }
+}
+
+}  // namespace detail
+
 }  // namespace log_pp
 
 #endif  // !__LOG_PP_LOG_INTERFACE_HPP__
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "encoder.hpp"
+#include "json_encoder.hpp"
+#include "level.hpp"
+#include "record.hpp"
+#include "text_scan.hpp"
+
+#ifndef __LOG_PP_LOGFMT_ENCODER_HPP__
+#define __LOG_PP_LOGFMT_ENCODER_HPP__
+
+namespace log_pp {
+
+namespace detail {
+
+constexpr std::string_view logfmt_level(Level level) noexcept {
+    switch (level) {
+        case Level::Error:
+            return "error";
+        case Level::Warning:
+            return "warn";
+        case Level::Info:
+            return "info";
+        case Level::Debug:
+            return "debug";
+        case Level::Trace:
+            return "trace";
+        default:
+            return "unknown";
+    }
+}
+
+template <typename CharT>
+bool logfmt_needs_quotes(std::basic_string_view<CharT> text) noexcept {
+    if (text.empty()) {
+        return true;
+    }
+    if constexpr (std::same_as<CharT, char>) {
+        return find_byte_class(text, 0, LOGFMT_SPECIAL) != text.size();
+    } else {
+        for (auto ch : text) {
+            if (ch <= CharT(' ') || ch == CharT('"') || ch == CharT('\\') ||
+                ch == CharT('=')) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+/**
+ * @brief Quotes `out[start..]` in place when it is empty or contains a byte
+ * that is not allowed in a bare logfmt value.
+ */
+template <typename CharT>
+void quote_logfmt_tail(std::basic_string<CharT>& out, std::size_t start) {
+    if (!logfmt_needs_quotes(std::basic_string_view<CharT>(out).substr(start))) {
+        return;
+    }
+    thread_local std::basic_string<CharT> scratch;
+    scratch.assign(out, start);
+    out.resize(start);
+    out.push_back(CharT('"'));
+    if constexpr (std::same_as<CharT, char>) {
+        std::string_view text(scratch);
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            auto next = find_byte_class(text, pos, JSON_SPECIAL);
+            out.append(text.data() + pos, next - pos);
+            if (next == text.size()) {
+                break;
+            }
+            auto byte = static_cast<unsigned char>(text[next]);
+            if (byte >= 0x80) {
+                // logfmt carries UTF-8 through untouched.
+                out.push_back(text[next]);
+            } else {
+                append_json_escape(out, byte);
+            }
+            pos = next + 1;
+        }
+    } else {
+        append_json_escaped(out, std::basic_string_view<CharT>(scratch));
+    }
+    out.push_back(CharT('"'));
+}
+
+}  // namespace detail
+
+/**
+ * @brief logfmt layout: `level=info target=db msg="..." request_id=42`.
+ *
+ * Values are written bare unless they are empty or contain a space, `=`,
+ * `"`, `\` or a control character; those are quoted with Go-style escapes.
+ * Key-values are formatted directly into the output buffer. Each record is
+ * terminated by a newline.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicLogfmtEncoder : public BasicEncoder<CharT> {
+    void encode(const BasicRecord<CharT>& record,
+                std::basic_string<CharT>& out) const override {
+        detail::append_ascii(out, "level=");
+        detail::append_ascii(out, detail::logfmt_level(record.get_level()));
+        detail::append_ascii(out, " target=");
+        auto start = out.size();
+        out.append(record.get_target());
+        detail::quote_logfmt_tail(out, start);
+
+        detail::append_ascii(out, " msg=");
+        start = out.size();
+        detail::append_message(out, record);
+        detail::quote_logfmt_tail(out, start);
+
+        for (const auto& kv : record.get_kvs()) {
+            out.push_back(CharT(' '));
+            out.append(kv.get_key_str());
+            out.push_back(CharT('='));
+            start = out.size();
+            kv.append_value(out);
+            detail::quote_logfmt_tail(out, start);
+        }
+        out.push_back(CharT('\n'));
+    }
+};
+
+/** @brief UTF-8 logfmt encoder alias. */
+using LogfmtEncoder = BasicLogfmtEncoder<char>;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_LOGFMT_ENCODER_HPP__
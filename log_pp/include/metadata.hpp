@@ -1,8 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <source_location>
 #include <string_view>
 
 #include "level.hpp"
+#include "target_intern.hpp"
 
 #ifndef __LOG_PP_METADATA_HPP__
 #define __LOG_PP_METADATA_HPP__
@@ -26,11 +31,36 @@ template <typename CharT>
 struct BasicMetadata {
     Level level{};
     std::basic_string_view<CharT> target{};
+    std::optional<std::source_location> module{};
+    TargetId target_id = NO_TARGET_ID;
+    LevelFilter level_override = LevelFilter::Off;
 
     /** @brief Returns the log level. @return Log level. */
     Level get_level() const noexcept;
     /** @brief Returns the target/category. @return Target/category text. */
     std::basic_string_view<CharT> get_target() const noexcept;
+    /** @brief Returns the interned target ID. @return ID, or
+     * @ref NO_TARGET_ID when the target was not interned. */
+    TargetId get_target_id() const noexcept;
+    /**
+     * @brief Returns the level the statement was granted by a matching
+     * @ref CallsiteRule, @ref ThreadLevelGuard or @ref SamplingScope.
+     *
+     * Level filters accept records up to this level even when their own
+     * level is lower, so a rule or override reaches every logger.
+     *
+     * @return Granted level, or `Off` when there is none.
+     */
+    LevelFilter get_level_override() const noexcept;
+    /** @brief Returns the callsite's function name when known. @return
+     * Function name or empty. */
+    std::optional<std::string_view> get_module_path() const noexcept;
+    /** @brief Returns the callsite's file path when known. @return File path
+     * or empty. */
+    std::optional<std::string_view> get_file() const noexcept;
+    /** @brief Returns the callsite's line number when known. @return Line
+     * number or empty. */
+    std::optional<uint32_t> get_line() const noexcept;
 };
 
 /**
@@ -55,6 +85,26 @@ struct BasicMetadataBuilder {
      */
     BasicMetadataBuilder& set_target(
         const std::basic_string_view<CharT> target) noexcept;
+    /**
+     * @brief Sets the interned target ID.
+     * @param target_id ID from @ref intern_target.
+     * @return This builder.
+     */
+    BasicMetadataBuilder& set_target_id(const TargetId target_id) noexcept;
+    /**
+     * @brief Sets the level granted past logger-side level filters.
+     * @param level_override Granted level; `Off` for none.
+     * @return This builder.
+     */
+    BasicMetadataBuilder& set_level_override(
+        const LevelFilter level_override) noexcept;
+    /**
+     * @brief Sets the callsite's source location.
+     * @param module Source location.
+     * @return This builder.
+     */
+    BasicMetadataBuilder& set_module(
+        const std::source_location module) noexcept;
 
     /** @brief Returns an immutable metadata snapshot. @return Built metadata
      * value. */
@@ -77,6 +127,56 @@ std::basic_string_view<CharT> BasicMetadata<CharT>::get_target()
     return this->target;
 }
 
+template <typename CharT>
+TargetId BasicMetadata<CharT>::get_target_id() const noexcept {
+    return this->target_id;
+}
+
+template <typename CharT>
+LevelFilter BasicMetadata<CharT>::get_level_override() const noexcept {
+    return this->level_override;
+}
+
+/**
+ * @brief Checks a record level against a filter's own level.
+ *
+ * @param metadata Record metadata.
+ * @param level Filter level.
+ * @return `true` if the record is within `level` or the statement's
+ * granted level.
+ */
+template <typename CharT>
+constexpr bool level_allows(const BasicMetadata<CharT>& metadata,
+                            LevelFilter level) noexcept {
+    return metadata.get_level() <= std::max(level, metadata.level_override);
+}
+
+template <typename CharT>
+std::optional<std::string_view> BasicMetadata<CharT>::get_module_path()
+    const noexcept {
+    if (module.has_value()) {
+        return module->function_name();
+    }
+    return std::nullopt;
+}
+
+template <typename CharT>
+std::optional<std::string_view> BasicMetadata<CharT>::get_file()
+    const noexcept {
+    if (module.has_value()) {
+        return module->file_name();
+    }
+    return std::nullopt;
+}
+
+template <typename CharT>
+std::optional<uint32_t> BasicMetadata<CharT>::get_line() const noexcept {
+    if (module.has_value()) {
+        return module->line();
+    }
+    return std::nullopt;
+}
+
 template <typename CharT>
 BasicMetadataBuilder<CharT>& BasicMetadataBuilder<CharT>::set_level(
     const Level level) noexcept {
@@ -91,6 +191,27 @@ BasicMetadataBuilder<CharT>& BasicMetadataBuilder<CharT>::set_target(
     return *this;
 }
 
+template <typename CharT>
+BasicMetadataBuilder<CharT>& BasicMetadataBuilder<CharT>::set_target_id(
+    const TargetId target_id) noexcept {
+    this->metadata.target_id = target_id;
+    return *this;
+}
+
+template <typename CharT>
+BasicMetadataBuilder<CharT>& BasicMetadataBuilder<CharT>::set_level_override(
+    const LevelFilter level_override) noexcept {
+    this->metadata.level_override = level_override;
+    return *this;
+}
+
+template <typename CharT>
+BasicMetadataBuilder<CharT>& BasicMetadataBuilder<CharT>::set_module(
+    const std::source_location module) noexcept {
+    this->metadata.module = module;
+    return *this;
+}
+
 template <typename CharT>
 BasicMetadata<CharT> BasicMetadataBuilder<CharT>::build() const noexcept {
     return this->metadata;
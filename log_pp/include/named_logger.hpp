@@ -0,0 +1,266 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "log.hpp"
+#include "log_interface.hpp"
+#include "metadata.hpp"
+#include "record.hpp"
+
+#ifndef __LOG_PP_NAMED_LOGGER_HPP__
+#define __LOG_PP_NAMED_LOGGER_HPP__
+
+namespace log_pp {
+
+namespace detail {
+template <typename CharT>
+struct LoggerRegistry;
+}  // namespace detail
+
+/**
+ * @brief Stable handle for a logger name in the named-logger registry.
+ *
+ * Forwards to the logger registered under the longest matching name along
+ * the `::` hierarchy (`"storage::wal"`, then `"storage"`, then `""`), or to
+ * the global logger when none is registered. Handles are never destroyed,
+ * and the registry updates their target in place on every change, so a
+ * cached reference stays correct. Replaced loggers are kept alive, so each
+ * call costs one acquire load and no read-side section. The `LOG_PP_*`
+ * macros resolve the handle once per statement through @ref get_logger, so
+ * its `enabled()` and `log()` calls reach the same logger across a swap.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicNamedLogger : public BasicLogger<CharT> {
+   private:
+    std::basic_string<CharT> name;
+    std::atomic<BasicLogger<CharT>*> resolved{nullptr};
+
+    template <typename>
+    friend struct detail::LoggerRegistry;
+
+   public:
+    explicit BasicNamedLogger(std::basic_string_view<CharT> logger_name)
+        : name(logger_name) {}
+
+    BasicNamedLogger(const BasicNamedLogger&) = delete;
+    BasicNamedLogger& operator=(const BasicNamedLogger&) = delete;
+
+    /** @brief Returns the handle's name. @return Logger name. */
+    std::basic_string_view<CharT> get_name() const noexcept { return name; }
+
+    /**
+     * @brief Returns the logger the handle currently forwards to.
+     *
+     * The reference stays valid after the registration changes.
+     *
+     * @return Registered or global logger.
+     */
+    BasicLogger<CharT>& get_logger() const noexcept {
+        auto* target = resolved.load(std::memory_order_acquire);
+        return target != nullptr ? *target : logger<CharT>();
+    }
+
+    bool enabled(const BasicMetadata<CharT>& metadata) const noexcept override {
+        return get_logger().enabled(metadata);
+    }
+
+    void log(const BasicRecord<CharT>& record) override {
+        get_logger().log(record);
+    }
+
+    void log_batch(std::span<const BasicRecord<CharT>> records) override {
+        get_logger().log_batch(records);
+    }
+
+    void flush() override { get_logger().flush(); }
+};
+
+/** @brief UTF-8 named logger alias. */
+using NamedLogger = BasicNamedLogger<char>;
+
+namespace detail {
+
+/**
+ * @brief Process-wide map from logger names to registered loggers.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct LoggerRegistry {
+   private:
+    using string = std::basic_string<CharT>;
+    using string_view = std::basic_string_view<CharT>;
+
+    std::mutex mutex;
+    std::map<string, std::unique_ptr<BasicNamedLogger<CharT>>, std::less<>>
+        handles;
+    std::map<string, std::shared_ptr<BasicLogger<CharT>>, std::less<>>
+        registered;
+    // Replaced and removed loggers; handles may still be calling them.
+    std::vector<std::shared_ptr<BasicLogger<CharT>>> retired;
+
+    BasicLogger<CharT>* resolve_locked(string_view name) const noexcept {
+        for (;;) {
+            auto it = registered.find(name);
+            if (it != registered.end()) {
+                return it->second.get();
+            }
+            if (name.empty()) {
+                return nullptr;
+            }
+            auto parent = name.rfind(string_view(sep));
+            name = name.substr(0, parent == string_view::npos ? 0 : parent);
+        }
+    }
+
+    void update_locked() noexcept {
+        for (auto& [name, handle] : handles) {
+            handle->resolved.store(resolve_locked(name),
+                                   std::memory_order_release);
+        }
+    }
+
+    static constexpr CharT sep[] = {CharT(':'), CharT(':'), CharT('\0')};
+
+   public:
+    BasicNamedLogger<CharT>& handle(string_view name) {
+        std::lock_guard lock(mutex);
+        auto it = handles.find(name);
+        if (it == handles.end()) {
+            auto next = std::make_unique<BasicNamedLogger<CharT>>(name);
+            next->resolved.store(resolve_locked(name),
+                                 std::memory_order_release);
+            it = handles.emplace(string(name), std::move(next)).first;
+        }
+        return *it->second;
+    }
+
+    void set(string_view name, std::shared_ptr<BasicLogger<CharT>> logger) {
+        std::lock_guard lock(mutex);
+        auto it = registered.find(name);
+        if (it == registered.end()) {
+            registered.emplace(string(name), std::move(logger));
+        } else {
+            retired.push_back(std::exchange(it->second, std::move(logger)));
+        }
+        update_locked();
+    }
+
+    bool erase(string_view name) {
+        std::lock_guard lock(mutex);
+        auto it = registered.find(name);
+        if (it == registered.end()) {
+            return false;
+        }
+        retired.push_back(std::move(it->second));
+        registered.erase(it);
+        update_locked();
+        return true;
+    }
+};
+
+template <typename CharT>
+LoggerRegistry<CharT>& logger_registry() {
+    // Intentionally leaked: cached handles must outlive every callsite.
+    static auto* instance = new LoggerRegistry<CharT>();
+    return *instance;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Registers or replaces the logger for a name.
+ *
+ * Every handle at or below `name` in the `::` hierarchy that has no closer
+ * registration switches to `logger`. A replaced logger is kept alive until
+ * the process exits, since handles may still be calling it.
+ *
+ * Example:
+ * @code
+ * log_pp::register_logger("storage", storage_logger);
+ * log_pp::register_logger("audit", audit_logger);
+ * @endcode
+ *
+ * @tparam CharT Character type.
+ * @param name Logger name; `""` overrides the global logger for all names.
+ * @param logger Logger to share.
+ * @return Nothing.
+ */
+template <typename CharT = char>
+void register_logger(
+    std::type_identity_t<std::basic_string_view<CharT>> name,
+    std::type_identity_t<std::shared_ptr<BasicLogger<CharT>>> logger) {
+    detail::logger_registry<CharT>().set(name, std::move(logger));
+}
+
+/**
+ * @brief Removes the logger registered for a name.
+ *
+ * Handles fall back to the next registered parent name.
+ *
+ * @tparam CharT Character type.
+ * @param name Name passed to @ref register_logger.
+ * @return `true` if a logger was removed.
+ */
+template <typename CharT = char>
+bool unregister_logger(
+    std::type_identity_t<std::basic_string_view<CharT>> name) {
+    return detail::logger_registry<CharT>().erase(name);
+}
+
+/**
+ * @brief Returns the handle for a logger name.
+ *
+ * This takes the registry lock and a map lookup; use @ref LOG_PP_NAMED to do
+ * it once per statement.
+ *
+ * @tparam CharT Character type.
+ * @param name Logger name.
+ * @return Handle valid for the lifetime of the process.
+ */
+template <typename CharT = char>
+BasicNamedLogger<CharT>& named_logger(
+    std::type_identity_t<std::basic_string_view<CharT>> name) {
+    return detail::logger_registry<CharT>().handle(name);
+}
+
+/** @copydoc named_logger */
+template <typename CharT, std::size_t N>
+BasicNamedLogger<CharT>& named_logger(const CharT (&name)[N]) {
+    return named_logger<CharT>(std::basic_string_view<CharT>(name));
+}
+
+}  // namespace log_pp
+
+/**
+ * @brief Named logger resolved once per statement.
+ *
+ * Pass it as the logger argument of the `LOG_PP_*` macros. The handle is
+ * cached in a function-local static, so later calls skip the registry.
+ *
+ * Example:
+ * @code
+ * LOG_PP_INFO(LOG_PP_NAMED("storage::wal"), "flushed {} pages", n);
+ * @endcode
+ *
+ * @param name String literal naming the logger.
+ */
+#define LOG_PP_NAMED(name)                                                \
+    ([]() -> auto& {                                                      \
+        static auto& handle = log_pp::named_logger(name);                 \
+        return handle;                                                    \
+    }())
+
+#endif  // !__LOG_PP_NAMED_LOGGER_HPP__
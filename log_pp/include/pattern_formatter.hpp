@@ -0,0 +1,397 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "encoder.hpp"
+#include "level.hpp"
+#include "record.hpp"
+#include "timestamp_renderer.hpp"
+
+#ifndef __LOG_PP_PATTERN_FORMATTER_HPP__
+#define __LOG_PP_PATTERN_FORMATTER_HPP__
+
+namespace log_pp {
+
+namespace detail {
+
+/** @brief Single step of a compiled pattern. */
+enum class PatternField : uint8_t {
+    Literal,
+    Year,
+    Month,
+    Day,
+    Hour,
+    Minute,
+    Second,
+    Millis,
+    Micros,
+    Nanos,
+    Level,
+    LevelShort,
+    Target,
+    FileName,
+    FilePath,
+    Line,
+    Function,
+    Message,
+    KVs,
+    Timestamp,
+    UtcOffset,
+    ThreadId,
+    ThreadName,
+};
+
+struct PatternOp {
+    PatternField field;
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+constexpr bool is_time_field(PatternField field) noexcept {
+    return field >= PatternField::Year && field <= PatternField::Nanos;
+}
+
+/** @brief Calendar fields of one timestamp, computed once per record. */
+struct PatternTime {
+    int year;
+    unsigned month;
+    unsigned day;
+    int64_t hour;
+    int64_t minute;
+    int64_t second;
+    int64_t nanos;
+
+    static PatternTime from(std::chrono::system_clock::time_point now) {
+        using namespace std::chrono;
+        auto day_start = floor<days>(now);
+        year_month_day ymd{day_start};
+        hh_mm_ss hms{duration_cast<nanoseconds>(now - day_start)};
+        return {static_cast<int>(ymd.year()),
+                static_cast<unsigned>(ymd.month()),
+                static_cast<unsigned>(ymd.day()),
+                hms.hours().count(),
+                hms.minutes().count(),
+                hms.seconds().count(),
+                hms.subseconds().count()};
+    }
+
+    /**
+     * @brief Like @ref from, but reuses the calendar fields of the last
+     * second seen on this thread.
+     */
+    static PatternTime cached(std::chrono::system_clock::time_point now) {
+        thread_local int64_t cached_second =
+            std::numeric_limits<int64_t>::min();
+        thread_local PatternTime cached_time{};
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      now.time_since_epoch())
+                      .count();
+        auto second = floor_div(ns, 1'000'000'000);
+        if (second != cached_second) {
+            cached_time = from(now);
+            cached_second = second;
+        }
+        cached_time.nanos = ns - second * 1'000'000'000;
+        return cached_time;
+    }
+};
+
+constexpr char level_letter(Level level) noexcept {
+    switch (level) {
+        case Level::Error:
+            return 'E';
+        case Level::Warning:
+            return 'W';
+        case Level::Info:
+            return 'I';
+        case Level::Debug:
+            return 'D';
+        case Level::Trace:
+            return 'T';
+        default:
+            return '?';
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Encoder driven by a layout pattern compiled once at construction.
+ *
+ * The pattern is parsed into a flat list of append steps; rendering a record
+ * walks that list and appends straight into the output buffer without
+ * re-parsing the layout or building temporaries. Each record is terminated by
+ * a newline.
+ *
+ * Flags (times are UTC shifted by `TimestampFormat::utc_offset`):
+ * - `%Y` `%m` `%d` `%H` `%M` `%S`: year, month, day, hour, minute, second
+ * - `%e` `%f` `%F`: milli-, micro- and nanoseconds of the second
+ * - `%i`: ISO 8601 timestamp laid out by the @ref TimestampFormat
+ * - `%z`: UTC offset as `Z` or `+hh:mm`
+ * - `%l` level name, `%L` level letter
+ * - `%n` target
+ * - `%t` producing thread id, `%T` producing thread name
+ * - `%s` source file name, `%g` full source path, `%#` line, `%!` function
+ * - `%v` formatted message, `%k` key-values as `key=value` separated by spaces
+ * - `%%` a literal `%`
+ *
+ * Unknown flags are copied through unchanged.
+ *
+ * Example:
+ * @code
+ * auto encoder = std::make_shared<log_pp::PatternFormatter>(
+ *     "%Y-%m-%dT%H:%M:%S.%f %l %n %s:%# %v %k");
+ * log_pp::FileSink sink(encoder, {.path = "app.log"});
+ * @endcode
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicPatternFormatter : public BasicEncoder<CharT> {
+   private:
+    std::basic_string<CharT> literals{};
+    std::vector<detail::PatternOp> ops{};
+    BasicTimestampRenderer<CharT> timestamp;
+    bool needs_time = false;
+    bool needs_calendar = false;
+
+    void push_literal(std::basic_string_view<CharT> text) {
+        if (text.empty()) {
+            return;
+        }
+        if (!ops.empty() && ops.back().field == detail::PatternField::Literal &&
+            ops.back().offset + ops.back().length == literals.size()) {
+            ops.back().length += static_cast<uint32_t>(text.size());
+        } else {
+            ops.push_back({detail::PatternField::Literal,
+                           static_cast<uint32_t>(literals.size()),
+                           static_cast<uint32_t>(text.size())});
+        }
+        literals.append(text);
+    }
+
+    static std::optional<detail::PatternField> field_for(CharT flag) noexcept {
+        using detail::PatternField;
+        switch (flag) {
+            case CharT('Y'):
+                return PatternField::Year;
+            case CharT('m'):
+                return PatternField::Month;
+            case CharT('d'):
+                return PatternField::Day;
+            case CharT('H'):
+                return PatternField::Hour;
+            case CharT('M'):
+                return PatternField::Minute;
+            case CharT('S'):
+                return PatternField::Second;
+            case CharT('e'):
+                return PatternField::Millis;
+            case CharT('f'):
+                return PatternField::Micros;
+            case CharT('F'):
+                return PatternField::Nanos;
+            case CharT('l'):
+                return PatternField::Level;
+            case CharT('L'):
+                return PatternField::LevelShort;
+            case CharT('n'):
+                return PatternField::Target;
+            case CharT('s'):
+                return PatternField::FileName;
+            case CharT('g'):
+                return PatternField::FilePath;
+            case CharT('#'):
+                return PatternField::Line;
+            case CharT('!'):
+                return PatternField::Function;
+            case CharT('v'):
+                return PatternField::Message;
+            case CharT('k'):
+                return PatternField::KVs;
+            case CharT('i'):
+                return PatternField::Timestamp;
+            case CharT('z'):
+                return PatternField::UtcOffset;
+            case CharT('t'):
+                return PatternField::ThreadId;
+            case CharT('T'):
+                return PatternField::ThreadName;
+            default:
+                return std::nullopt;
+        }
+    }
+
+    static void append_file_name(std::basic_string<CharT>& out,
+                                 std::string_view path) {
+        auto slash = path.find_last_of("/\\");
+        detail::append_ascii(out, slash == std::string_view::npos
+                                      ? path
+                                      : path.substr(slash + 1));
+    }
+
+   public:
+    /**
+     * @brief Compiles the layout.
+     *
+     * @param pattern Layout pattern, see the flag list above.
+     * @param timestamp_format UTC offset of all time fields, and layout of
+     * `%i`.
+     */
+    explicit BasicPatternFormatter(std::basic_string_view<CharT> pattern,
+                                   TimestampFormat timestamp_format = {})
+        : timestamp(timestamp_format) {
+
+        std::size_t literal_start = 0;
+        for (std::size_t i = 0; i < pattern.size(); ++i) {
+            if (pattern[i] != CharT('%') || i + 1 == pattern.size()) {
+                continue;
+            }
+            push_literal(pattern.substr(literal_start, i - literal_start));
+            auto flag = pattern[++i];
+            literal_start = i + 1;
+            if (flag == CharT('%')) {
+                push_literal(pattern.substr(i, 1));
+            } else if (auto field = field_for(flag)) {
+                ops.push_back({*field});
+                needs_calendar =
+                    needs_calendar || detail::is_time_field(*field);
+                needs_time = needs_calendar || needs_time ||
+                             *field == detail::PatternField::Timestamp;
+            } else {
+                push_literal(pattern.substr(i - 1, 2));
+            }
+        }
+        push_literal(pattern.substr(literal_start));
+    }
+
+    /** @brief Returns the number of compiled steps. @return Step count. */
+    std::size_t step_count() const noexcept { return ops.size(); }
+
+    void encode(const BasicRecord<CharT>& record,
+                std::basic_string<CharT>& out) const override {
+        using detail::PatternField;
+        std::chrono::system_clock::time_point when{};
+        detail::PatternTime time{};
+        if (needs_time) {
+            when = record.get_timestamp().value_or(
+                std::chrono::system_clock::now());
+        }
+        if (needs_calendar) {
+            time = detail::PatternTime::cached(
+                when + timestamp.get_format().utc_offset);
+        }
+        for (const auto& op : ops) {
+            switch (op.field) {
+                case PatternField::Literal:
+                    out.append(literals, op.offset, op.length);
+                    break;
+                case PatternField::Year:
+                    detail::append_uint(out, static_cast<uint64_t>(time.year),
+                                        4);
+                    break;
+                case PatternField::Month:
+                    detail::append_uint(out, time.month, 2);
+                    break;
+                case PatternField::Day:
+                    detail::append_uint(out, time.day, 2);
+                    break;
+                case PatternField::Hour:
+                    detail::append_uint(out, static_cast<uint64_t>(time.hour),
+                                        2);
+                    break;
+                case PatternField::Minute:
+                    detail::append_uint(
+                        out, static_cast<uint64_t>(time.minute), 2);
+                    break;
+                case PatternField::Second:
+                    detail::append_uint(
+                        out, static_cast<uint64_t>(time.second), 2);
+                    break;
+                case PatternField::Millis:
+                    detail::append_uint(
+                        out, static_cast<uint64_t>(time.nanos / 1000000), 3);
+                    break;
+                case PatternField::Micros:
+                    detail::append_uint(
+                        out, static_cast<uint64_t>(time.nanos / 1000), 6);
+                    break;
+                case PatternField::Nanos:
+                    detail::append_uint(out, static_cast<uint64_t>(time.nanos),
+                                        9);
+                    break;
+                case PatternField::Level:
+                    detail::append_ascii(out, to_str(record.get_level()));
+                    break;
+                case PatternField::LevelShort:
+                    out.push_back(
+                        static_cast<CharT>(detail::level_letter(
+                            record.get_level())));
+                    break;
+                case PatternField::Target:
+                    out.append(record.get_target());
+                    break;
+                case PatternField::FileName:
+                    append_file_name(out, record.get_file().value_or(""));
+                    break;
+                case PatternField::FilePath:
+                    detail::append_ascii(out, record.get_file().value_or(""));
+                    break;
+                case PatternField::Line:
+                    if (auto line = record.get_line()) {
+                        detail::append_uint(out, *line);
+                    }
+                    break;
+                case PatternField::Function:
+                    detail::append_ascii(
+                        out, record.get_module_path().value_or(""));
+                    break;
+                case PatternField::Message:
+                    detail::append_message(out, record);
+                    break;
+                case PatternField::KVs: {
+                    bool first = true;
+                    for (const auto& kv : record.get_kvs()) {
+                        if (!first) {
+                            out.push_back(CharT(' '));
+                        }
+                        first = false;
+                        out.append(kv.get_key_str());
+                        out.push_back(CharT('='));
+                        kv.append_value(out);
+                    }
+                    break;
+                }
+                case PatternField::Timestamp:
+                    timestamp.append(out, when);
+                    break;
+                case PatternField::UtcOffset:
+                    timestamp.append_offset(out);
+                    break;
+                case PatternField::ThreadId:
+                    if (auto id = record.get_thread_id()) {
+                        detail::append_uint(out, *id);
+                    }
+                    break;
+                case PatternField::ThreadName:
+                    detail::append_ascii(
+                        out, record.get_thread_name().value_or(""));
+                    break;
+            }
+        }
+        out.push_back(CharT('\n'));
+    }
+};
+
+/** @brief UTF-8 pattern formatter alias. */
+using PatternFormatter = BasicPatternFormatter<char>;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_PATTERN_FORMATTER_HPP__
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "log_pp_export.h"
+
+#ifndef __LOG_PP_RCU_HPP__
+#define __LOG_PP_RCU_HPP__
+
+namespace log_pp {
+
+namespace rcu {
+
+/**
+ * @brief Enters a read-side critical section on the calling thread.
+ *
+ * Sections may nest. Objects published through @ref RcuPtr and loaded inside a
+ * section stay alive until the outermost section exits.
+ *
+ * @return Nothing.
+ */
+LOG_PP_EXPORT void read_lock() noexcept;
+/**
+ * @brief Leaves a read-side critical section on the calling thread.
+ *
+ * @return Nothing.
+ */
+LOG_PP_EXPORT void read_unlock() noexcept;
+
+/**
+ * @brief Defers destruction of an unpublished object until every reader that
+ * could still observe it has left its critical section.
+ *
+ * Never blocks; pending objects are reclaimed by later calls to `retire()`,
+ * `reclaim()` or `synchronize()`.
+ *
+ * @param ptr Object that is no longer reachable by new readers.
+ * @param deleter Function that destroys `ptr`.
+ * @return Nothing.
+ */
+LOG_PP_EXPORT void retire(void* ptr, void (*deleter)(void*)) noexcept;
+/**
+ * @brief Destroys retired objects whose grace period has already elapsed.
+ *
+ * @return Nothing.
+ */
+LOG_PP_EXPORT void reclaim() noexcept;
+/**
+ * @brief Waits until every retired object has been destroyed.
+ *
+ * Must not be called from inside a read-side critical section.
+ *
+ * @return Nothing.
+ */
+LOG_PP_EXPORT void synchronize() noexcept;
+
+/**
+ * @brief Drops a shared reference once the current grace period has elapsed.
+ *
+ * For objects readers reach through a raw pointer while shared ownership is
+ * kept elsewhere.
+ *
+ * @tparam T Pointee type.
+ * @param ptr Reference to release; the object is destroyed then if it was
+ * the last one.
+ * @return Nothing.
+ */
+template <typename T>
+void retire(std::shared_ptr<T> ptr) noexcept {
+    if (ptr) {
+        retire(new std::shared_ptr<T>(std::move(ptr)), [](void* p) {
+            delete static_cast<std::shared_ptr<T>*>(p);
+        });
+    }
+}
+
+/**
+ * @brief RAII read-side critical section.
+ *
+ * Example:
+ * @code
+ * log_pp::rcu::ReadGuard guard;
+ * auto* state = published.load();
+ * @endcode
+ */
+struct ReadGuard {
+    ReadGuard() noexcept { read_lock(); }
+    ~ReadGuard() noexcept { read_unlock(); }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+};
+
+}  // namespace rcu
+
+/**
+ * @brief Owning pointer whose pointee can be replaced while readers use it.
+ *
+ * Readers call @ref load inside an @ref rcu::ReadGuard and pay a single
+ * acquire load. Writers call @ref store; the previous object is retired and
+ * destroyed once no reader can observe it.
+ *
+ * @tparam T Pointee type.
+ */
+template <typename T>
+struct RcuPtr {
+   private:
+    std::atomic<T*> ptr{nullptr};
+
+    static void destroy(void* p) noexcept { delete static_cast<T*>(p); }
+
+   public:
+    RcuPtr() noexcept = default;
+    explicit RcuPtr(std::unique_ptr<T> initial) noexcept
+        : ptr(initial.release()) {}
+
+    ~RcuPtr() noexcept {
+        rcu::synchronize();
+        delete ptr.load(std::memory_order_acquire);
+    }
+
+    RcuPtr(const RcuPtr&) = delete;
+    RcuPtr& operator=(const RcuPtr&) = delete;
+
+    /**
+     * @brief Returns the current object.
+     *
+     * The result is valid until the caller leaves its read-side section.
+     *
+     * @return Current object or `nullptr`.
+     */
+    T* load() const noexcept { return ptr.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Publishes a new object and retires the previous one.
+     *
+     * @param next Object to publish.
+     * @return Nothing.
+     */
+    void store(std::unique_ptr<T> next) noexcept {
+        T* previous = ptr.exchange(next.release(), std::memory_order_seq_cst);
+        if (previous != nullptr) {
+            rcu::retire(previous, &RcuPtr::destroy);
+        }
+    }
+};
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_RCU_HPP__
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <concepts>
 #include <cstdint>
 #include <format>
@@ -10,9 +11,11 @@
 #include <string_view>
 #include <type_traits>
 
+#include "clock.hpp"
 #include "kv.hpp"
 #include "level.hpp"
 #include "metadata.hpp"
+#include "thread_info.hpp"
 
 #ifndef __LOG_PP_RECORD_HPP__
 #define __LOG_PP_RECORD_HPP__
@@ -79,6 +82,8 @@ struct BasicRecord {
     FormatArgs<CharT> args = make_empty_format_args<CharT>();
     BasicKVList<CharT> kvs{};
     std::optional<std::source_location> module;
+    std::optional<Timestamp> timestamp;
+    std::optional<ThreadInfo> thread;
 
     /** @brief Returns metadata used for filtering/routing. @return Metadata
      * value. */
@@ -96,6 +101,9 @@ struct BasicRecord {
     /** @brief Convenience accessor for metadata target. @return Target/category
      * text. */
     std::basic_string_view<CharT> get_target() const noexcept;
+    /** @brief Convenience accessor for metadata target ID. @return Interned
+     * target ID or @ref NO_TARGET_ID. */
+    TargetId get_target_id() const noexcept;
     /** @brief Returns function name when source location is set. @return
      * Function name or empty. */
     std::optional<std::string_view> get_module_path() const noexcept;
@@ -105,6 +113,19 @@ struct BasicRecord {
     /** @brief Returns line number when source location is set. @return Line
      * number or empty. */
     std::optional<uint32_t> get_line() const noexcept;
+    /** @brief Returns the wall time the record was created at, when
+     * captured. @return Time point or empty. */
+    std::optional<std::chrono::system_clock::time_point> get_timestamp()
+        const noexcept;
+    /** @brief Returns the unconverted clock reading, when captured. @return
+     * Raw timestamp or empty. */
+    std::optional<Timestamp> get_raw_timestamp() const noexcept;
+    /** @brief Returns the producing thread's OS id, when captured. @return
+     * Thread id or empty. */
+    std::optional<uint64_t> get_thread_id() const noexcept;
+    /** @brief Returns the producing thread's name, when captured. @return
+     * Thread name (possibly empty) or empty. */
+    std::optional<std::string_view> get_thread_name() const noexcept;
 };
 
 /**
@@ -131,11 +152,16 @@ struct BasicRecordBuilder {
                   {
                       .level = rhs.metadata.level,
                       .target = rhs.metadata.target,
+                      .module = rhs.metadata.module,
+                      .target_id = rhs.metadata.target_id,
+                      .level_override = rhs.metadata.level_override,
                   },
               .format_string = rhs.format_string,
               .args = rhs.args,
               .kvs = rhs.kvs,
               .module = rhs.module,
+              .timestamp = rhs.timestamp,
+              .thread = rhs.thread,
           }) {}
 
     /**
@@ -159,6 +185,12 @@ struct BasicRecordBuilder {
      */
     BasicRecordBuilder& set_target(
         const std::basic_string_view<CharT> target) noexcept;
+    /**
+     * @brief Sets interned target ID in metadata.
+     * @param target_id ID from @ref intern_target.
+     * @return This builder.
+     */
+    BasicRecordBuilder& set_target_id(const TargetId target_id) noexcept;
     /**
      * @brief Sets message format string.
      * @param format_string Format string text.
@@ -184,6 +216,18 @@ struct BasicRecordBuilder {
      * @return This builder.
      */
     BasicRecordBuilder& set_module(const std::source_location module) noexcept;
+    /**
+     * @brief Sets the creation timestamp.
+     * @param timestamp Raw timestamp, usually from @ref capture_timestamp.
+     * @return This builder.
+     */
+    BasicRecordBuilder& set_timestamp(const Timestamp timestamp) noexcept;
+    /**
+     * @brief Sets the producing thread.
+     * @param thread Thread identity, usually @ref current_thread.
+     * @return This builder.
+     */
+    BasicRecordBuilder& set_thread(const ThreadInfo& thread) noexcept;
 
     /** @brief Returns an immutable record snapshot. @return Built record value.
      */
@@ -226,6 +270,11 @@ std::basic_string_view<CharT> BasicRecord<CharT>::get_target() const noexcept {
     return metadata.target;
 }
 
+template <typename CharT>
+TargetId BasicRecord<CharT>::get_target_id() const noexcept {
+    return metadata.target_id;
+}
+
 template <typename CharT>
 std::optional<std::string_view> BasicRecord<CharT>::get_module_path()
     const noexcept {
@@ -251,6 +300,38 @@ std::optional<uint32_t> BasicRecord<CharT>::get_line() const noexcept {
     return std::nullopt;
 }
 
+template <typename CharT>
+std::optional<std::chrono::system_clock::time_point>
+BasicRecord<CharT>::get_timestamp() const noexcept {
+    if (timestamp.has_value()) {
+        return to_time_point(*timestamp);
+    }
+    return std::nullopt;
+}
+
+template <typename CharT>
+std::optional<Timestamp> BasicRecord<CharT>::get_raw_timestamp()
+    const noexcept {
+    return timestamp;
+}
+
+template <typename CharT>
+std::optional<uint64_t> BasicRecord<CharT>::get_thread_id() const noexcept {
+    if (thread.has_value()) {
+        return thread->id;
+    }
+    return std::nullopt;
+}
+
+template <typename CharT>
+std::optional<std::string_view> BasicRecord<CharT>::get_thread_name()
+    const noexcept {
+    if (thread.has_value()) {
+        return thread->get_name();
+    }
+    return std::nullopt;
+}
+
 template <typename CharT>
 BasicRecordBuilder<CharT>& BasicRecordBuilder<CharT>::set_metadata(
     const BasicMetadata<CharT> metadata) noexcept {
@@ -272,6 +353,13 @@ BasicRecordBuilder<CharT>& BasicRecordBuilder<CharT>::set_target(
     return *this;
 }
 
+template <typename CharT>
+BasicRecordBuilder<CharT>& BasicRecordBuilder<CharT>::set_target_id(
+    const TargetId target_id) noexcept {
+    record.metadata.target_id = target_id;
+    return *this;
+}
+
 template <typename CharT>
 BasicRecordBuilder<CharT>& BasicRecordBuilder<CharT>::set_format_string(
     const std::basic_string_view<CharT> format_string) noexcept {
@@ -296,10 +384,25 @@ BasicRecordBuilder<CharT>& BasicRecordBuilder<CharT>::set_kvs(
 template <typename CharT>
 BasicRecordBuilder<CharT>& BasicRecordBuilder<CharT>::set_module(
     const std::source_location module) noexcept {
+    record.metadata.module = module;
     record.module = module;
     return *this;
 }
 
+template <typename CharT>
+BasicRecordBuilder<CharT>& BasicRecordBuilder<CharT>::set_timestamp(
+    const Timestamp timestamp) noexcept {
+    record.timestamp = timestamp;
+    return *this;
+}
+
+template <typename CharT>
+BasicRecordBuilder<CharT>& BasicRecordBuilder<CharT>::set_thread(
+    const ThreadInfo& thread) noexcept {
+    record.thread = thread;
+    return *this;
+}
+
 template <typename CharT>
 BasicRecord<CharT> BasicRecordBuilder<CharT>::build() const noexcept {
     return record;
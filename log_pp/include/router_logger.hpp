@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "log_interface.hpp"
+#include "metadata.hpp"
+#include "rcu.hpp"
+#include "record.hpp"
+#include "target_intern.hpp"
+#include "target_trie.hpp"
+
+#ifndef __LOG_PP_ROUTER_LOGGER_HPP__
+#define __LOG_PP_ROUTER_LOGGER_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Logger that dispatches records to per-target loggers.
+ *
+ * Route patterns are either exact targets (`"audit"`) or prefixes ending in
+ * `*` (`"db*"` matches `"db"`, `"db::pool"`, ...). An exact route wins over
+ * prefixes, otherwise the longest prefix wins, otherwise the fallback logger
+ * is used. Routes are compiled into a flat byte trie whenever they change, so
+ * dispatch walks a target once, never compares whole strings, and answers
+ * repeats from a per-@ref TargetId cache. Each route
+ * owns its logger, so file sinks keep separate buffers and rotation.
+ *
+ * Example:
+ * @code
+ * auto text = std::make_shared<log_pp::TextEncoder>();
+ * static log_pp::RouterLogger router;
+ * router.add_route("db*", std::make_shared<log_pp::FileSink>(
+ *                             text, log_pp::FileSinkOptions{.path = "db.log"}));
+ * router.add_route("http", http_sink);
+ * router.set_fallback(console_sink);
+ * log_pp::set_logger(router);
+ * @endcode
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicRouterLogger : public BasicLogger<CharT> {
+    using logger_ptr = std::shared_ptr<BasicLogger<CharT>>;
+
+   private:
+    struct Route {
+        std::basic_string<CharT> pattern;
+        logger_ptr logger;
+    };
+
+    struct Table {
+        detail::TargetTrie<CharT> trie{};
+        std::vector<logger_ptr> loggers{};
+        // Route index per target ID; `NO_ROUTE` when nothing matches.
+        detail::TargetIdCache<uint32_t, UINT32_MAX> by_id{};
+
+        static constexpr uint32_t NO_ROUTE = UINT32_MAX - 1;
+
+        BasicLogger<CharT>* lookup(std::basic_string_view<CharT> target,
+                                   TargetId id) const noexcept {
+            auto index = by_id.get(id, [&] {
+                auto found = trie.find(target);
+                return found ? *found : NO_ROUTE;
+            });
+            return index != NO_ROUTE ? loggers[index].get() : nullptr;
+        }
+    };
+
+    std::mutex update_mutex;
+    std::vector<Route> routes{};
+    logger_ptr fallback{};
+    RcuPtr<Table> table{std::make_unique<Table>()};
+
+    void publish_locked() {
+        auto next = std::make_unique<Table>();
+        for (const auto& route : routes) {
+            auto index = static_cast<uint32_t>(next->loggers.size());
+            next->loggers.push_back(route.logger);
+            std::basic_string_view<CharT> pattern = route.pattern;
+            if (!pattern.empty() && pattern.back() == CharT('*')) {
+                pattern.remove_suffix(1);
+                next->trie.insert_prefix(pattern, index);
+            } else {
+                next->trie.insert_exact(pattern, index);
+            }
+        }
+        if (fallback) {
+            auto index = static_cast<uint32_t>(next->loggers.size());
+            next->loggers.push_back(fallback);
+            next->trie.insert_prefix({}, index);
+        }
+        next->trie.compile();
+        table.store(std::move(next));
+    }
+
+   public:
+    BasicRouterLogger() = default;
+
+    /**
+     * @brief Adds or replaces the route for a pattern.
+     *
+     * @param pattern Exact target, or prefix followed by `*`.
+     * @param logger Destination logger.
+     * @return Nothing.
+     */
+    void add_route(std::basic_string_view<CharT> pattern, logger_ptr logger) {
+        std::lock_guard lock(update_mutex);
+        std::erase_if(routes,
+                      [&](const Route& r) { return r.pattern == pattern; });
+        routes.push_back(Route{std::basic_string<CharT>(pattern),
+                               std::move(logger)});
+        publish_locked();
+    }
+
+    /**
+     * @brief Removes the route for a pattern.
+     *
+     * @param pattern Pattern passed to @ref add_route.
+     * @return `true` if a route was removed.
+     */
+    bool remove_route(std::basic_string_view<CharT> pattern) {
+        std::lock_guard lock(update_mutex);
+        auto removed = std::erase_if(
+            routes, [&](const Route& r) { return r.pattern == pattern; });
+        if (removed != 0) {
+            publish_locked();
+        }
+        return removed != 0;
+    }
+
+    /**
+     * @brief Sets the logger used for targets without a route.
+     *
+     * @param logger Fallback logger, or `nullptr` to drop unrouted records.
+     * @return Nothing.
+     */
+    void set_fallback(logger_ptr logger) {
+        std::lock_guard lock(update_mutex);
+        fallback = std::move(logger);
+        publish_locked();
+    }
+
+    bool enabled(const BasicMetadata<CharT>& metadata) const noexcept override {
+        rcu::ReadGuard guard;
+        auto* logger = table.load()->lookup(metadata.get_target(),
+                                             metadata.get_target_id());
+        return logger != nullptr && logger->enabled(metadata);
+    }
+
+    void log(const BasicRecord<CharT>& record) override {
+        rcu::ReadGuard guard;
+        auto* logger = table.load()->lookup(record.get_target(),
+                                             record.get_target_id());
+        if (logger != nullptr && logger->enabled(record.get_metadata())) {
+            logger->log(record);
+        }
+    }
+
+    /**
+     * @brief Splits the batch by route and forwards each run in one call.
+     * @param records Records to emit, in order.
+     * @return Nothing.
+     */
+    void log_batch(std::span<const BasicRecord<CharT>> records) override {
+        rcu::ReadGuard guard;
+        const auto* current = table.load();
+        detail::log_batch_runs<CharT>(
+            records, [&](const BasicRecord<CharT>& record) {
+                return current->lookup(record.get_target(),
+                                       record.get_target_id());
+            });
+    }
+
+    void flush() override {
+        rcu::ReadGuard guard;
+        for (const auto& logger : table.load()->loggers) {
+            logger->flush();
+        }
+    }
+};
+
+/** @brief UTF-8 router logger alias. */
+using RouterLogger = BasicRouterLogger<char>;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_ROUTER_LOGGER_HPP__
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "level.hpp"
+#include "log.hpp"
+
+#ifndef __LOG_PP_SAMPLING_HPP__
+#define __LOG_PP_SAMPLING_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Hashes a request or trace id for @ref sample_key.
+ *
+ * FNV-1a, so every process makes the same decision for the same id.
+ *
+ * @param id Request or trace id.
+ * @return 64-bit hash.
+ */
+constexpr uint64_t sampling_hash(std::string_view id) noexcept {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (char ch : id) {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Decides whether a request is sampled.
+ *
+ * The key is mixed before comparing it against `rate`, so sequential ids
+ * are sampled evenly.
+ *
+ * @param key Request key, e.g. from @ref sampling_hash.
+ * @param rate Fraction of keys to sample, from `0.0` to `1.0`.
+ * @return `true` if the key falls inside `rate`.
+ */
+constexpr bool sample_key(uint64_t key, double rate) noexcept {
+    if (!(rate > 0.0)) {
+        return false;
+    }
+    if (rate >= 1.0) {
+        return true;
+    }
+    // splitmix64 finalizer.
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+    key ^= key >> 31;
+    return static_cast<double>(key >> 11) < rate * 9007199254740992.0;
+}
+
+/**
+ * @brief Enables verbose levels on this thread for sampled requests.
+ *
+ * The decision is made once, when the scope is created. A sampled request
+ * gets a @ref set_thread_level_floor at `level` for the lifetime of the
+ * scope, so every statement it logs is kept, including by
+ * `DirectiveFilter` and sink levels. The floor only raises verbosity: the
+ * thread keeps following the live `max_level()` wherever that is more
+ * verbose. Other requests keep `max_level()` and their verbose statements
+ * are dropped by the inline filter.
+ *
+ * Example:
+ * @code
+ * void handle(const Request& req) {
+ *     log_pp::SamplingScope sampling(req.trace_id, 0.01);
+ *     LOG_PP_DEBUG("parsed {} headers", req.headers.size());
+ * }
+ * @endcode
+ */
+struct SamplingScope {
+   private:
+    std::optional<LevelFilter> previous{};
+
+   public:
+    /**
+     * @param key Request key, e.g. from @ref sampling_hash.
+     * @param rate Fraction of requests to sample.
+     * @param level Least verbose level allowed for sampled requests.
+     */
+    SamplingScope(uint64_t key,
+                  double rate,
+                  LevelFilter level = LevelFilter::Debug) noexcept {
+        if (sample_key(key, rate)) {
+            previous = thread_level_floor();
+            set_thread_level_floor(std::max(level, *previous));
+        }
+    }
+
+    /**
+     * @param id Request or trace id.
+     * @param rate Fraction of requests to sample.
+     * @param level Least verbose level allowed for sampled requests.
+     */
+    SamplingScope(std::string_view id,
+                  double rate,
+                  LevelFilter level = LevelFilter::Debug) noexcept
+        : SamplingScope(sampling_hash(id), rate, level) {}
+
+    ~SamplingScope() noexcept {
+        if (previous) {
+            set_thread_level_floor(*previous);
+        }
+    }
+
+    SamplingScope(const SamplingScope&) = delete;
+    SamplingScope& operator=(const SamplingScope&) = delete;
+
+    /** @brief Returns whether this request is sampled. @return Decision. */
+    bool sampled() const noexcept { return previous.has_value(); }
+};
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_SAMPLING_HPP__
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "encoder.hpp"
+#include "log_pp_export.h"
+#include "sink.hpp"
+
+#ifndef __LOG_PP_SHM_RING_HPP__
+#define __LOG_PP_SHM_RING_HPP__
+
+namespace log_pp {
+
+namespace detail {
+
+/**
+ * @brief Control block at the start of a shared-memory ring segment.
+ *
+ * Data follows at `sizeof(ShmRingHeader)`. Every record starts on an 8-byte
+ * boundary with a 32-bit word holding the payload length and the
+ * `SHM_RECORD_*` flags, followed by 4 reserved bytes and the payload. A
+ * record is visible to the reader once its word has the committed flag.
+ */
+struct alignas(64) ShmRingHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t capacity;
+    alignas(64) std::atomic<uint64_t> write_pos;
+    alignas(64) std::atomic<uint64_t> read_pos;
+    alignas(64) std::atomic<uint64_t> dropped;
+};
+
+inline constexpr uint64_t SHM_RING_MAGIC = 0x474E495250504F4CULL;  // LOPPRING
+inline constexpr uint32_t SHM_RING_VERSION = 1;
+inline constexpr uint32_t SHM_RECORD_COMMITTED = 1u << 31;
+inline constexpr uint32_t SHM_RECORD_PADDING = 1u << 30;
+inline constexpr uint32_t SHM_RECORD_LENGTH_MASK = SHM_RECORD_PADDING - 1;
+inline constexpr std::size_t SHM_RECORD_HEADER_SIZE = 8;
+
+/** @brief POSIX shared-memory mapping owned by a ring endpoint. */
+struct LOG_PP_EXPORT ShmMapping {
+    std::string name{};
+    int fd = -1;
+    std::byte* base = nullptr;
+    std::size_t size = 0;
+    bool unlink_on_close = false;
+
+    ShmMapping() = default;
+    ~ShmMapping();
+    ShmMapping(const ShmMapping&) = delete;
+    ShmMapping& operator=(const ShmMapping&) = delete;
+
+    ShmRingHeader* header() const noexcept {
+        return reinterpret_cast<ShmRingHeader*>(base);
+    }
+    std::byte* data() const noexcept { return base + sizeof(ShmRingHeader); }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Options for @ref ShmRingWriter and @ref ShmRingSink.
+ */
+struct ShmRingOptions {
+    /** @brief POSIX shared-memory object name, e.g. `"/log_pp_ring"`. */
+    std::string name{};
+    /** @brief Data bytes; rounded up to a power of two (at least 4 KiB). */
+    std::size_t capacity = 4 * 1024 * 1024;
+    /** @brief Removes the segment name when the writer is destroyed. */
+    bool unlink_on_close = true;
+};
+
+/**
+ * @brief Multi-producer publishing end of a shared-memory record ring.
+ *
+ * Producers reserve space with a CAS on the write cursor, copy the payload in
+ * place and then commit the record header, so threads of one process (or
+ * several processes mapping the same segment) can publish concurrently.
+ * `publish` never blocks: when the consumer falls behind the record is
+ * dropped and counted.
+ */
+struct LOG_PP_EXPORT ShmRingWriter {
+   private:
+    detail::ShmMapping mapping;
+
+   public:
+    /**
+     * @brief Creates (or truncates) the segment named in `options`.
+     * @param options Segment name, capacity and lifetime.
+     */
+    explicit ShmRingWriter(const ShmRingOptions& options);
+
+    /** @brief Returns whether the segment is mapped. @return Open state. */
+    bool is_open() const noexcept { return mapping.base != nullptr; }
+    /** @brief Returns the data capacity. @return Capacity in bytes. */
+    std::size_t capacity() const noexcept;
+    /** @brief Returns records dropped on a full ring. @return Count. */
+    uint64_t dropped_count() const noexcept;
+
+    /**
+     * @brief Copies one record into the ring.
+     * @param bytes Record payload.
+     * @return `true` if the record was committed, `false` if dropped.
+     */
+    bool publish(std::string_view bytes) noexcept;
+};
+
+/**
+ * @brief Single-consumer reading end of a shared-memory record ring.
+ *
+ * Records are exposed in place inside the mapping; the view returned by
+ * @ref peek stays valid until @ref pop.
+ *
+ * Example:
+ * @code
+ * log_pp::ShmRingReader reader("/log_pp_ring");
+ * reader.drain([](std::string_view record) { ship(record); });
+ * @endcode
+ */
+struct LOG_PP_EXPORT ShmRingReader {
+   private:
+    detail::ShmMapping mapping;
+    uint64_t position = 0;
+    std::size_t current_size = 0;
+
+   public:
+    /**
+     * @brief Maps an existing segment created by a writer.
+     * @param name Segment name.
+     */
+    explicit ShmRingReader(const std::string& name);
+
+    /** @brief Returns whether the segment is mapped. @return Open state. */
+    bool is_open() const noexcept { return mapping.base != nullptr; }
+    /** @brief Returns records dropped by writers. @return Count. */
+    uint64_t dropped_count() const noexcept;
+
+    /**
+     * @brief Returns the next committed record without copying it.
+     * @return Record payload, or empty when no record is ready.
+     */
+    std::optional<std::string_view> peek() noexcept;
+    /**
+     * @brief Releases the record returned by the last @ref peek.
+     * @return Nothing.
+     */
+    void pop() noexcept;
+
+    /**
+     * @brief Hands every ready record to `handler` and releases it.
+     *
+     * @param handler Callable taking `std::string_view`.
+     * @return Number of records consumed.
+     */
+    template <typename F>
+    std::size_t drain(F&& handler) {
+        std::size_t count = 0;
+        while (auto record = peek()) {
+            handler(*record);
+            pop();
+            ++count;
+        }
+        return count;
+    }
+};
+
+/**
+ * @brief Sink that publishes encoded records into a shared-memory ring.
+ *
+ * A sidecar process maps the same segment with @ref ShmRingReader and reads
+ * records in place, skipping the write-to-disk and read-back round trip.
+ *
+ * Only available on POSIX systems.
+ */
+struct LOG_PP_EXPORT ShmRingSink : public Sink {
+   private:
+    ShmRingWriter ring;
+
+   public:
+    /**
+     * @brief Creates the ring segment.
+     * @param encoder Encoder used to render records.
+     * @param options Segment options.
+     */
+    ShmRingSink(std::shared_ptr<const Encoder> encoder,
+                const ShmRingOptions& options);
+
+    /** @brief Returns the underlying ring. @return Ring writer. */
+    ShmRingWriter& get_ring() noexcept { return ring; }
+
+    void log(const Record& record) override;
+    /**
+     * @brief Publishes every record as its own ring entry.
+     * @param records Records to publish.
+     * @return Nothing.
+     */
+    void log_batch(std::span<const Record> records) override;
+    void write(std::string_view bytes) override;
+    /**
+     * @brief Publishes each record as its own entry; the shared batch buffer
+     * has no record boundaries.
+     * @param records Records the buffer was encoded from.
+     * @param buffer Unused.
+     * @return Nothing.
+     */
+    void write_batch_shared(std::span<const Record> records,
+                            const SharedBuffer& buffer) override;
+    void flush() override {}
+};
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_SHM_RING_HPP__
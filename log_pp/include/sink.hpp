@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "encoder.hpp"
+#include "level.hpp"
+#include "log_interface.hpp"
+#include "metadata.hpp"
+#include "record.hpp"
+
+#ifndef __LOG_PP_SINK_HPP__
+#define __LOG_PP_SINK_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Logger that writes the output of an @ref BasicEncoder.
+ *
+ * Concrete sinks only implement @ref write and @ref flush. Composite loggers
+ * such as @ref BasicTeeLogger encode once per encoder and hand the same
+ * buffer to every sink through @ref write_shared, or through
+ * @ref write_batch_shared for a batch. A batch passed to @ref log_batch is
+ * encoded into one buffer and written with a single @ref write.
+ *
+ * Example:
+ * @code
+ * struct StdoutSink : log_pp::Sink {
+ *   StdoutSink() : log_pp::Sink(std::make_shared<log_pp::TextEncoder>()) {}
+ *   void write(std::string_view bytes) override { std::cout << bytes; }
+ *   void flush() override { std::cout.flush(); }
+ * };
+ * @endcode
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicSink : public BasicLogger<CharT> {
+   private:
+    std::shared_ptr<const BasicEncoder<CharT>> encoder;
+    std::atomic<LevelFilter> level{LevelFilter::Trace};
+
+   public:
+    /**
+     * @brief Creates a sink using the given encoder.
+     *
+     * @param in_encoder Encoder used to render records; may be shared.
+     */
+    explicit BasicSink(std::shared_ptr<const BasicEncoder<CharT>> in_encoder)
+        : encoder(std::move(in_encoder)) {}
+
+    /** @brief Returns the encoder. @return Encoder shared by this sink. */
+    const std::shared_ptr<const BasicEncoder<CharT>>& get_encoder()
+        const noexcept {
+        return encoder;
+    }
+
+    /**
+     * @brief Sets the most verbose level this sink accepts.
+     * @param filter Sink level filter.
+     * @return Nothing.
+     */
+    void set_level(LevelFilter filter) noexcept {
+        level.store(filter, std::memory_order_relaxed);
+    }
+    /** @brief Returns the sink level filter. @return Sink level filter. */
+    LevelFilter get_level() const noexcept {
+        return level.load(std::memory_order_relaxed);
+    }
+
+    bool enabled(const BasicMetadata<CharT>& metadata) const noexcept override {
+        return level_allows(metadata, get_level());
+    }
+
+    void log(const BasicRecord<CharT>& record) override {
+        std::basic_string<CharT> out;
+        encoder->encode(record, out);
+        write(out);
+    }
+
+    void log_batch(std::span<const BasicRecord<CharT>> records) override {
+        std::basic_string<CharT> out;
+        for (const auto& record : records) {
+            encoder->encode(record, out);
+        }
+        if (!out.empty()) {
+            write(out);
+        }
+    }
+
+    /**
+     * @brief Writes already encoded bytes.
+     *
+     * Must be safe to call concurrently.
+     *
+     * @param bytes Encoded output of one or more records.
+     * @return Nothing.
+     */
+    virtual void write(std::basic_string_view<CharT> bytes) = 0;
+
+    /**
+     * @brief Writes an encoded buffer that is shared with other sinks.
+     *
+     * Override to retain the buffer instead of copying it, or to use record
+     * metadata when framing the output.
+     *
+     * @param record Record the buffer was encoded from.
+     * @param buffer Immutable encoded output.
+     * @return Nothing.
+     */
+    virtual void write_shared(const BasicRecord<CharT>& record,
+                              const BasicSharedBuffer<CharT>& buffer) {
+        (void)record;
+        write(*buffer);
+    }
+
+    /**
+     * @brief Writes a batch encoded once and shared with other sinks.
+     *
+     * `buffer` holds the output of every record in `records`, in order.
+     * Sinks that need one write per record, such as message-oriented
+     * transports, override it and handle `records` themselves.
+     *
+     * @param records Records the buffer was encoded from.
+     * @param buffer Immutable encoded output of the whole batch.
+     * @return Nothing.
+     */
+    virtual void write_batch_shared(
+        std::span<const BasicRecord<CharT>> records,
+        const BasicSharedBuffer<CharT>& buffer) {
+        (void)records;
+        write(*buffer);
+    }
+};
+
+/** @brief UTF-8 sink alias. */
+using Sink = BasicSink<char>;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_SINK_HPP__
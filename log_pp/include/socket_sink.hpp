@@ -0,0 +1,212 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "encoder.hpp"
+#include "log_pp_export.h"
+#include "sink.hpp"
+
+#ifndef __LOG_PP_SOCKET_SINK_HPP__
+#define __LOG_PP_SOCKET_SINK_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Transport used by @ref SocketSink.
+ */
+enum class SocketKind {
+    /** @brief `AF_UNIX` stream socket; `address` is a filesystem path. */
+    UnixStream,
+    /** @brief `AF_UNIX` datagram socket; one frame per datagram. */
+    UnixDatagram,
+    /** @brief TCP connection to `address:port`. */
+    Tcp,
+};
+
+/**
+ * @brief Wire framing used by @ref SocketSink.
+ */
+enum class SocketFraming {
+    /**
+     * @brief RFC 5424 syslog message. Stream transports use RFC 6587
+     * octet-counting (`"<len> <msg>"`).
+     */
+    Syslog,
+    /** @brief 4-byte big-endian payload length followed by the payload. */
+    LengthPrefixed,
+};
+
+/**
+ * @brief Options for @ref SocketSink.
+ */
+struct SocketSinkOptions {
+    SocketKind kind = SocketKind::UnixStream;
+    /** @brief Unix socket path or TCP host. */
+    std::string address{};
+    /** @brief TCP port; ignored for Unix sockets. */
+    uint16_t port = 0;
+    SocketFraming framing = SocketFraming::Syslog;
+    /** @brief Syslog facility (0-23); 1 is `user`. */
+    int facility = 1;
+    /** @brief Syslog APP-NAME field. */
+    std::string app_name = "log_pp";
+    /** @brief Syslog HOSTNAME field; empty uses the local host name. */
+    std::string hostname{};
+    /**
+     * @brief Largest frame sent on a datagram socket; larger frames are
+     * dropped (and counted) when logged.
+     */
+    std::size_t max_datagram = 64 * 1024;
+    /** @brief Frames sent per gathering send call at most. */
+    std::size_t max_batch = 64;
+    /** @brief Maximum delay before queued frames are sent. */
+    std::chrono::milliseconds flush_interval{50};
+    /** @brief Bytes kept while the peer is unavailable; oldest are dropped. */
+    std::size_t spill_capacity = 4 * 1024 * 1024;
+    /** @brief First reconnect delay; doubles on every failure. */
+    std::chrono::milliseconds reconnect_min{100};
+    /** @brief Upper bound of the reconnect delay. */
+    std::chrono::milliseconds reconnect_max{10000};
+    /**
+     * @brief Longest time @ref SocketSink::flush, and the destructor, wait for
+     * the peer. The destructor keeps reconnecting until then; frames still
+     * queued when it gives up are dropped.
+     */
+    std::chrono::milliseconds flush_timeout{1000};
+};
+
+/**
+ * @brief Forwards framed records to a local collector over a socket.
+ *
+ * Producers only frame the record and append it to a bounded in-memory queue;
+ * a background thread sends queued frames in batches with one gathering
+ * `sendmsg` (stream sockets, `writev` semantics without `SIGPIPE`) or
+ * `sendmmsg` (datagram sockets) on a non-blocking descriptor. When
+ * the peer is unavailable frames are kept up to `spill_capacity` bytes and
+ * the connection is retried with exponential backoff.
+ *
+ * Only available on POSIX systems.
+ *
+ * Example:
+ * @code
+ * auto sink = std::make_shared<log_pp::SocketSink>(
+ *     std::make_shared<log_pp::TextEncoder>(),
+ *     log_pp::SocketSinkOptions{.kind = log_pp::SocketKind::UnixStream,
+ *                               .address = "/run/collector.sock"});
+ * @endcode
+ */
+struct LOG_PP_EXPORT SocketSink : public Sink {
+   private:
+    SocketSinkOptions options;
+    std::string hostname;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::deque<std::string> queue{};
+    std::size_t queued_bytes = 0;
+    std::size_t dropped = 0;
+    std::size_t in_flight = 0;
+    bool flush_requested = false;
+    bool stopping = false;
+    std::chrono::steady_clock::time_point stop_deadline{};
+
+    // Owned by the worker thread.
+    int fd = -1;
+    std::chrono::milliseconds backoff{};
+    std::chrono::steady_clock::time_point next_connect{};
+
+    std::thread worker;
+
+    void run();
+    bool ensure_connected();
+    void disconnect();
+    bool send_stream(std::deque<std::string>& batch);
+    bool send_datagrams(std::deque<std::string>& batch, std::size_t& failed);
+    void requeue_front_locked(std::deque<std::string>& batch);
+    void drop_queue_locked() noexcept;
+    void enqueue_locked(std::string frame);
+    void enqueue(std::string frame);
+
+   public:
+    /**
+     * @brief Starts the background sender.
+     *
+     * The first connection attempt happens asynchronously.
+     *
+     * @param encoder Encoder used to render the frame payload.
+     * @param in_options Transport, framing and buffering options.
+     */
+    SocketSink(std::shared_ptr<const Encoder> encoder,
+               SocketSinkOptions in_options);
+    ~SocketSink() override;
+
+    SocketSink(const SocketSink&) = delete;
+    SocketSink& operator=(const SocketSink&) = delete;
+
+    /**
+     * @brief Frames one record for the configured transport.
+     *
+     * @param record Record the payload was encoded from.
+     * @param payload Encoded record.
+     * @param out Buffer the frame is appended to.
+     * @return Nothing.
+     */
+    void frame(const Record& record,
+               std::string_view payload,
+               std::string& out) const;
+
+    void log(const Record& record) override;
+    /**
+     * @brief Frames every record and queues the batch under one lock.
+     * @param records Records to send.
+     * @return Nothing.
+     */
+    void log_batch(std::span<const Record> records) override;
+    /**
+     * @brief Frames bytes that carry no record metadata (sent as `INFO`).
+     * @param bytes Encoded record.
+     * @return Nothing.
+     */
+    void write(std::string_view bytes) override;
+    void write_shared(const Record& record,
+                      const SharedBuffer& buffer) override;
+    /**
+     * @brief Frames each record on its own; the shared batch buffer has no
+     * record boundaries.
+     * @param records Records the buffer was encoded from.
+     * @param buffer Unused.
+     * @return Nothing.
+     */
+    void write_batch_shared(std::span<const Record> records,
+                            const SharedBuffer& buffer) override;
+
+    /**
+     * @brief Waits until queued frames are sent or `flush_timeout` elapses.
+     * @return Nothing.
+     */
+    void flush() override;
+
+    /**
+     * @brief Returns frames dropped due to the spill limit, the datagram
+     * limit, a send the peer rejected, or shutdown.
+     * @return Count.
+     */
+    std::size_t dropped_count() noexcept;
+    /** @brief Returns frames waiting to be sent. @return Count. */
+    std::size_t pending_count() noexcept;
+};
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_SOCKET_SINK_HPP__
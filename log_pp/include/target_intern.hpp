@@ -0,0 +1,243 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#ifndef __LOG_PP_TARGET_INTERN_HPP__
+#define __LOG_PP_TARGET_INTERN_HPP__
+
+namespace log_pp {
+
+/** @brief Small integer naming an interned target. */
+using TargetId = uint32_t;
+/** @brief Marks a target that has not been (or could not be) interned. */
+inline constexpr TargetId NO_TARGET_ID = UINT32_MAX;
+/** @brief Number of distinct targets the interner hands out IDs for. */
+inline constexpr std::size_t MAX_TARGET_IDS = 4096;
+
+namespace detail {
+
+/**
+ * @brief Process-wide, append-only map from target text to @ref TargetId.
+ *
+ * IDs are dense (`0, 1, 2, ...` in first-seen order, with `""` always `0`),
+ * so consumers can index flat arrays with them. Lookups probe a fixed
+ * open-addressing table with acquire loads and never lock; only the first
+ * sighting of a target takes the mutex. Targets past @ref MAX_TARGET_IDS are
+ * not interned, which bounds memory when targets are built at runtime.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct TargetInterner {
+   private:
+    using string_view = std::basic_string_view<CharT>;
+
+    static constexpr std::size_t SLOTS = 2 * MAX_TARGET_IDS;
+
+    // Each slot packs the upper 32 hash bits with `id + 1`; 0 is empty.
+    std::array<std::atomic<uint64_t>, SLOTS> slots{};
+    std::array<string_view, MAX_TARGET_IDS> names{};
+    std::atomic<std::size_t> count{0};
+    std::mutex insert_mutex;
+    std::deque<std::basic_string<CharT>> storage;
+
+    static uint64_t hash(string_view text) noexcept {
+        // Spread the bits so both halves of the hash are usable.
+        return static_cast<uint64_t>(std::hash<string_view>{}(text)) *
+               0x9E3779B97F4A7C15ull;
+    }
+
+    // Returns the slot holding `text`, or the empty slot it would go in.
+    std::size_t probe(string_view text,
+                      uint64_t h,
+                      TargetId& id) const noexcept {
+        auto tag = h >> 32;
+        for (auto i = static_cast<std::size_t>(h) & (SLOTS - 1);;
+             i = (i + 1) & (SLOTS - 1)) {
+            auto slot = slots[i].load(std::memory_order_acquire);
+            if (slot == 0) {
+                id = NO_TARGET_ID;
+                return i;
+            }
+            auto candidate = static_cast<TargetId>(slot & 0xFFFFFFFFu) - 1;
+            if ((slot >> 32) == tag && names[candidate] == text) {
+                id = candidate;
+                return i;
+            }
+        }
+    }
+
+   public:
+    TargetInterner() { intern({}); }
+
+    /**
+     * @brief Looks up a target without interning it.
+     * @param text Target text.
+     * @return ID, or @ref NO_TARGET_ID when `text` was never interned.
+     */
+    TargetId find(string_view text) const noexcept {
+        TargetId id;
+        probe(text, hash(text), id);
+        return id;
+    }
+
+    /**
+     * @brief Returns the ID of a target, assigning the next one if new.
+     * @param text Target text.
+     * @return ID, or @ref NO_TARGET_ID when the interner is full.
+     */
+    TargetId intern(string_view text) {
+        auto h = hash(text);
+        TargetId id;
+        probe(text, h, id);
+        // Once full, unseen targets must not serialize every logging thread
+        // on the insert mutex.
+        if (id != NO_TARGET_ID ||
+            count.load(std::memory_order_acquire) == MAX_TARGET_IDS) {
+            return id;
+        }
+        std::lock_guard lock(insert_mutex);
+        auto slot = probe(text, h, id);
+        auto next = count.load(std::memory_order_relaxed);
+        if (id != NO_TARGET_ID || next == MAX_TARGET_IDS) {
+            return id;
+        }
+        names[next] = storage.emplace_back(text);
+        count.store(next + 1, std::memory_order_release);
+        slots[slot].store(((h >> 32) << 32) | (next + 1),
+                          std::memory_order_release);
+        return static_cast<TargetId>(next);
+    }
+
+    /**
+     * @brief Returns the text of an interned target.
+     * @param id Target ID.
+     * @return Target text, or empty when `id` was never handed out.
+     */
+    std::optional<string_view> name(TargetId id) const noexcept {
+        if (id >= count.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        return names[id];
+    }
+
+    /** @brief Returns the number of interned targets. @return Count. */
+    std::size_t size() const noexcept {
+        return count.load(std::memory_order_acquire);
+    }
+};
+
+/**
+ * @brief Lazily filled array memoizing a per-target result by @ref TargetId.
+ *
+ * Lets filters and routers answer repeat lookups with one relaxed load
+ * instead of walking the target text. Lookups for @ref NO_TARGET_ID always
+ * recompute.
+ *
+ * @tparam T Lock-free value type.
+ * @tparam Unset Value marking an empty entry; never a valid result.
+ */
+template <typename T, T Unset>
+struct TargetIdCache {
+   private:
+    std::unique_ptr<std::atomic<T>[]> entries{
+        new std::atomic<T>[MAX_TARGET_IDS]};
+
+   public:
+    TargetIdCache() {
+        for (std::size_t i = 0; i < MAX_TARGET_IDS; ++i) {
+            entries[i].store(Unset, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Returns the memoized value for `id`, computing it on a miss.
+     * @param id Target ID.
+     * @param compute Callable returning the value for the target.
+     * @return Cached or computed value.
+     */
+    template <typename F>
+    T get(TargetId id, F&& compute) const {
+        if (id >= MAX_TARGET_IDS) {
+            return compute();
+        }
+        auto value = entries[id].load(std::memory_order_relaxed);
+        if (value == Unset) {
+            value = compute();
+            entries[id].store(value, std::memory_order_relaxed);
+        }
+        return value;
+    }
+};
+
+template <typename CharT>
+TargetInterner<CharT>& target_interner() {
+    // Intentionally leaked so records logged during static destruction can
+    // still resolve their targets.
+    static auto* instance = new TargetInterner<CharT>();
+    return *instance;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Returns the process-wide ID of a target, interning it if new.
+ *
+ * `LOG_PP_*` statements intern their target and expose the ID as
+ * `Metadata::get_target_id()` / `Record::get_target_id()`; `LOG_PP_TARGET`
+ * targets are interned once per statement.
+ *
+ * Example:
+ * @code
+ * static const auto db = log_pp::intern_target(std::string_view("db"));
+ * if (metadata.get_target_id() == db) { ... }
+ * @endcode
+ *
+ * @tparam CharT Character type.
+ * @param target Target text.
+ * @return Dense ID, or @ref NO_TARGET_ID once @ref MAX_TARGET_IDS distinct
+ * targets have been interned.
+ */
+template <typename CharT>
+TargetId intern_target(std::basic_string_view<CharT> target) {
+    return detail::target_interner<CharT>().intern(target);
+}
+
+/**
+ * @brief Returns the text of an interned target.
+ *
+ * @tparam CharT Character type.
+ * @param id Target ID from @ref intern_target.
+ * @return Target text, or empty for an unknown ID.
+ */
+template <typename CharT = char>
+std::optional<std::basic_string_view<CharT>> target_name(TargetId id) {
+    return detail::target_interner<CharT>().name(id);
+}
+
+/**
+ * @brief Returns the number of interned targets.
+ *
+ * IDs are below this count, so it sizes arrays indexed by @ref TargetId.
+ *
+ * @tparam CharT Character type.
+ * @return Number of interned targets (at least 1, for `""`).
+ */
+template <typename CharT = char>
+std::size_t interned_target_count() {
+    return detail::target_interner<CharT>().size();
+}
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_TARGET_INTERN_HPP__
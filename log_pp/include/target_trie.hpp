@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#ifndef __LOG_PP_TARGET_TRIE_HPP__
+#define __LOG_PP_TARGET_TRIE_HPP__
+
+namespace log_pp::detail {
+
+/**
+ * @brief Byte-wise trie mapping target patterns to small integer values.
+ *
+ * Patterns are inserted at configuration time as either exact targets or
+ * prefixes. @ref compile flattens the trie into two contiguous arrays, after
+ * which @ref find walks the target once without comparing whole strings.
+ * An exact match wins over any prefix; otherwise the longest prefix wins.
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct TargetTrie {
+   private:
+    static constexpr uint32_t NO_VALUE = UINT32_MAX;
+
+    struct BuildNode {
+        std::vector<std::pair<CharT, uint32_t>> children{};
+        uint32_t exact = NO_VALUE;
+        uint32_t prefix = NO_VALUE;
+    };
+
+    struct Node {
+        uint32_t first_edge = 0;
+        uint32_t edge_count = 0;
+        uint32_t exact = NO_VALUE;
+        uint32_t prefix = NO_VALUE;
+    };
+
+    struct Edge {
+        CharT ch;
+        uint32_t child;
+    };
+
+    std::vector<BuildNode> building{BuildNode{}};
+    std::vector<Node> nodes{Node{}};
+    std::vector<Edge> edges{};
+
+    uint32_t walk_or_insert(std::basic_string_view<CharT> pattern) {
+        uint32_t node = 0;
+        for (CharT ch : pattern) {
+            auto& children = building[node].children;
+            auto it = std::find_if(children.begin(), children.end(),
+                                   [ch](const auto& c) { return c.first == ch; });
+            if (it != children.end()) {
+                node = it->second;
+                continue;
+            }
+            auto next = static_cast<uint32_t>(building.size());
+            children.emplace_back(ch, next);
+            building.emplace_back();
+            node = next;
+        }
+        return node;
+    }
+
+   public:
+    /**
+     * @brief Maps an exact target to `value`. Later insertions overwrite.
+     * @param pattern Exact target text.
+     * @param value Value returned by @ref find.
+     * @return Nothing.
+     */
+    void insert_exact(std::basic_string_view<CharT> pattern, uint32_t value) {
+        building[walk_or_insert(pattern)].exact = value;
+    }
+
+    /**
+     * @brief Maps every target starting with `pattern` to `value`.
+     * @param pattern Target prefix.
+     * @param value Value returned by @ref find.
+     * @return Nothing.
+     */
+    void insert_prefix(std::basic_string_view<CharT> pattern, uint32_t value) {
+        building[walk_or_insert(pattern)].prefix = value;
+    }
+
+    /**
+     * @brief Flattens inserted patterns into the lookup arrays.
+     * @return Nothing.
+     */
+    void compile() {
+        nodes.assign(building.size(), Node{});
+        edges.clear();
+        for (std::size_t i = 0; i < building.size(); ++i) {
+            auto children = building[i].children;
+            std::sort(children.begin(), children.end());
+            nodes[i].first_edge = static_cast<uint32_t>(edges.size());
+            nodes[i].edge_count = static_cast<uint32_t>(children.size());
+            nodes[i].exact = building[i].exact;
+            nodes[i].prefix = building[i].prefix;
+            for (const auto& [ch, child] : children) {
+                edges.push_back(Edge{ch, child});
+            }
+        }
+    }
+
+    /**
+     * @brief Looks up the value for a target.
+     * @param target Target text.
+     * @return Exact or longest-prefix value, or empty when nothing matches.
+     */
+    std::optional<uint32_t> find(
+        std::basic_string_view<CharT> target) const noexcept {
+        uint32_t node = 0;
+        uint32_t best = nodes[0].prefix;
+        for (CharT ch : target) {
+            const auto& current = nodes[node];
+            const auto* first = edges.data() + current.first_edge;
+            const auto* last = first + current.edge_count;
+            const auto* edge = std::lower_bound(
+                first, last, ch,
+                [](const Edge& e, CharT c) { return e.ch < c; });
+            if (edge == last || edge->ch != ch) {
+                return best == NO_VALUE ? std::nullopt
+                                        : std::optional<uint32_t>(best);
+            }
+            node = edge->child;
+            if (nodes[node].prefix != NO_VALUE) {
+                best = nodes[node].prefix;
+            }
+        }
+        if (nodes[node].exact != NO_VALUE) {
+            return nodes[node].exact;
+        }
+        return best == NO_VALUE ? std::nullopt : std::optional<uint32_t>(best);
+    }
+};
+
+}  // namespace log_pp::detail
+
+#endif  // !__LOG_PP_TARGET_TRIE_HPP__
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "encoder.hpp"
+#include "log_interface.hpp"
+#include "metadata.hpp"
+#include "rcu.hpp"
+#include "record.hpp"
+#include "sink.hpp"
+
+#ifndef __LOG_PP_TEE_LOGGER_HPP__
+#define __LOG_PP_TEE_LOGGER_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Fan-out logger that encodes each record once per distinct encoder.
+ *
+ * Sinks holding the same encoder instance receive the same immutable
+ * reference-counted buffer. Sinks can be added and removed while other threads
+ * log; the sink list is published through @ref RcuPtr so `log()` never takes a
+ * lock.
+ *
+ * Example:
+ * @code
+ * auto text = std::make_shared<log_pp::TextEncoder>();
+ * static log_pp::TeeLogger tee;
+ * tee.add_sink(std::make_shared<FileSink>(text, "app.log"));
+ * tee.add_sink(std::make_shared<SocketSink>(text, "/run/agent.sock"));
+ * log_pp::set_logger(tee);
+ * @endcode
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicTeeLogger : public BasicLogger<CharT> {
+    using sink_ptr = std::shared_ptr<BasicSink<CharT>>;
+
+   private:
+    struct Group {
+        std::shared_ptr<const BasicEncoder<CharT>> encoder;
+        std::vector<sink_ptr> sinks;
+    };
+
+    struct State {
+        std::vector<Group> groups;
+    };
+
+    std::mutex update_mutex;
+    RcuPtr<State> state{std::make_unique<State>()};
+
+   public:
+    BasicTeeLogger() = default;
+
+    /**
+     * @brief Adds a sink.
+     *
+     * Sinks sharing an encoder instance are grouped and share encoded output.
+     *
+     * @param sink Sink to add.
+     * @return Nothing.
+     */
+    void add_sink(sink_ptr sink) {
+        std::lock_guard lock(update_mutex);
+        auto next = std::make_unique<State>(*state.load());
+        auto group = std::find_if(next->groups.begin(), next->groups.end(),
+                                  [&](const Group& g) {
+                                      return g.encoder == sink->get_encoder();
+                                  });
+        if (group == next->groups.end()) {
+            next->groups.push_back(Group{sink->get_encoder(), {}});
+            group = std::prev(next->groups.end());
+        }
+        group->sinks.push_back(std::move(sink));
+        state.store(std::move(next));
+    }
+
+    /**
+     * @brief Removes a sink.
+     *
+     * In-flight `log()` calls may still write to the sink once more.
+     *
+     * @param sink Sink to remove.
+     * @return `true` if the sink was attached.
+     */
+    bool remove_sink(const BasicSink<CharT>* sink) {
+        std::lock_guard lock(update_mutex);
+        auto next = std::make_unique<State>(*state.load());
+        bool removed = false;
+        for (auto& group : next->groups) {
+            auto it = std::find_if(
+                group.sinks.begin(), group.sinks.end(),
+                [&](const sink_ptr& s) { return s.get() == sink; });
+            if (it != group.sinks.end()) {
+                group.sinks.erase(it);
+                removed = true;
+            }
+        }
+        std::erase_if(next->groups,
+                      [](const Group& g) { return g.sinks.empty(); });
+        if (removed) {
+            state.store(std::move(next));
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Replaces every sink in one step.
+     *
+     * Readers see either the old or the new list, never a mix, so sinks kept
+     * across the call miss no records.
+     *
+     * @param sinks New sinks, grouped by encoder instance.
+     * @return Nothing.
+     */
+    void set_sinks(std::vector<sink_ptr> sinks) {
+        auto next = std::make_unique<State>();
+        for (auto& sink : sinks) {
+            auto group = std::find_if(
+                next->groups.begin(), next->groups.end(),
+                [&](const Group& g) {
+                    return g.encoder == sink->get_encoder();
+                });
+            if (group == next->groups.end()) {
+                next->groups.push_back(Group{sink->get_encoder(), {}});
+                group = std::prev(next->groups.end());
+            }
+            group->sinks.push_back(std::move(sink));
+        }
+        std::lock_guard lock(update_mutex);
+        state.store(std::move(next));
+    }
+
+    /** @brief Returns the number of attached sinks. @return Sink count. */
+    std::size_t sink_count() const noexcept {
+        rcu::ReadGuard guard;
+        std::size_t count = 0;
+        for (const auto& group : state.load()->groups) {
+            count += group.sinks.size();
+        }
+        return count;
+    }
+
+    /** @brief Returns the number of distinct encoders. @return Group count. */
+    std::size_t encoder_count() const noexcept {
+        rcu::ReadGuard guard;
+        return state.load()->groups.size();
+    }
+
+    bool enabled(const BasicMetadata<CharT>& metadata) const noexcept override {
+        rcu::ReadGuard guard;
+        for (const auto& group : state.load()->groups) {
+            for (const auto& sink : group.sinks) {
+                if (sink->enabled(metadata)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void log(const BasicRecord<CharT>& record) override {
+        rcu::ReadGuard guard;
+        const auto metadata = record.get_metadata();
+        for (const auto& group : state.load()->groups) {
+            BasicSharedBuffer<CharT> buffer;
+            for (const auto& sink : group.sinks) {
+                if (!sink->enabled(metadata)) {
+                    continue;
+                }
+                if (!buffer) {
+                    auto out = std::make_shared<std::basic_string<CharT>>();
+                    group.encoder->encode(record, *out);
+                    buffer = std::move(out);
+                }
+                sink->write_shared(record, buffer);
+            }
+        }
+    }
+
+    /**
+     * @brief Encodes the batch once per encoder and writes it with one call.
+     *
+     * Sinks that accept every record share one buffer for the whole batch;
+     * a sink whose level rejects some records gets the runs it accepts
+     * through its own @ref BasicSink::log_batch.
+     *
+     * @param records Records to emit, in order.
+     * @return Nothing.
+     */
+    void log_batch(std::span<const BasicRecord<CharT>> records) override {
+        rcu::ReadGuard guard;
+        for (const auto& group : state.load()->groups) {
+            BasicSharedBuffer<CharT> buffer;
+            for (const auto& sink : group.sinks) {
+                bool accepts_all = std::all_of(
+                    records.begin(), records.end(), [&](const auto& record) {
+                        return sink->enabled(record.get_metadata());
+                    });
+                if (!accepts_all) {
+                    detail::log_batch_runs<CharT>(
+                        records,
+                        [&](const BasicRecord<CharT>&) { return sink.get(); });
+                    continue;
+                }
+                if (records.empty()) {
+                    continue;
+                }
+                if (!buffer) {
+                    auto out = std::make_shared<std::basic_string<CharT>>();
+                    for (const auto& record : records) {
+                        group.encoder->encode(record, *out);
+                    }
+                    buffer = std::move(out);
+                }
+                sink->write_batch_shared(records, buffer);
+            }
+        }
+    }
+
+    void flush() override {
+        rcu::ReadGuard guard;
+        for (const auto& group : state.load()->groups) {
+            for (const auto& sink : group.sinks) {
+                sink->flush();
+            }
+        }
+    }
+};
+
+/** @brief UTF-8 tee logger alias. */
+using TeeLogger = BasicTeeLogger<char>;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_TEE_LOGGER_HPP__
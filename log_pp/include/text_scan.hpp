@@ -0,0 +1,189 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LOG_PP_TEXT_SCAN_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define LOG_PP_TEXT_SCAN_NEON 1
+#endif
+
+#ifndef __LOG_PP_TEXT_SCAN_HPP__
+#define __LOG_PP_TEXT_SCAN_HPP__
+
+namespace log_pp {
+
+namespace detail {
+
+/**
+ * @brief Set of bytes an encoder has to look at before copying text through.
+ *
+ * A byte belongs to the class if it is below `below`, equals one of `a`, `b`
+ * or `c`, or (when `high` is set) is a non-ASCII byte.
+ */
+struct ByteClass {
+    unsigned char below;
+    char a;
+    char b;
+    char c;
+    bool high;
+
+    constexpr bool contains(unsigned char byte) const noexcept {
+        return byte < below || byte == static_cast<unsigned char>(a) ||
+               byte == static_cast<unsigned char>(b) ||
+               byte == static_cast<unsigned char>(c) || (high && byte >= 0x80);
+    }
+};
+
+/** @brief Bytes that need escaping or UTF-8 validation in a JSON string. */
+inline constexpr ByteClass JSON_SPECIAL{0x20, '"', '\\', '"', true};
+/** @brief Bytes that force a logfmt value to be quoted (space included). */
+inline constexpr ByteClass LOGFMT_SPECIAL{0x21, '"', '\\', '=', false};
+/** @brief Braces that start or end a `std::format` replacement field. */
+inline constexpr ByteClass FORMAT_BRACES{0x00, '{', '}', '{', false};
+
+/**
+ * @brief Scalar reference implementation of @ref find_byte_class.
+ * @return Index of the first matching byte at or after `pos`, or
+ * `text.size()`.
+ */
+inline std::size_t find_byte_class_scalar(std::string_view text,
+                                          std::size_t pos,
+                                          const ByteClass& cls) noexcept {
+    for (; pos < text.size(); ++pos) {
+        if (cls.contains(static_cast<unsigned char>(text[pos]))) {
+            return pos;
+        }
+    }
+    return text.size();
+}
+
+/**
+ * @brief Finds the first byte of `cls` at or after `pos`, 16 bytes at a time.
+ *
+ * Uses SSE2 on x86 and NEON on ARM, the scalar loop elsewhere and for the
+ * tail.
+ *
+ * @return Index of the first matching byte, or `text.size()`.
+ */
+inline std::size_t find_byte_class(std::string_view text,
+                                   std::size_t pos,
+                                   const ByteClass& cls) noexcept {
+    const auto* data = reinterpret_cast<const unsigned char*>(text.data());
+    const std::size_t size = text.size();
+#if defined(LOG_PP_TEXT_SCAN_SSE2)
+    // Bias by 0x80 so an unsigned `byte < below` becomes a signed compare.
+    const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+    const __m128i below = _mm_set1_epi8(static_cast<char>(cls.below ^ 0x80));
+    const __m128i a = _mm_set1_epi8(cls.a);
+    const __m128i b = _mm_set1_epi8(cls.b);
+    const __m128i c = _mm_set1_epi8(cls.c);
+    const __m128i zero = _mm_setzero_si128();
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, a), _mm_cmpeq_epi8(v, b)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, c),
+                         _mm_cmplt_epi8(_mm_xor_si128(v, bias), below)));
+        if (cls.high) {
+            hits = _mm_or_si128(hits, _mm_cmplt_epi8(v, zero));
+        }
+        auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return pos + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+#elif defined(LOG_PP_TEXT_SCAN_NEON)
+    const uint8x16_t below = vdupq_n_u8(cls.below);
+    const uint8x16_t a = vdupq_n_u8(static_cast<uint8_t>(cls.a));
+    const uint8x16_t b = vdupq_n_u8(static_cast<uint8_t>(cls.b));
+    const uint8x16_t c = vdupq_n_u8(static_cast<uint8_t>(cls.c));
+    const uint8x16_t high = vdupq_n_u8(cls.high ? 0xFF : 0x00);
+    const uint8x16_t ascii_end = vdupq_n_u8(0x80);
+    for (; pos + 16 <= size; pos += 16) {
+        uint8x16_t v = vld1q_u8(data + pos);
+        uint8x16_t hits =
+            vorrq_u8(vorrq_u8(vceqq_u8(v, a), vceqq_u8(v, b)),
+                     vorrq_u8(vceqq_u8(v, c), vcltq_u8(v, below)));
+        hits = vorrq_u8(hits, vandq_u8(high, vcgeq_u8(v, ascii_end)));
+        // Narrow every byte lane to a nibble to get a 64-bit hit mask.
+        uint64_t mask = vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)),
+            0);
+        if (mask != 0) {
+            return pos + static_cast<std::size_t>(std::countr_zero(mask) / 4);
+        }
+    }
+#endif
+    (void)data;
+    return find_byte_class_scalar(text, pos, cls);
+}
+
+/** @brief Result of @ref check_utf8. */
+struct Utf8Check {
+    /** @brief Bytes to consume. */
+    std::size_t length;
+    /** @brief Whether those bytes form a well-formed sequence. */
+    bool valid;
+};
+
+/**
+ * @brief Checks the UTF-8 sequence starting at `pos`.
+ *
+ * Rejects overlong forms, surrogates and code points above U+10FFFF. For an
+ * ill-formed sequence `length` covers its maximal valid prefix (at least one
+ * byte), so callers emit one U+FFFD per broken sequence as Unicode
+ * recommends.
+ *
+ * @return Sequence length and validity.
+ */
+inline Utf8Check check_utf8(std::string_view text, std::size_t pos) noexcept {
+    auto byte = [&](std::size_t i) -> unsigned {
+        return static_cast<unsigned char>(text[i]);
+    };
+    auto lead = byte(pos);
+    if (lead < 0x80) {
+        return {1, true};
+    }
+    std::size_t length = 0;
+    unsigned min_second = 0x80;
+    unsigned max_second = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        min_second = lead == 0xE0 ? 0xA0 : 0x80;
+        max_second = lead == 0xED ? 0x9F : 0xBF;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        min_second = lead == 0xF0 ? 0x90 : 0x80;
+        max_second = lead == 0xF4 ? 0x8F : 0xBF;
+    } else {
+        return {1, false};
+    }
+    for (std::size_t i = 1; i < length; ++i) {
+        if (pos + i >= text.size()) {
+            return {i, false};
+        }
+        auto next = byte(pos + i);
+        bool ok = i == 1 ? next >= min_second && next <= max_second
+                         : (next & 0xC0) == 0x80;
+        if (!ok) {
+            return {i, false};
+        }
+    }
+    return {length, true};
+}
+
+}  // namespace detail
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_TEXT_SCAN_HPP__
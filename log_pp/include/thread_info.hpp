@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "log_pp_export.h"
+
+#ifndef __LOG_PP_THREAD_INFO_HPP__
+#define __LOG_PP_THREAD_INFO_HPP__
+
+namespace log_pp {
+
+/**
+ * @brief Identity of the thread that produced a record.
+ *
+ * Stored inline (no allocation) and copied into each record, so it stays
+ * correct when the record is rendered on another thread.
+ */
+struct ThreadInfo {
+    /** @brief Longest thread name kept, in bytes (the Linux limit). */
+    static constexpr std::size_t NAME_CAPACITY = 15;
+
+    /** @brief OS thread id (`gettid()` on Linux). */
+    uint64_t id = 0;
+    char name[NAME_CAPACITY + 1]{};
+    uint8_t name_length = 0;
+
+    /** @brief Returns the thread name. @return Name, may be empty. */
+    std::string_view get_name() const noexcept {
+        return std::string_view(name, name_length);
+    }
+};
+
+/**
+ * @brief Returns the calling thread's identity.
+ *
+ * The id and the OS thread name are read once per thread and cached in a
+ * thread-local; later calls only return a reference to it.
+ *
+ * @return Identity of the calling thread.
+ */
+LOG_PP_EXPORT const ThreadInfo& current_thread() noexcept;
+
+/**
+ * @brief Sets the name recorded for the calling thread.
+ *
+ * Names longer than @ref ThreadInfo::NAME_CAPACITY bytes are truncated. Only
+ * the library's copy changes; the OS thread name is left alone.
+ *
+ * Example:
+ * @code
+ * log_pp::set_thread_name("io-worker");
+ * @endcode
+ *
+ * @param name New thread name.
+ * @return Nothing.
+ */
+LOG_PP_EXPORT void set_thread_name(std::string_view name) noexcept;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_THREAD_INFO_HPP__
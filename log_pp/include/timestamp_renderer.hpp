@@ -0,0 +1,219 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "encoder.hpp"
+#include "record.hpp"
+
+#ifndef __LOG_PP_TIMESTAMP_RENDERER_HPP__
+#define __LOG_PP_TIMESTAMP_RENDERER_HPP__
+
+namespace log_pp {
+
+/** @brief Sub-second digits written by @ref BasicTimestampRenderer. */
+enum class TimestampPrecision : uint8_t {
+    Seconds,
+    Millis,
+    Micros,
+    Nanos,
+};
+
+/** @brief Layout options of @ref BasicTimestampRenderer. */
+struct TimestampFormat {
+    /** @brief Digits after the seconds. */
+    TimestampPrecision precision = TimestampPrecision::Micros;
+    /** @brief Fixed offset from UTC the wall time is shifted by. */
+    std::chrono::minutes utc_offset{0};
+    /** @brief Character between the date and the time (`'T'` or `' '`). */
+    char separator = 'T';
+    /** @brief Appends `Z` (UTC) or `+hh:mm` / `-hh:mm`. */
+    bool show_offset = true;
+};
+
+namespace detail {
+
+/** @brief Rendered `YYYY-MM-DDTHH:MM:SS` of the last second seen. */
+template <typename CharT>
+struct TimestampPrefixCache {
+    static constexpr std::size_t SIZE = 19;
+
+    int64_t minute = std::numeric_limits<int64_t>::min();
+    int64_t second = std::numeric_limits<int64_t>::min();
+    CharT separator{};
+    CharT text[SIZE]{};
+};
+
+template <typename CharT>
+void put_digits(CharT* out, uint64_t value, std::size_t width) noexcept {
+    for (std::size_t i = width; i > 0; --i) {
+        out[i - 1] = static_cast<CharT>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+constexpr int64_t floor_div(int64_t value, int64_t divisor) noexcept {
+    auto quotient = value / divisor;
+    return quotient * divisor > value ? quotient - 1 : quotient;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Renders ISO 8601 timestamps such as `2026-10-16T12:34:56.123456Z`.
+ *
+ * The date and time are converted from the calendar at most once per minute
+ * on each thread; within a minute only the seconds, and within a second only
+ * the sub-second digits, are written per call. The renderer itself is
+ * immutable, so one instance may be shared by sinks on any thread.
+ *
+ * Example:
+ * @code
+ * log_pp::TimestampRenderer ts({.utc_offset = std::chrono::hours(9)});
+ * ts.append(out, record);  // 2026-10-16T21:34:56.123456+09:00
+ * @endcode
+ *
+ * @tparam CharT Character type.
+ */
+template <typename CharT>
+struct BasicTimestampRenderer {
+   private:
+    TimestampFormat format;
+    int64_t offset_ns;
+    CharT offset[6]{};
+    std::size_t offset_length = 0;
+
+    void render_prefix(detail::TimestampPrefixCache<CharT>& cache,
+                       int64_t minute) const {
+        using namespace std::chrono;
+        auto day = detail::floor_div(minute, 24 * 60);
+        year_month_day ymd{sys_days(days(day))};
+        auto minute_of_day = static_cast<uint64_t>(minute - day * 24 * 60);
+        auto* text = cache.text;
+        detail::put_digits(text, static_cast<uint64_t>(
+                                     static_cast<int>(ymd.year())), 4);
+        text[4] = CharT('-');
+        detail::put_digits(text + 5, static_cast<unsigned>(ymd.month()), 2);
+        text[7] = CharT('-');
+        detail::put_digits(text + 8, static_cast<unsigned>(ymd.day()), 2);
+        text[10] = static_cast<CharT>(format.separator);
+        detail::put_digits(text + 11, minute_of_day / 60, 2);
+        text[13] = CharT(':');
+        detail::put_digits(text + 14, minute_of_day % 60, 2);
+        text[16] = CharT(':');
+        cache.minute = minute;
+        cache.separator = static_cast<CharT>(format.separator);
+    }
+
+   public:
+    /**
+     * @brief Creates a renderer.
+     *
+     * @param in_format Precision, UTC offset and separator.
+     */
+    explicit BasicTimestampRenderer(TimestampFormat in_format = {})
+        : format(in_format),
+          offset_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        in_format.utc_offset)
+                        .count()) {
+        auto minutes = format.utc_offset.count();
+        if (minutes == 0) {
+            offset[offset_length++] = CharT('Z');
+            return;
+        }
+        offset[0] = minutes < 0 ? CharT('-') : CharT('+');
+        auto magnitude = static_cast<uint64_t>(minutes < 0 ? -minutes
+                                                           : minutes);
+        detail::put_digits(offset + 1, magnitude / 60 % 100, 2);
+        offset[3] = CharT(':');
+        detail::put_digits(offset + 4, magnitude % 60, 2);
+        offset_length = 6;
+    }
+
+    /** @brief Returns the layout options. @return Format. */
+    const TimestampFormat& get_format() const noexcept { return format; }
+
+    /**
+     * @brief Appends the UTC offset as `Z` or `+hh:mm` / `-hh:mm`.
+     * @param out Output buffer.
+     * @return Nothing.
+     */
+    void append_offset(std::basic_string<CharT>& out) const {
+        out.append(offset, offset_length);
+    }
+
+    /**
+     * @brief Appends `time` to `out`.
+     *
+     * @param out Output buffer.
+     * @param time Time point to render.
+     * @return Nothing.
+     */
+    void append(std::basic_string<CharT>& out,
+                std::chrono::system_clock::time_point time) const {
+        thread_local detail::TimestampPrefixCache<CharT> cache;
+
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      time.time_since_epoch())
+                      .count() +
+                  offset_ns;
+        auto second = detail::floor_div(ns, 1'000'000'000);
+        if (second != cache.second ||
+            cache.separator != static_cast<CharT>(format.separator)) {
+            auto minute = detail::floor_div(second, 60);
+            if (minute != cache.minute ||
+                cache.separator != static_cast<CharT>(format.separator)) {
+                render_prefix(cache, minute);
+            }
+            detail::put_digits(cache.text + 17,
+                               static_cast<uint64_t>(second - minute * 60), 2);
+            cache.second = second;
+        }
+        out.append(cache.text, detail::TimestampPrefixCache<CharT>::SIZE);
+
+        auto nanos = static_cast<uint64_t>(ns - second * 1'000'000'000);
+        switch (format.precision) {
+            case TimestampPrecision::Seconds:
+                break;
+            case TimestampPrecision::Millis:
+                out.push_back(CharT('.'));
+                detail::append_uint(out, nanos / 1'000'000, 3);
+                break;
+            case TimestampPrecision::Micros:
+                out.push_back(CharT('.'));
+                detail::append_uint(out, nanos / 1'000, 6);
+                break;
+            case TimestampPrecision::Nanos:
+                out.push_back(CharT('.'));
+                detail::append_uint(out, nanos, 9);
+                break;
+        }
+        if (format.show_offset) {
+            append_offset(out);
+        }
+    }
+
+    /**
+     * @brief Appends the record's timestamp, or the current time when the
+     * record has none.
+     *
+     * @param out Output buffer.
+     * @param record Record whose timestamp is rendered.
+     * @return Nothing.
+     */
+    void append(std::basic_string<CharT>& out,
+                const BasicRecord<CharT>& record) const {
+        append(out, record.get_timestamp().value_or(
+                        std::chrono::system_clock::now()));
+    }
+};
+
+/** @brief UTF-8 timestamp renderer alias. */
+using TimestampRenderer = BasicTimestampRenderer<char>;
+
+}  // namespace log_pp
+
+#endif  // !__LOG_PP_TIMESTAMP_RENDERER_HPP__
@@ -0,0 +1,334 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "block_compress.hpp"
+
+namespace {
+
+// LZ4 block format limits: matches are at least 4 bytes, the last 5 bytes are
+// always literals and the last match starts at least 12 bytes before the end.
+constexpr std::size_t MIN_MATCH = 4;
+constexpr std::size_t LAST_LITERALS = 5;
+constexpr std::size_t MATCH_FIND_LIMIT = 12;
+constexpr std::size_t MAX_OFFSET = 65535;
+constexpr int HASH_BITS = 12;
+constexpr uint32_t STORED_FLAG = 1u << 31;
+
+using byte = unsigned char;
+
+uint32_t read32(const byte* p) noexcept {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t read64(const byte* p) noexcept {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t hash4(uint32_t sequence) noexcept {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Counts equal bytes at `a` and `b`, stopping at `limit` (bounds `a` only;
+// `b` is always behind `a`).
+std::size_t common_length(const byte* a,
+                          const byte* b,
+                          const byte* limit) noexcept {
+    const byte* start = a;
+    if constexpr (std::endian::native == std::endian::little) {
+        while (a + 8 <= limit) {
+            uint64_t diff = read64(a) ^ read64(b);
+            if (diff != 0) {
+                return static_cast<std::size_t>(a - start) +
+                       static_cast<std::size_t>(std::countr_zero(diff) / 8);
+            }
+            a += 8;
+            b += 8;
+        }
+    }
+    while (a < limit && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return static_cast<std::size_t>(a - start);
+}
+
+// Writes the extra length bytes for a nibble that saturated at 15.
+byte* write_length(byte* op, std::size_t length) noexcept {
+    for (length -= 15; length >= 255; length -= 255) {
+        *op++ = 255;
+    }
+    *op++ = static_cast<byte>(length);
+    return op;
+}
+
+byte* write_literals(byte* op,
+                     byte* token,
+                     const byte* literals,
+                     std::size_t length) noexcept {
+    *token = static_cast<byte>(std::min<std::size_t>(length, 15) << 4);
+    if (length >= 15) {
+        op = write_length(op, length);
+    }
+    std::memcpy(op, literals, length);
+    return op + length;
+}
+
+byte* write_sequence(byte* op,
+                     const byte* literals,
+                     std::size_t literal_length,
+                     std::size_t offset,
+                     std::size_t match_length) noexcept {
+    byte* token = op++;
+    op = write_literals(op, token, literals, literal_length);
+    *op++ = static_cast<byte>(offset);
+    *op++ = static_cast<byte>(offset >> 8);
+    match_length -= MIN_MATCH;
+    *token |= static_cast<byte>(std::min<std::size_t>(match_length, 15));
+    if (match_length >= 15) {
+        op = write_length(op, match_length);
+    }
+    return op;
+}
+
+// Copies `size` bytes 8 at a time; may write up to 7 bytes past the end, so
+// callers check for that much slack. Forward-overlapping copies are fine
+// when `dst - src >= 8`.
+void wild_copy(byte* dst, const byte* src, std::size_t size) noexcept {
+    for (std::size_t i = 0; i < size; i += 8) {
+        std::memcpy(dst + i, src + i, 8);
+    }
+}
+
+bool read_length(const byte*& ip, const byte* end, std::size_t& length) {
+    byte extra;
+    do {
+        if (ip == end) {
+            return false;
+        }
+        extra = *ip++;
+        length += extra;
+    } while (extra == 255);
+    return true;
+}
+
+void put_le32(char* out, uint32_t value) noexcept {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+uint32_t get_le32(const char* in) noexcept {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= uint32_t{static_cast<byte>(in[i])} << (8 * i);
+    }
+    return value;
+}
+
+}  // namespace
+
+namespace log_pp {
+
+std::size_t lz_compress(std::string_view input, char* dst) noexcept {
+    const auto* src = reinterpret_cast<const byte*>(input.data());
+    const std::size_t size = input.size();
+    auto* op = reinterpret_cast<byte*>(dst);
+    std::size_t anchor = 0;
+
+    if (size > MATCH_FIND_LIMIT) {
+        thread_local uint32_t table[1 << HASH_BITS];
+        std::fill(std::begin(table), std::end(table), 0u);
+        const std::size_t match_limit = size - MATCH_FIND_LIMIT;
+        const byte* match_end = src + size - LAST_LITERALS;
+
+        std::size_t ip = 1;
+        while (ip < match_limit) {
+            uint32_t sequence = read32(src + ip);
+            uint32_t& slot = table[hash4(sequence)];
+            std::size_t match = slot;
+            slot = static_cast<uint32_t>(ip);
+            if (ip - match > MAX_OFFSET || read32(src + match) != sequence) {
+                // Skip ahead faster the longer nothing has matched.
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+            while (ip > anchor && match > 0 && src[ip - 1] == src[match - 1]) {
+                --ip;
+                --match;
+            }
+            std::size_t length =
+                MIN_MATCH + common_length(src + ip + MIN_MATCH,
+                                          src + match + MIN_MATCH, match_end);
+            op = write_sequence(op, src + anchor, ip - anchor, ip - match,
+                                length);
+            ip += length;
+            anchor = ip;
+            if (ip < match_limit) {
+                table[hash4(read32(src + ip - 2))] =
+                    static_cast<uint32_t>(ip - 2);
+            }
+        }
+    }
+
+    byte* token = op++;
+    op = write_literals(op, token, src + anchor, size - anchor);
+    return static_cast<std::size_t>(op - reinterpret_cast<byte*>(dst));
+}
+
+std::optional<std::size_t> lz_decompress(std::string_view input,
+                                         char* dst,
+                                         std::size_t capacity) noexcept {
+    const auto* ip = reinterpret_cast<const byte*>(input.data());
+    const auto* end = ip + input.size();
+    auto* const out = reinterpret_cast<byte*>(dst);
+    auto* op = out;
+    auto* const out_end = out + capacity;
+
+    while (true) {
+        if (ip == end) {
+            return std::nullopt;
+        }
+        byte token = *ip++;
+        std::size_t literal_length = token >> 4;
+        if (literal_length == 15 && !read_length(ip, end, literal_length)) {
+            return std::nullopt;
+        }
+        if (literal_length > static_cast<std::size_t>(end - ip) ||
+            literal_length > static_cast<std::size_t>(out_end - op)) {
+            return std::nullopt;
+        }
+        if (static_cast<std::size_t>(end - ip) >= literal_length + 8 &&
+            static_cast<std::size_t>(out_end - op) >= literal_length + 8) {
+            wild_copy(op, ip, literal_length);
+            op += literal_length;
+        } else {
+            op = std::copy_n(ip, literal_length, op);
+        }
+        ip += literal_length;
+        if (ip == end) {
+            break;
+        }
+
+        if (end - ip < 2) {
+            return std::nullopt;
+        }
+        std::size_t offset = ip[0] | (std::size_t{ip[1]} << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - out)) {
+            return std::nullopt;
+        }
+        std::size_t match_length = token & 15;
+        if (match_length == 15 && !read_length(ip, end, match_length)) {
+            return std::nullopt;
+        }
+        match_length += MIN_MATCH;
+        if (match_length > static_cast<std::size_t>(out_end - op)) {
+            return std::nullopt;
+        }
+        const byte* match = op - offset;
+        if (offset >= 8 &&
+            static_cast<std::size_t>(out_end - op) >= match_length + 8) {
+            wild_copy(op, match, match_length);
+            op += match_length;
+        } else if (offset >= match_length) {
+            op = std::copy_n(match, match_length, op);
+        } else {
+            // Overlapping copy: repeats the last `offset` bytes.
+            for (std::size_t i = 0; i < match_length; ++i) {
+                *op++ = *match++;
+            }
+        }
+    }
+    return static_cast<std::size_t>(op - out);
+}
+
+void append_block(std::string& out, std::string_view raw, bool compress) {
+    auto start = out.size();
+    auto raw_size = static_cast<uint32_t>(raw.size());
+    out.resize(start + BLOCK_HEADER_SIZE +
+               (compress ? lz_compress_bound(raw.size()) : raw.size()));
+    char* payload = out.data() + start + BLOCK_HEADER_SIZE;
+
+    uint32_t stored_size = raw_size | STORED_FLAG;
+    if (compress) {
+        auto size = lz_compress(raw, payload);
+        if (size < raw.size()) {
+            stored_size = static_cast<uint32_t>(size);
+        }
+    }
+    if ((stored_size & STORED_FLAG) != 0) {
+        std::copy(raw.begin(), raw.end(), payload);
+    }
+    out.resize(start + BLOCK_HEADER_SIZE + (stored_size & ~STORED_FLAG));
+    put_le32(out.data() + start, BLOCK_MAGIC);
+    put_le32(out.data() + start + 4, raw_size);
+    put_le32(out.data() + start + 8, stored_size);
+}
+
+std::optional<BlockHeader> parse_block_header(std::string_view in) noexcept {
+    if (in.size() < BLOCK_HEADER_SIZE || get_le32(in.data()) != BLOCK_MAGIC) {
+        return std::nullopt;
+    }
+    auto stored = get_le32(in.data() + 8);
+    BlockHeader header{.raw_size = get_le32(in.data() + 4),
+                       .stored_size = stored & ~STORED_FLAG,
+                       .compressed = (stored & STORED_FLAG) == 0};
+    // A compressed byte expands to at most 255 output bytes, which bounds
+    // what a corrupt header can make the reader allocate.
+    if ((!header.compressed && header.stored_size != header.raw_size) ||
+        (header.compressed &&
+         header.raw_size > uint64_t{header.stored_size} * 255)) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+std::optional<BlockHeader> read_block_header(std::string_view in) noexcept {
+    auto header = parse_block_header(in);
+    if (!header || header->stored_size > in.size() - BLOCK_HEADER_SIZE) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+bool read_block(std::string_view in, std::string& out) {
+    auto header = read_block_header(in);
+    if (!header) {
+        return false;
+    }
+    auto payload = in.substr(BLOCK_HEADER_SIZE, header->stored_size);
+    if (!header->compressed) {
+        out.append(payload);
+        return true;
+    }
+    auto start = out.size();
+    out.resize(start + header->raw_size);
+    auto size = lz_decompress(payload, out.data() + start, header->raw_size);
+    if (!size || *size != header->raw_size) {
+        out.resize(start);
+        return false;
+    }
+    return true;
+}
+
+std::size_t find_block(std::string_view in) noexcept {
+    const char magic[] = {static_cast<char>(BLOCK_MAGIC & 0xFF),
+                          static_cast<char>((BLOCK_MAGIC >> 8) & 0xFF),
+                          static_cast<char>((BLOCK_MAGIC >> 16) & 0xFF),
+                          static_cast<char>((BLOCK_MAGIC >> 24) & 0xFF)};
+    for (auto pos = in.find(std::string_view(magic, 4));
+         pos != std::string_view::npos;
+         pos = in.find(std::string_view(magic, 4), pos + 1)) {
+        if (read_block_header(in.substr(pos))) {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+}  // namespace log_pp
@@ -0,0 +1,140 @@
+#include <mutex>
+#include <utility>
+
+#include "callsite.hpp"
+
+namespace {
+
+struct Registry {
+    // Serializes set_callsite_rules(); `mutex` guards the fields below.
+    std::mutex update_mutex;
+    std::mutex mutex;
+    std::vector<log_pp::CallsiteRule> rules;
+    log_pp::Callsite* head = nullptr;
+};
+
+Registry& registry() noexcept {
+    // Intentionally leaked: callsites are statics that may log during static
+    // destruction.
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+bool file_matches(std::string_view pattern, std::string_view file) noexcept {
+    if (log_pp::glob_match(pattern, file)) {
+        return true;
+    }
+    for (std::size_t i = 0; i < file.size(); ++i) {
+        if ((file[i] == '/' || file[i] == '\\') &&
+            log_pp::glob_match(pattern, file.substr(i + 1))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int8_t evaluate(const std::vector<log_pp::CallsiteRule>& rules,
+                const std::source_location& location) noexcept {
+    auto function = log_pp::qualified_function_name(location.function_name());
+    for (auto it = rules.rbegin(); it != rules.rend(); ++it) {
+        if (file_matches(it->file, location.file_name()) &&
+            log_pp::glob_match(it->function, function)) {
+            return static_cast<int8_t>(it->level);
+        }
+    }
+    return log_pp::Callsite::NO_RULE;
+}
+
+}  // namespace
+
+namespace log_pp {
+
+int8_t detail::resolve_callsite(Callsite& site,
+                                std::source_location location) noexcept {
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    auto state = site.state.load(std::memory_order_relaxed);
+    if (state != Callsite::UNRESOLVED) {
+        return state;
+    }
+    site.location = location;
+    site.next = reg.head;
+    reg.head = &site;
+    state = evaluate(reg.rules, location);
+    site.state.store(state, std::memory_order_relaxed);
+    return state;
+}
+
+void set_callsite_rules(std::vector<CallsiteRule> rules) {
+    auto& reg = registry();
+    std::lock_guard update(reg.update_mutex);
+    Callsite* head = nullptr;
+    {
+        std::lock_guard lock(reg.mutex);
+        reg.rules = rules;
+        head = reg.head;
+    }
+    // Re-evaluated without the registry lock, so callsites resolving for the
+    // first time pick up the new rules without waiting for this walk. Sites
+    // registered after `head` was read already used the new rules.
+    for (auto* site = head; site != nullptr; site = site->next) {
+        site->state.store(evaluate(rules, site->location),
+                          std::memory_order_relaxed);
+    }
+}
+
+bool glob_match(std::string_view pattern, std::string_view text) noexcept {
+    // Greedy matcher: on mismatch, let the last `*` absorb one more char.
+    std::size_t p = 0;
+    std::size_t t = 0;
+    std::size_t star = std::string_view::npos;
+    std::size_t resume = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() &&
+            (pattern[p] == '?' || pattern[p] == text[t])) {
+            ++p;
+            ++t;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            resume = t;
+        } else if (star != std::string_view::npos) {
+            p = star + 1;
+            t = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+std::string_view qualified_function_name(std::string_view signature) noexcept {
+    // The name ends at the parameter list: the first `(` outside template
+    // arguments. It starts after the last space before it (the return type
+    // and calling convention), again outside template arguments.
+    int depth = 0;
+    std::size_t start = 0;
+    std::size_t end = signature.size();
+    for (std::size_t i = 0; i < signature.size(); ++i) {
+        char ch = signature[i];
+        if (ch == '<') {
+            ++depth;
+        } else if (ch == '>' && depth > 0) {
+            --depth;
+        } else if (depth == 0 && ch == ' ') {
+            start = i + 1;
+        } else if (depth == 0 && ch == '(' && i > start) {
+            end = i;
+            break;
+        }
+    }
+    auto name = signature.substr(start, end - start);
+    while (!name.empty() && (name.front() == '*' || name.front() == '&')) {
+        name.remove_prefix(1);
+    }
+    return name;
+}
+
+}  // namespace log_pp
@@ -0,0 +1,247 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define LOG_PP_CLOCK_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define LOG_PP_CLOCK_TSC 1
+#endif
+
+#include "clock.hpp"
+
+namespace {
+
+std::atomic<log_pp::ClockSource> CLOCK_SOURCE = log_pp::ClockSource::Realtime;
+
+uint64_t realtime_ns() noexcept {
+#if defined(CLOCK_REALTIME)
+    timespec ts{};
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000u +
+           static_cast<uint64_t>(ts.tv_nsec);
+#else
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+#endif
+}
+
+uint64_t realtime_coarse_ns() noexcept {
+#if defined(CLOCK_REALTIME_COARSE)
+    timespec ts{};
+    clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000u +
+           static_cast<uint64_t>(ts.tv_nsec);
+#else
+    return realtime_ns();
+#endif
+}
+
+#if defined(LOG_PP_CLOCK_TSC)
+
+struct TscCalibration {
+    uint64_t base_ticks;
+    uint64_t base_ns;
+    double ns_per_tick;
+};
+
+// Seqlock around the current anchor: odd while `TSC_ANCHOR_MUTEX`'s holder
+// rewrites the fields below, so readers never block the re-anchoring thread.
+std::atomic<uint64_t> TSC_SEQ{0};
+std::atomic<uint64_t> TSC_BASE_TICKS{0};
+std::atomic<uint64_t> TSC_BASE_NS{0};
+std::atomic<double> TSC_NS_PER_TICK{0.0};
+std::mutex TSC_ANCHOR_MUTEX;
+std::once_flag TSC_CALIBRATION_FLAG;
+bool TSC_USABLE = false;
+
+// Wall time between anchors. Conversions past it take a new anchor, which
+// picks up realtime steps and refines the rate over the whole interval.
+constexpr uint64_t TSC_REANCHOR_NS = 1'000'000'000;
+// A larger rate change than this over one interval is a realtime step, not
+// drift; the anchor absorbs it and the previous rate is kept.
+constexpr double TSC_MAX_RATE_CHANGE = 1e-3;
+
+TscCalibration load_calibration() noexcept {
+    for (;;) {
+        auto seq = TSC_SEQ.load(std::memory_order_acquire);
+        if ((seq & 1) != 0) {
+            continue;
+        }
+        TscCalibration calibration{
+            TSC_BASE_TICKS.load(std::memory_order_relaxed),
+            TSC_BASE_NS.load(std::memory_order_relaxed),
+            TSC_NS_PER_TICK.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (TSC_SEQ.load(std::memory_order_relaxed) == seq) {
+            return calibration;
+        }
+    }
+}
+
+// Caller holds `TSC_ANCHOR_MUTEX` or is inside `call_once`.
+void store_calibration(const TscCalibration& calibration) noexcept {
+    auto seq = TSC_SEQ.load(std::memory_order_relaxed);
+    TSC_SEQ.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    TSC_BASE_TICKS.store(calibration.base_ticks, std::memory_order_relaxed);
+    TSC_BASE_NS.store(calibration.base_ns, std::memory_order_relaxed);
+    TSC_NS_PER_TICK.store(calibration.ns_per_tick,
+                          std::memory_order_relaxed);
+    TSC_SEQ.store(seq + 2, std::memory_order_release);
+}
+
+uint64_t read_tsc() noexcept {
+    return __rdtsc();
+}
+
+bool has_invariant_tsc() noexcept {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned>(regs[0]) < 0x80000007u) {
+        return false;
+    }
+    __cpuid(regs, 0x80000007);
+    return (static_cast<unsigned>(regs[3]) & (1u << 8)) != 0;
+#else
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx) == 0 ||
+        eax < 0x80000007u) {
+        return false;
+    }
+    __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+#endif
+}
+
+// Pairs a wall-clock reading with the TSC value at its midpoint.
+void sample(uint64_t& ticks, uint64_t& ns) noexcept {
+    auto before = read_tsc();
+    ns = realtime_ns();
+    auto after = read_tsc();
+    ticks = before + (after - before) / 2;
+}
+
+void calibrate_tsc() noexcept {
+    if (!has_invariant_tsc()) {
+        return;
+    }
+    uint64_t start_ticks = 0;
+    uint64_t start_ns = 0;
+    sample(start_ticks, start_ns);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    uint64_t end_ticks = 0;
+    uint64_t end_ns = 0;
+    sample(end_ticks, end_ns);
+    if (end_ticks <= start_ticks || end_ns <= start_ns) {
+        return;
+    }
+    store_calibration({end_ticks, end_ns,
+                       static_cast<double>(end_ns - start_ns) /
+                           static_cast<double>(end_ticks - start_ticks)});
+    TSC_USABLE = true;
+}
+
+// Takes a new anchor once `TSC_REANCHOR_NS` has passed since the last one.
+// Only one thread re-anchors; the others keep converting with the old one.
+TscCalibration reanchor_tsc(const TscCalibration& current) noexcept {
+    std::unique_lock lock(TSC_ANCHOR_MUTEX, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return current;
+    }
+    auto calibration = load_calibration();
+    uint64_t ticks = 0;
+    uint64_t ns = 0;
+    sample(ticks, ns);
+    if (ticks <= calibration.base_ticks ||
+        static_cast<double>(ticks - calibration.base_ticks) *
+                calibration.ns_per_tick <
+            static_cast<double>(TSC_REANCHOR_NS)) {
+        return calibration;
+    }
+    auto ns_per_tick = calibration.ns_per_tick;
+    if (ns > calibration.base_ns) {
+        auto measured = static_cast<double>(ns - calibration.base_ns) /
+                        static_cast<double>(ticks - calibration.base_ticks);
+        auto change = measured / ns_per_tick - 1.0;
+        if (change < TSC_MAX_RATE_CHANGE && change > -TSC_MAX_RATE_CHANGE) {
+            ns_per_tick = measured;
+        }
+    }
+    calibration = {ticks, ns, ns_per_tick};
+    store_calibration(calibration);
+    return calibration;
+}
+
+#endif
+
+}  // namespace
+
+namespace log_pp {
+
+bool set_clock_source(ClockSource source) noexcept {
+    if (source == ClockSource::Tsc) {
+#if defined(LOG_PP_CLOCK_TSC)
+        std::call_once(TSC_CALIBRATION_FLAG, calibrate_tsc);
+        if (!TSC_USABLE) {
+            return false;
+        }
+#else
+        return false;
+#endif
+    }
+    CLOCK_SOURCE.store(source, std::memory_order_release);
+    return true;
+}
+
+ClockSource clock_source() noexcept {
+    return CLOCK_SOURCE.load(std::memory_order_acquire);
+}
+
+Timestamp capture_timestamp() noexcept {
+    auto source = CLOCK_SOURCE.load(std::memory_order_acquire);
+    switch (source) {
+#if defined(LOG_PP_CLOCK_TSC)
+        case ClockSource::Tsc:
+            return {read_tsc(), source};
+#endif
+        case ClockSource::RealtimeCoarse:
+            return {realtime_coarse_ns(), source};
+        default:
+            return {realtime_ns(), ClockSource::Realtime};
+    }
+}
+
+std::chrono::system_clock::time_point to_time_point(
+    Timestamp timestamp) noexcept {
+    uint64_t ns = timestamp.value;
+#if defined(LOG_PP_CLOCK_TSC)
+    if (timestamp.source == ClockSource::Tsc) {
+        auto calibration = load_calibration();
+        auto ticks = static_cast<double>(
+            static_cast<int64_t>(timestamp.value - calibration.base_ticks));
+        if (ticks * calibration.ns_per_tick >
+            static_cast<double>(TSC_REANCHOR_NS)) {
+            calibration = reanchor_tsc(calibration);
+            ticks = static_cast<double>(
+                static_cast<int64_t>(timestamp.value - calibration.base_ticks));
+        }
+        ns = calibration.base_ns + static_cast<uint64_t>(static_cast<int64_t>(
+                                       ticks * calibration.ns_per_tick));
+    }
+#endif
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(static_cast<int64_t>(ns))));
+}
+
+}  // namespace log_pp
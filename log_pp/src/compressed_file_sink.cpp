@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstdint>
+#include <system_error>
+#include <utility>
+
+#include "compressed_file_sink.hpp"
+
+namespace {
+
+// Returns the size of the file without a block cut short at its end (by a
+// crash or a full disk), which would hide every block appended after it from
+// readers that walk the headers. Damage elsewhere is left to `find_block`.
+std::uintmax_t complete_size(const std::filesystem::path& path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return 0;
+    }
+    std::FILE* in = std::fopen(path.string().c_str(), "rb");
+    if (in == nullptr) {
+        return size;
+    }
+    std::uintmax_t offset = 0;
+    char buf[log_pp::BLOCK_HEADER_SIZE];
+    while (offset < size) {
+        if (size - offset < log_pp::BLOCK_HEADER_SIZE ||
+            std::fread(buf, 1, sizeof(buf), in) != sizeof(buf)) {
+            break;
+        }
+        auto header =
+            log_pp::parse_block_header(std::string_view(buf, sizeof(buf)));
+        if (!header) {
+            offset = size;
+            break;
+        }
+        auto end = offset + log_pp::BLOCK_HEADER_SIZE + header->stored_size;
+        if (end > size ||
+            std::fseek(in, static_cast<long>(header->stored_size),
+                       SEEK_CUR) != 0) {
+            break;
+        }
+        offset = end;
+    }
+    std::fclose(in);
+    return offset;
+}
+
+}  // namespace
+
+namespace log_pp {
+
+CompressedFileSink::CompressedFileSink(std::shared_ptr<const Encoder> encoder,
+                                       CompressedFileSinkOptions in_options)
+    : Sink(std::move(encoder)), options(std::move(in_options)) {
+    options.block_size = std::max<std::size_t>(options.block_size, 1);
+    options.max_pending_blocks =
+        std::max<std::size_t>(options.max_pending_blocks, 1);
+    current.reserve(options.block_size);
+    file_size = complete_size(options.path);
+    std::error_code ec;
+    if (std::filesystem::exists(options.path, ec) &&
+        std::filesystem::file_size(options.path, ec) != file_size) {
+        std::filesystem::resize_file(options.path, file_size, ec);
+    }
+    file = std::fopen(options.path.string().c_str(), "ab");
+    if (file != nullptr) {
+        std::setvbuf(file, nullptr, _IONBF, 0);
+    }
+    worker = std::thread([this] { run(); });
+}
+
+CompressedFileSink::~CompressedFileSink() {
+    {
+        std::unique_lock lock(mutex);
+        if (!current.empty()) {
+            seal_locked(lock);
+        }
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+void CompressedFileSink::seal_locked(std::unique_lock<std::mutex>& lock) {
+    space.wait(lock,
+               [&] { return sealed.size() < options.max_pending_blocks; });
+    sealed.push_back(std::move(current));
+    if (spare.empty()) {
+        current = std::string();
+        current.reserve(options.block_size);
+    } else {
+        current = std::move(spare.back());
+        spare.pop_back();
+    }
+    wake.notify_one();
+}
+
+void CompressedFileSink::write(std::string_view bytes) {
+    std::unique_lock lock(mutex);
+    // Keep whole records in one block so every block decodes on its own.
+    if (!current.empty() &&
+        current.size() + bytes.size() > options.block_size) {
+        seal_locked(lock);
+    }
+    current.append(bytes);
+    if (current.size() >= options.block_size) {
+        seal_locked(lock);
+    }
+}
+
+void CompressedFileSink::flush() {
+    std::unique_lock lock(mutex);
+    if (!current.empty()) {
+        seal_locked(lock);
+    }
+    drained.wait(lock, [&] { return sealed.empty() && in_flight == 0; });
+}
+
+std::size_t CompressedFileSink::written_bytes() noexcept {
+    std::lock_guard lock(mutex);
+    return written;
+}
+
+std::size_t CompressedFileSink::failed_blocks() noexcept {
+    std::lock_guard lock(mutex);
+    return failed;
+}
+
+void CompressedFileSink::run() {
+    std::string encoded;
+    std::unique_lock lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || !sealed.empty(); });
+        if (sealed.empty()) {
+            return;
+        }
+        auto block = std::move(sealed.front());
+        sealed.pop_front();
+        ++in_flight;
+        space.notify_all();
+        lock.unlock();
+
+        encoded.clear();
+        append_block(encoded, block, options.compress);
+        std::size_t size = 0;
+        bool ok = false;
+        if (file != nullptr) {
+            size = std::fwrite(encoded.data(), 1, encoded.size(), file);
+            ok = size == encoded.size();
+            if (ok) {
+                file_size += size;
+            } else {
+                // Cut the torn block off (e.g. on ENOSPC) so the blocks
+                // written after it stay reachable.
+                std::error_code ec;
+                std::filesystem::resize_file(options.path, file_size, ec);
+                std::clearerr(file);
+                size = 0;
+            }
+        }
+        block.clear();
+
+        lock.lock();
+        written += size;
+        failed += ok ? 0 : 1;
+        if (spare.size() < options.max_pending_blocks) {
+            spare.push_back(std::move(block));
+        }
+        --in_flight;
+        if (sealed.empty() && in_flight == 0) {
+            drained.notify_all();
+        }
+    }
+}
+
+}  // namespace log_pp
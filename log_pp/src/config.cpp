@@ -0,0 +1,484 @@
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "binary_encoder.hpp"
+#include "compressed_file_sink.hpp"
+#include "config.hpp"
+#include "file_sink.hpp"
+#include "json_encoder.hpp"
+#include "logfmt_encoder.hpp"
+#include "pattern_formatter.hpp"
+
+namespace {
+
+struct StdioSink : public log_pp::Sink {
+    std::FILE* stream;
+    std::mutex mutex;
+
+    StdioSink(std::shared_ptr<const log_pp::Encoder> encoder,
+              std::FILE* out) noexcept
+        : log_pp::Sink(std::move(encoder)), stream(out) {}
+
+    void write(std::string_view bytes) override {
+        std::lock_guard lock(mutex);
+        std::fwrite(bytes.data(), 1, bytes.size(), stream);
+    }
+
+    void flush() override {
+        std::lock_guard lock(mutex);
+        std::fflush(stream);
+    }
+};
+
+std::string_view trim(std::string_view text) noexcept {
+    auto first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    auto last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+bool parse_size(std::string_view text, std::size_t& out) noexcept {
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(),
+                                     out);
+    return ec == std::errc{} && end == text.data() + text.size();
+}
+
+bool is_file_type(std::string_view type) noexcept {
+    return type == "file" || type == "compressed_file";
+}
+
+// Whether an existing sink can be kept; `level` is updated in place.
+bool same_sink(log_pp::SinkConfig a, const log_pp::SinkConfig& b) noexcept {
+    a.level = b.level;
+    return a == b;
+}
+
+}  // namespace
+
+namespace log_pp {
+
+std::optional<LogConfig> parse_config(std::string_view text,
+                                      std::string* error) {
+    enum class Section { None, Log, Callsite, Sink };
+
+    LogConfig config;
+    std::string level = "trace";
+    std::string targets;
+    std::vector<std::size_t> sink_lines;
+    auto section = Section::None;
+    std::size_t line_no = 0;
+
+    auto fail = [&](std::size_t line, std::string_view reason) {
+        if (error != nullptr) {
+            *error = std::format("line {}: {}", line, reason);
+        }
+        return std::nullopt;
+    };
+
+    while (!text.empty()) {
+        ++line_no;
+        auto eol = text.find('\n');
+        auto line = trim(text.substr(0, eol));
+        text.remove_prefix(eol == std::string_view::npos ? text.size()
+                                                         : eol + 1);
+        if (line.empty() || line.front() == ';' || line.front() == '#') {
+            continue;
+        }
+
+        if (line.front() == '[') {
+            if (line.back() != ']') {
+                return fail(line_no, "unterminated section header");
+            }
+            auto name = trim(line.substr(1, line.size() - 2));
+            if (name == "log") {
+                section = Section::Log;
+            } else if (name.starts_with("callsite.") && name.size() > 9) {
+                section = Section::Callsite;
+                config.callsites.emplace_back();
+            } else if (name.starts_with("sink.") && name.size() > 5) {
+                name.remove_prefix(5);
+                for (const auto& sink : config.sinks) {
+                    if (sink.name == name) {
+                        return fail(line_no, std::format(
+                                                 "duplicate [sink.{}]", name));
+                    }
+                }
+                section = Section::Sink;
+                config.sinks.push_back(SinkConfig{.name = std::string(name)});
+                sink_lines.push_back(line_no);
+            } else {
+                return fail(line_no,
+                            std::format("unknown section [{}]", name));
+            }
+            continue;
+        }
+
+        auto equals = line.find('=');
+        if (equals == std::string_view::npos) {
+            return fail(line_no, "expected `key = value`");
+        }
+        auto key = trim(line.substr(0, equals));
+        auto value = trim(line.substr(equals + 1));
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+            value = value.substr(1, value.size() - 2);
+        }
+
+        std::optional<LevelFilter> parsed_level;
+        if (key == "level") {
+            parsed_level = parse_level_filter(value);
+            if (!parsed_level) {
+                return fail(line_no, std::format("unknown level `{}`", value));
+            }
+        }
+
+        bool known = true;
+        switch (section) {
+            case Section::None:
+                return fail(line_no, "key outside of a section");
+            case Section::Log:
+                if (key == "level") {
+                    level = value;
+                } else if (key == "targets") {
+                    if (!DirectiveFilter::valid(value)) {
+                        return fail(line_no, "invalid target directives");
+                    }
+                    targets = value;
+                } else {
+                    known = false;
+                }
+                break;
+            case Section::Callsite: {
+                auto& rule = config.callsites.back();
+                if (key == "file") {
+                    rule.file = value;
+                } else if (key == "function") {
+                    rule.function = value;
+                } else if (key == "level") {
+                    rule.level = *parsed_level;
+                } else {
+                    known = false;
+                }
+                break;
+            }
+            case Section::Sink: {
+                auto& sink = config.sinks.back();
+                if (key == "type") {
+                    if (!is_file_type(value) && value != "stdout" &&
+                        value != "stderr") {
+                        return fail(line_no, std::format(
+                                                 "unknown sink type `{}`",
+                                                 value));
+                    }
+                    sink.type = value;
+                } else if (key == "encoder") {
+                    if (value != "text" && value != "json" &&
+                        value != "logfmt" && value != "binary" &&
+                        value != "pattern") {
+                        return fail(line_no,
+                                    std::format("unknown encoder `{}`", value));
+                    }
+                    sink.encoder = value;
+                } else if (key == "pattern") {
+                    sink.pattern = value;
+                } else if (key == "path") {
+                    sink.path = value;
+                } else if (key == "max_file_size" || key == "max_files") {
+                    auto& out = key == "max_files" ? sink.max_files
+                                                   : sink.max_file_size;
+                    if (!parse_size(value, out)) {
+                        return fail(line_no, std::format(
+                                                 "`{}` is not a number",
+                                                 value));
+                    }
+                } else if (key == "level") {
+                    sink.level = *parsed_level;
+                } else {
+                    known = false;
+                }
+                break;
+            }
+        }
+        if (!known) {
+            return fail(line_no, std::format("unknown key `{}`", key));
+        }
+    }
+
+    for (std::size_t i = 0; i < config.sinks.size(); ++i) {
+        const auto& sink = config.sinks[i];
+        if (is_file_type(sink.type) && sink.path.empty()) {
+            return fail(sink_lines[i], "file sink without `path`");
+        }
+        if (sink.encoder == "pattern" && sink.pattern.empty()) {
+            return fail(sink_lines[i], "pattern encoder without `pattern`");
+        }
+    }
+    config.directives = targets.empty() ? level : level + "," + targets;
+    return config;
+}
+
+ConfigLogger::~ConfigLogger() {
+    stop_watching();
+}
+
+std::shared_ptr<const Encoder> ConfigLogger::encoder_for(
+    const SinkConfig& config) {
+    // Sinks with the same encoder settings share one instance, so the tee
+    // encodes each record once for all of them.
+    auto key = config.encoder;
+    if (config.encoder == "pattern") {
+        key += '\n';
+        key += config.pattern;
+    }
+    auto& encoder = encoders[key];
+    if (!encoder) {
+        if (config.encoder == "json") {
+            encoder = std::make_shared<JsonEncoder>();
+        } else if (config.encoder == "logfmt") {
+            encoder = std::make_shared<LogfmtEncoder>();
+        } else if (config.encoder == "binary") {
+            encoder = std::make_shared<BinaryEncoder>();
+        } else if (config.encoder == "pattern") {
+            encoder = std::make_shared<PatternFormatter>(config.pattern);
+        } else {
+            encoder = std::make_shared<TextEncoder>();
+        }
+    }
+    return encoder;
+}
+
+std::shared_ptr<Sink> ConfigLogger::make_sink(const SinkConfig& config) {
+    auto encoder = encoder_for(config);
+    if (config.type == "stdout") {
+        return std::make_shared<StdioSink>(std::move(encoder), stdout);
+    }
+    if (config.type == "stderr") {
+        return std::make_shared<StdioSink>(std::move(encoder), stderr);
+    }
+    if (config.type == "compressed_file") {
+        auto sink = std::make_shared<CompressedFileSink>(
+            std::move(encoder), CompressedFileSinkOptions{.path = config.path});
+        return sink->is_open() ? sink : nullptr;
+    }
+    auto sink = std::make_shared<FileSink>(
+        std::move(encoder), FileSinkOptions{
+                                .path = config.path,
+                                .max_file_size = config.max_file_size,
+                                .max_files = config.max_files,
+                            });
+    return sink->is_open() ? sink : nullptr;
+}
+
+bool ConfigLogger::fail_locked(std::string error) {
+    last_error = std::move(error);
+    return false;
+}
+
+bool ConfigLogger::apply(const LogConfig& config) {
+    std::lock_guard lock(update_mutex);
+    if (!DirectiveFilter::valid(config.directives)) {
+        return fail_locked("invalid target directives");
+    }
+
+    // Build everything first, so a sink that fails to open leaves the
+    // running config untouched.
+    std::map<std::string, ActiveSink> next;
+    std::vector<std::shared_ptr<Sink>> list;
+    for (const auto& sink_config : config.sinks) {
+        auto current = sinks.find(sink_config.name);
+        std::shared_ptr<Sink> sink;
+        if (current != sinks.end() &&
+            same_sink(current->second.config, sink_config)) {
+            sink = current->second.sink;
+        } else {
+            sink = make_sink(sink_config);
+            if (!sink) {
+                return fail_locked(
+                    std::format("cannot open `{}`", sink_config.path));
+            }
+        }
+        list.push_back(sink);
+        next.insert_or_assign(sink_config.name,
+                              ActiveSink{sink_config, std::move(sink)});
+    }
+
+    for (const auto& [name, active] : next) {
+        active.sink->set_level(active.config.level);
+    }
+    auto published = std::make_unique<State>();
+    published->filter.reload(config.directives);
+    published->tee.set_sinks(std::move(list));
+    auto max = published->filter.max_level();
+    state.store(std::move(published));
+
+    set_max_level(max);
+    if (owns_callsite_rules || !config.callsites.empty()) {
+        set_callsite_rules(config.callsites);
+        owns_callsite_rules = !config.callsites.empty();
+    }
+
+    // Dropped sinks are destroyed once in-flight records have left the tee.
+    sinks = std::move(next);
+    std::erase_if(encoders, [](const auto& entry) {
+        return entry.second.use_count() == 1;
+    });
+    last_error.clear();
+    return true;
+}
+
+bool ConfigLogger::load(std::string_view text) {
+    std::string error;
+    auto config = parse_config(text, &error);
+    if (!config) {
+        std::lock_guard lock(update_mutex);
+        return fail_locked(std::move(error));
+    }
+    return apply(*config);
+}
+
+bool ConfigLogger::load_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::lock_guard lock(update_mutex);
+        return fail_locked(std::format("cannot read `{}`", path.string()));
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+    return load(text.str());
+}
+
+bool ConfigLogger::watch(const std::filesystem::path& path) {
+    stop_watching();
+    if (!load_file(path)) {
+        return false;
+    }
+#if defined(__linux__)
+    auto dir = path.parent_path();
+    if (dir.empty()) {
+        dir = ".";
+    }
+    // Watch the directory: editors often save by renaming a new file over
+    // the old one, which a watch on the file itself would not follow.
+    int inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify < 0 ||
+        inotify_add_watch(inotify, dir.c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        if (inotify >= 0) {
+            close(inotify);
+        }
+        std::lock_guard lock(update_mutex);
+        return fail_locked(std::format("cannot watch `{}`", dir.string()));
+    }
+    stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (stop_fd < 0) {
+        close(inotify);
+        std::lock_guard lock(update_mutex);
+        return fail_locked("cannot create the watcher stop event");
+    }
+    watcher = std::thread([this, inotify, path, stop = stop_fd] {
+        auto name = path.filename().string();
+        alignas(inotify_event) char buffer[4096];
+        pollfd fds[2] = {{inotify, POLLIN, 0}, {stop, POLLIN, 0}};
+        for (;;) {
+            if (poll(fds, 2, -1) < 0 || (fds[1].revents & POLLIN) != 0) {
+                break;
+            }
+            bool changed = false;
+            ssize_t size;
+            while ((size = read(inotify, buffer, sizeof(buffer))) > 0) {
+                for (ssize_t offset = 0; offset < size;) {
+                    const auto* event =
+                        reinterpret_cast<const inotify_event*>(buffer + offset);
+                    if (event->len != 0 && name == event->name) {
+                        changed = true;
+                    }
+                    offset += sizeof(inotify_event) + event->len;
+                }
+            }
+            if (changed) {
+                load_file(path);
+            }
+        }
+        close(inotify);
+    });
+    return true;
+#else
+    std::lock_guard lock(update_mutex);
+    return fail_locked("watching config files needs inotify (Linux)");
+#endif
+}
+
+void ConfigLogger::stop_watching() noexcept {
+#if defined(__linux__)
+    if (watcher.joinable()) {
+        uint64_t one = 1;
+        (void)!::write(stop_fd, &one, sizeof(one));
+        watcher.join();
+        close(stop_fd);
+        stop_fd = -1;
+    }
+#endif
+}
+
+std::shared_ptr<Sink> ConfigLogger::get_sink(std::string_view name) const {
+    std::lock_guard lock(update_mutex);
+    auto it = sinks.find(std::string(name));
+    return it != sinks.end() ? it->second.sink : nullptr;
+}
+
+std::string ConfigLogger::get_last_error() const {
+    std::lock_guard lock(update_mutex);
+    return last_error;
+}
+
+bool ConfigLogger::enabled(const Metadata& metadata) const noexcept {
+    rcu::ReadGuard guard;
+    auto* current = state.load();
+    return current->filter.enabled(metadata) && current->tee.enabled(metadata);
+}
+
+void ConfigLogger::log(const Record& record) {
+    rcu::ReadGuard guard;
+    auto* current = state.load();
+    if (current->filter.enabled(record.get_metadata())) {
+        current->tee.log(record);
+    }
+}
+
+void ConfigLogger::log_batch(std::span<const Record> records) {
+    rcu::ReadGuard guard;
+    auto* current = state.load();
+    // Hand the runs the directives accept to the tee, so sinks still write
+    // each run at once.
+    std::size_t start = 0;
+    for (std::size_t i = 0; i <= records.size(); ++i) {
+        if (i < records.size() &&
+            current->filter.enabled(records[i].get_metadata())) {
+            continue;
+        }
+        if (i > start) {
+            current->tee.log_batch(records.subspan(start, i - start));
+        }
+        start = i + 1;
+    }
+}
+
+void ConfigLogger::flush() {
+    rcu::ReadGuard guard;
+    state.load()->tee.flush();
+}
+
+}  // namespace log_pp
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <atomic>
+#include <optional>
 
 #include "level.hpp"
 #include "log.hpp"
@@ -7,15 +9,63 @@ namespace {
 std::atomic<log_pp::LevelFilter> MAX_LOG_LEVEL_FILTER =
     log_pp::LevelFilter::Trace;
 
+// Not a valid LevelFilter; marks a thread without an override.
+constexpr auto NO_THREAD_LEVEL = static_cast<log_pp::LevelFilter>(-1);
+
+// Only the owning thread touches its levels, so they need no atomics, and
+// threads without an override pay a single compare.
+struct ThreadLevel {
+    log_pp::LevelFilter level = NO_THREAD_LEVEL;
+    log_pp::LevelFilter floor = log_pp::LevelFilter::Off;
+};
+thread_local ThreadLevel THREAD_LEVEL;
+
 }  // namespace
 
 namespace log_pp {
 void set_max_level(LevelFilter level) noexcept {
-    MAX_LOG_LEVEL_FILTER.store(level);
+    MAX_LOG_LEVEL_FILTER.store(level, std::memory_order_relaxed);
 }
 
 LevelFilter max_level() noexcept {
-    return MAX_LOG_LEVEL_FILTER.load();
+    return detail::thread_levels().max;
+}
+
+std::optional<LevelFilter> thread_max_level() noexcept {
+    auto level = THREAD_LEVEL.level;
+    if (level == NO_THREAD_LEVEL) {
+        return std::nullopt;
+    }
+    return level;
+}
+
+std::optional<LevelFilter> set_thread_max_level(
+    std::optional<LevelFilter> level) noexcept {
+    auto previous = thread_max_level();
+    THREAD_LEVEL.level = level.value_or(NO_THREAD_LEVEL);
+    return previous;
+}
+
+LevelFilter thread_level_floor() noexcept {
+    return THREAD_LEVEL.floor;
+}
+
+void set_thread_level_floor(LevelFilter level) noexcept {
+    THREAD_LEVEL.floor = level;
 }
 
+namespace detail {
+
+ThreadLevels thread_levels() noexcept {
+    auto [level, floor] = THREAD_LEVEL;
+    if (level == NO_THREAD_LEVEL) {
+        auto global = MAX_LOG_LEVEL_FILTER.load(std::memory_order_relaxed);
+        return {std::max(global, floor), floor};
+    }
+    level = std::max(level, floor);
+    return {level, level};
+}
+
+}  // namespace detail
+
 }  // namespace log_pp
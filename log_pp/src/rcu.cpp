@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rcu.hpp"
+
+namespace {
+
+struct ReaderSlot {
+    // 0 while the owning thread is quiescent, otherwise the global epoch
+    // observed when its outermost read-side section started.
+    std::atomic<uint64_t> epoch{0};
+    uint32_t nesting = 0;
+    bool in_use = false;
+};
+
+struct RetiredObject {
+    void* ptr;
+    void (*deleter)(void*);
+    uint64_t epoch;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ReaderSlot*> slots;
+    std::vector<RetiredObject> retired;
+};
+
+std::atomic<uint64_t> GLOBAL_EPOCH{1};
+
+Registry& registry() noexcept {
+    // Intentionally leaked so that threads exiting after static destruction
+    // can still release their slot.
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+struct SlotHandle {
+    ReaderSlot* slot;
+
+    SlotHandle() {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        auto it = std::find_if(reg.slots.begin(), reg.slots.end(),
+                               [](const ReaderSlot* s) { return !s->in_use; });
+        if (it != reg.slots.end()) {
+            slot = *it;
+        } else {
+            slot = new ReaderSlot();
+            reg.slots.push_back(slot);
+        }
+        slot->in_use = true;
+    }
+
+    ~SlotHandle() {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        slot->epoch.store(0, std::memory_order_release);
+        slot->nesting = 0;
+        slot->in_use = false;
+    }
+};
+
+ReaderSlot& local_slot() noexcept {
+    thread_local SlotHandle handle;
+    return *handle.slot;
+}
+
+// Returns the oldest epoch still observed by a reader, or UINT64_MAX when all
+// readers are quiescent. Caller must hold the registry mutex.
+uint64_t oldest_active_epoch(const Registry& reg) noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t oldest = UINT64_MAX;
+    for (const auto* slot : reg.slots) {
+        auto epoch = slot->epoch.load(std::memory_order_acquire);
+        if (epoch != 0) {
+            oldest = std::min(oldest, epoch);
+        }
+    }
+    return oldest;
+}
+
+}  // namespace
+
+namespace log_pp::rcu {
+
+void read_lock() noexcept {
+    auto& slot = local_slot();
+    if (slot.nesting++ == 0) {
+        slot.epoch.store(GLOBAL_EPOCH.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void read_unlock() noexcept {
+    auto& slot = local_slot();
+    if (--slot.nesting == 0) {
+        slot.epoch.store(0, std::memory_order_release);
+    }
+}
+
+void retire(void* ptr, void (*deleter)(void*)) noexcept {
+    auto epoch = GLOBAL_EPOCH.fetch_add(1, std::memory_order_seq_cst);
+    {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        reg.retired.push_back(RetiredObject{ptr, deleter, epoch});
+    }
+    reclaim();
+}
+
+void reclaim() noexcept {
+    std::vector<RetiredObject> ready;
+    {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        auto oldest = oldest_active_epoch(reg);
+        auto split = std::stable_partition(
+            reg.retired.begin(), reg.retired.end(),
+            [oldest](const RetiredObject& obj) { return obj.epoch >= oldest; });
+        ready.assign(split, reg.retired.end());
+        reg.retired.erase(split, reg.retired.end());
+    }
+    // Deleters run unlocked: destroying an object may itself retire others.
+    for (const auto& obj : ready) {
+        obj.deleter(obj.ptr);
+    }
+}
+
+void synchronize() noexcept {
+    auto target = GLOBAL_EPOCH.fetch_add(1, std::memory_order_seq_cst);
+    for (;;) {
+        {
+            auto& reg = registry();
+            std::lock_guard lock(reg.mutex);
+            if (oldest_active_epoch(reg) > target) {
+                break;
+            }
+        }
+        std::this_thread::yield();
+    }
+    reclaim();
+}
+
+}  // namespace log_pp::rcu
@@ -0,0 +1,249 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "shm_ring.hpp"
+
+namespace {
+
+constexpr std::size_t MIN_CAPACITY = 4096;
+
+constexpr uint64_t align8(uint64_t value) noexcept {
+    return (value + 7) & ~uint64_t{7};
+}
+
+std::atomic_ref<uint32_t> record_word(std::byte* at) noexcept {
+    return std::atomic_ref<uint32_t>(*reinterpret_cast<uint32_t*>(at));
+}
+
+bool map_segment(log_pp::detail::ShmMapping& mapping,
+                 const std::string& name,
+                 std::size_t size,
+                 bool create) {
+    int flags = O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_TRUNC : 0);
+    int fd = ::shm_open(name.c_str(), flags, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    if (create) {
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return false;
+        }
+    } else {
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 ||
+            static_cast<std::size_t>(st.st_size) <
+                sizeof(log_pp::detail::ShmRingHeader)) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<std::size_t>(st.st_size);
+    }
+    void* base =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    mapping.name = name;
+    mapping.fd = fd;
+    mapping.base = static_cast<std::byte*>(base);
+    mapping.size = size;
+    return true;
+}
+
+}  // namespace
+
+namespace log_pp {
+
+namespace detail {
+
+ShmMapping::~ShmMapping() {
+    if (base != nullptr) {
+        ::munmap(base, size);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    if (unlink_on_close && !name.empty()) {
+        ::shm_unlink(name.c_str());
+    }
+}
+
+}  // namespace detail
+
+ShmRingWriter::ShmRingWriter(const ShmRingOptions& options) {
+    auto capacity = std::bit_ceil(std::max(options.capacity, MIN_CAPACITY));
+    if (!map_segment(mapping, options.name,
+                     sizeof(detail::ShmRingHeader) + capacity, true)) {
+        return;
+    }
+    mapping.unlink_on_close = options.unlink_on_close;
+    auto* header = new (mapping.base) detail::ShmRingHeader{};
+    header->version = detail::SHM_RING_VERSION;
+    header->capacity = capacity;
+    header->write_pos.store(0, std::memory_order_relaxed);
+    header->read_pos.store(0, std::memory_order_relaxed);
+    header->dropped.store(0, std::memory_order_relaxed);
+    std::atomic_ref<uint64_t>(header->magic)
+        .store(detail::SHM_RING_MAGIC, std::memory_order_release);
+}
+
+std::size_t ShmRingWriter::capacity() const noexcept {
+    return is_open() ? mapping.header()->capacity : 0;
+}
+
+uint64_t ShmRingWriter::dropped_count() const noexcept {
+    return is_open() ? mapping.header()->dropped.load(std::memory_order_relaxed)
+                     : 0;
+}
+
+bool ShmRingWriter::publish(std::string_view bytes) noexcept {
+    if (!is_open()) {
+        return false;
+    }
+    auto* header = mapping.header();
+    const uint64_t capacity = header->capacity;
+    const uint64_t need = align8(detail::SHM_RECORD_HEADER_SIZE + bytes.size());
+    if (need > capacity / 2 || bytes.size() > detail::SHM_RECORD_LENGTH_MASK) {
+        header->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint64_t pos = header->write_pos.load(std::memory_order_relaxed);
+    uint64_t padding = 0;
+    for (;;) {
+        auto offset = pos & (capacity - 1);
+        auto contiguous = capacity - offset;
+        padding = need > contiguous ? contiguous : 0;
+        auto read = header->read_pos.load(std::memory_order_acquire);
+        if (pos + padding + need - read > capacity) {
+            header->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (header->write_pos.compare_exchange_weak(
+                pos, pos + padding + need, std::memory_order_acq_rel,
+                std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    auto* data = mapping.data();
+    if (padding != 0) {
+        auto length = static_cast<uint32_t>(padding -
+                                            detail::SHM_RECORD_HEADER_SIZE);
+        record_word(data + (pos & (capacity - 1)))
+            .store(detail::SHM_RECORD_COMMITTED | detail::SHM_RECORD_PADDING |
+                       length,
+                   std::memory_order_release);
+        pos += padding;
+    }
+    auto* slot = data + (pos & (capacity - 1));
+    std::memcpy(slot + detail::SHM_RECORD_HEADER_SIZE, bytes.data(),
+                bytes.size());
+    record_word(slot).store(
+        detail::SHM_RECORD_COMMITTED | static_cast<uint32_t>(bytes.size()),
+        std::memory_order_release);
+    return true;
+}
+
+ShmRingReader::ShmRingReader(const std::string& name) {
+    if (!map_segment(mapping, name, 0, false)) {
+        return;
+    }
+    auto* header = mapping.header();
+    if (std::atomic_ref<uint64_t>(header->magic)
+                .load(std::memory_order_acquire) != detail::SHM_RING_MAGIC ||
+        header->version != detail::SHM_RING_VERSION ||
+        sizeof(detail::ShmRingHeader) + header->capacity > mapping.size) {
+        ::munmap(mapping.base, mapping.size);
+        mapping.base = nullptr;
+        return;
+    }
+    position = header->read_pos.load(std::memory_order_acquire);
+}
+
+uint64_t ShmRingReader::dropped_count() const noexcept {
+    return is_open() ? mapping.header()->dropped.load(std::memory_order_relaxed)
+                     : 0;
+}
+
+std::optional<std::string_view> ShmRingReader::peek() noexcept {
+    if (!is_open()) {
+        return std::nullopt;
+    }
+    auto* header = mapping.header();
+    const uint64_t mask = header->capacity - 1;
+    for (;;) {
+        auto* slot = mapping.data() + (position & mask);
+        auto word = record_word(slot).load(std::memory_order_acquire);
+        if ((word & detail::SHM_RECORD_COMMITTED) == 0) {
+            return std::nullopt;
+        }
+        auto length = word & detail::SHM_RECORD_LENGTH_MASK;
+        current_size = align8(detail::SHM_RECORD_HEADER_SIZE + length);
+        if ((word & detail::SHM_RECORD_PADDING) != 0) {
+            pop();
+            continue;
+        }
+        return std::string_view(
+            reinterpret_cast<const char*>(slot +
+                                          detail::SHM_RECORD_HEADER_SIZE),
+            length);
+    }
+}
+
+void ShmRingReader::pop() noexcept {
+    if (current_size == 0) {
+        return;
+    }
+    auto* header = mapping.header();
+    auto* slot = mapping.data() + (position & (header->capacity - 1));
+    // Any 8-byte word of the released span may become a record header on the
+    // next lap, so it must read as uncommitted until a writer commits it.
+    std::memset(slot, 0, current_size);
+    position += current_size;
+    current_size = 0;
+    header->read_pos.store(position, std::memory_order_release);
+}
+
+ShmRingSink::ShmRingSink(std::shared_ptr<const Encoder> encoder,
+                         const ShmRingOptions& options)
+    : Sink(std::move(encoder)), ring(options) {}
+
+void ShmRingSink::log(const Record& record) {
+    thread_local std::string buffer;
+    buffer.clear();
+    get_encoder()->encode(record, buffer);
+    ring.publish(buffer);
+}
+
+void ShmRingSink::log_batch(std::span<const Record> records) {
+    thread_local std::string buffer;
+    for (const auto& record : records) {
+        buffer.clear();
+        get_encoder()->encode(record, buffer);
+        ring.publish(buffer);
+    }
+}
+
+void ShmRingSink::write(std::string_view bytes) {
+    ring.publish(bytes);
+}
+
+void ShmRingSink::write_batch_shared(std::span<const Record> records,
+                                     const SharedBuffer& buffer) {
+    (void)buffer;
+    log_batch(records);
+}
+
+}  // namespace log_pp
@@ -0,0 +1,566 @@
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include "socket_sink.hpp"
+
+namespace {
+
+int syslog_severity(log_pp::Level level) noexcept {
+    switch (level) {
+        case log_pp::Level::Error:
+            return 3;
+        case log_pp::Level::Warning:
+            return 4;
+        case log_pp::Level::Info:
+            return 6;
+        default:
+            return 7;
+    }
+}
+
+// RFC 5424 header fields must be printable US-ASCII without spaces.
+void append_header_field(std::string& out,
+                         std::string_view value,
+                         std::size_t max_len) {
+    std::size_t written = 0;
+    for (char c : value) {
+        if (written == max_len) {
+            break;
+        }
+        if (c > ' ' && c < 127) {
+            out.push_back(c);
+            ++written;
+        }
+    }
+    if (written == 0) {
+        out.push_back('-');
+    }
+}
+
+void append_rfc3339(std::string& out,
+                    std::chrono::system_clock::time_point time) {
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                      time.time_since_epoch())
+                      .count();
+    auto seconds = static_cast<time_t>(micros / 1'000'000);
+    tm utc{};
+    gmtime_r(&seconds, &utc);
+    char buf[40];
+    auto n = std::snprintf(buf, sizeof(buf),
+                           "%04d-%02d-%02dT%02d:%02d:%02d.%06ldZ",
+                           utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday,
+                           utc.tm_hour, utc.tm_min, utc.tm_sec,
+                           static_cast<long>(micros % 1'000'000));
+    out.append(buf, static_cast<std::size_t>(n));
+}
+
+bool is_stream(log_pp::SocketKind kind) noexcept {
+    return kind != log_pp::SocketKind::UnixDatagram;
+}
+
+bool would_block(int err) noexcept {
+    return err == EAGAIN || err == EWOULDBLOCK || err == ENOBUFS;
+}
+
+// Errors after which the connection is unusable; anything else is specific
+// to the frame being sent.
+bool is_connection_error(int err) noexcept {
+    return err == ECONNREFUSED || err == ECONNRESET || err == ENOTCONN ||
+           err == EPIPE || err == EDESTADDRREQ || err == EBADF ||
+           err == ENOENT || err == ENETUNREACH || err == EHOSTUNREACH;
+}
+
+bool wait_writable(int fd, std::chrono::milliseconds timeout) noexcept {
+    pollfd pfd{fd, POLLOUT, 0};
+    return ::poll(&pfd, 1, static_cast<int>(timeout.count())) == 1 &&
+           (pfd.revents & POLLOUT) != 0;
+}
+
+int connect_unix(const std::string& path, int type) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        return -1;
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    int fd = ::socket(AF_UNIX, type | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+int connect_tcp(const std::string& host,
+                uint16_t port,
+                std::chrono::milliseconds timeout) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    auto service = std::to_string(port);
+    if (::getaddrinfo(host.c_str(), service.c_str(), &hints, &result) != 0) {
+        return -1;
+    }
+    int fd = -1;
+    for (auto* ai = result; ai != nullptr; ai = ai->ai_next) {
+        fd = ::socket(ai->ai_family,
+                      ai->ai_socktype | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                      ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            break;
+        }
+        if (errno == EINPROGRESS) {
+            pollfd pfd{fd, POLLOUT, 0};
+            int err = 0;
+            socklen_t len = sizeof(err);
+            if (::poll(&pfd, 1, static_cast<int>(timeout.count())) == 1 &&
+                ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) == 0 &&
+                err == 0) {
+                break;
+            }
+        }
+        ::close(fd);
+        fd = -1;
+    }
+    ::freeaddrinfo(result);
+    return fd;
+}
+
+}  // namespace
+
+namespace log_pp {
+
+SocketSink::SocketSink(std::shared_ptr<const Encoder> encoder,
+                       SocketSinkOptions in_options)
+    : Sink(std::move(encoder)),
+      options(std::move(in_options)),
+      hostname(options.hostname) {
+    if (hostname.empty()) {
+        char buf[256] = {};
+        if (::gethostname(buf, sizeof(buf) - 1) == 0) {
+            hostname = buf;
+        }
+    }
+    options.max_batch =
+        std::clamp<std::size_t>(options.max_batch, 1, IOV_MAX);
+    next_connect = std::chrono::steady_clock::now();
+    worker = std::thread([this] { run(); });
+}
+
+SocketSink::~SocketSink() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+        stop_deadline =
+            std::chrono::steady_clock::now() + options.flush_timeout;
+    }
+    wake.notify_all();
+    worker.join();
+    disconnect();
+}
+
+void SocketSink::frame(const Record& record,
+                       std::string_view payload,
+                       std::string& out) const {
+    if (!payload.empty() && payload.back() == '\n') {
+        payload.remove_suffix(1);
+    }
+    if (options.framing == SocketFraming::LengthPrefixed) {
+        auto size = static_cast<uint32_t>(payload.size());
+        out.push_back(static_cast<char>((size >> 24) & 0xFF));
+        out.push_back(static_cast<char>((size >> 16) & 0xFF));
+        out.push_back(static_cast<char>((size >> 8) & 0xFF));
+        out.push_back(static_cast<char>(size & 0xFF));
+        out.append(payload);
+        return;
+    }
+
+    auto start = out.size();
+    out.push_back('<');
+    out.append(std::to_string(options.facility * 8 +
+                              syslog_severity(record.get_level())));
+    out.append(">1 ");
+    append_rfc3339(out, record.get_timestamp().value_or(
+                            std::chrono::system_clock::now()));
+    out.push_back(' ');
+    append_header_field(out, hostname, 255);
+    out.push_back(' ');
+    append_header_field(out, options.app_name, 48);
+    out.push_back(' ');
+    out.append(std::to_string(::getpid()));
+    out.push_back(' ');
+    append_header_field(out, record.get_target(), 32);
+    out.append(" - ");
+    out.append(payload);
+
+    if (is_stream(options.kind)) {
+        auto length = std::to_string(out.size() - start) + ' ';
+        out.insert(start, length);
+    }
+}
+
+void SocketSink::log(const Record& record) {
+    std::string payload;
+    get_encoder()->encode(record, payload);
+    std::string framed;
+    frame(record, payload, framed);
+    enqueue(std::move(framed));
+}
+
+void SocketSink::log_batch(std::span<const Record> records) {
+    std::vector<std::string> frames;
+    frames.reserve(records.size());
+    std::string payload;
+    for (const auto& record : records) {
+        payload.clear();
+        get_encoder()->encode(record, payload);
+        frame(record, payload, frames.emplace_back());
+    }
+    std::unique_lock lock(mutex);
+    bool was_empty = queue.empty();
+    for (auto& framed : frames) {
+        enqueue_locked(std::move(framed));
+    }
+    bool wake_worker = (was_empty && !queue.empty()) ||
+                       queue.size() >= options.max_batch;
+    lock.unlock();
+    if (wake_worker) {
+        wake.notify_one();
+    }
+}
+
+void SocketSink::write(std::string_view bytes) {
+    std::string framed;
+    frame(RecordBuilder{}.set_level(Level::Info).build(), bytes, framed);
+    enqueue(std::move(framed));
+}
+
+void SocketSink::write_shared(const Record& record,
+                              const SharedBuffer& buffer) {
+    std::string framed;
+    frame(record, *buffer, framed);
+    enqueue(std::move(framed));
+}
+
+void SocketSink::write_batch_shared(std::span<const Record> records,
+                                    const SharedBuffer& buffer) {
+    (void)buffer;
+    log_batch(records);
+}
+
+void SocketSink::enqueue_locked(std::string framed) {
+    if (framed.size() > options.spill_capacity ||
+        (!is_stream(options.kind) && framed.size() > options.max_datagram)) {
+        ++dropped;
+        return;
+    }
+    while (queued_bytes + framed.size() > options.spill_capacity &&
+           !queue.empty()) {
+        queued_bytes -= queue.front().size();
+        queue.pop_front();
+        ++dropped;
+    }
+    queued_bytes += framed.size();
+    queue.push_back(std::move(framed));
+}
+
+void SocketSink::enqueue(std::string framed) {
+    std::unique_lock lock(mutex);
+    enqueue_locked(std::move(framed));
+    // The worker sleeps without a timeout while idle and disconnected.
+    bool wake_worker =
+        queue.size() == 1 || queue.size() >= options.max_batch;
+    lock.unlock();
+    if (wake_worker) {
+        wake.notify_one();
+    }
+}
+
+void SocketSink::flush() {
+    std::unique_lock lock(mutex);
+    if (queue.empty() && in_flight == 0) {
+        return;
+    }
+    flush_requested = true;
+    wake.notify_one();
+    drained.wait_for(lock, options.flush_timeout, [&] {
+        return (queue.empty() && in_flight == 0) || !flush_requested;
+    });
+}
+
+std::size_t SocketSink::dropped_count() noexcept {
+    std::lock_guard lock(mutex);
+    return dropped;
+}
+
+std::size_t SocketSink::pending_count() noexcept {
+    std::lock_guard lock(mutex);
+    return queue.size() + in_flight;
+}
+
+bool SocketSink::ensure_connected() {
+    if (fd >= 0) {
+        return true;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now < next_connect) {
+        return false;
+    }
+    switch (options.kind) {
+        case SocketKind::UnixStream:
+            fd = connect_unix(options.address, SOCK_STREAM);
+            break;
+        case SocketKind::UnixDatagram:
+            fd = connect_unix(options.address, SOCK_DGRAM);
+            break;
+        case SocketKind::Tcp:
+            fd = connect_tcp(options.address, options.port,
+                             options.flush_timeout);
+            break;
+    }
+    if (fd >= 0) {
+        backoff = std::chrono::milliseconds::zero();
+        return true;
+    }
+    backoff = backoff == std::chrono::milliseconds::zero()
+                  ? options.reconnect_min
+                  : std::min(backoff * 2, options.reconnect_max);
+    next_connect = now + backoff;
+    return false;
+}
+
+void SocketSink::disconnect() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+        next_connect = std::chrono::steady_clock::now() + options.reconnect_min;
+    }
+}
+
+// Sends frames with gathering sendmsg calls. Frames are removed from `batch`
+// as they complete; a partially written frame is finished before returning
+// so the byte stream never carries a torn frame across batches.
+bool SocketSink::send_stream(std::deque<std::string>& batch) {
+    std::vector<iovec> iov;
+    std::size_t offset = 0;
+    while (!batch.empty()) {
+        iov.clear();
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            auto skip = i == 0 ? offset : 0;
+            iov.push_back(iovec{batch[i].data() + skip, batch[i].size() - skip});
+        }
+        msghdr msg{};
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = iov.size();
+        auto sent = ::sendmsg(fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (!would_block(errno)) {
+                return false;
+            }
+            if (!wait_writable(fd, options.flush_interval)) {
+                // Between frames a slow peer only delays the batch; inside a
+                // frame it has to keep up or the connection is reset.
+                return offset == 0;
+            }
+            continue;
+        }
+        auto remaining = static_cast<std::size_t>(sent);
+        while (remaining > 0) {
+            auto left_in_front = batch.front().size() - offset;
+            if (remaining < left_in_front) {
+                offset += remaining;
+                remaining = 0;
+            } else {
+                remaining -= left_in_front;
+                offset = 0;
+                batch.pop_front();
+            }
+        }
+    }
+    return true;
+}
+
+// Sends one datagram per frame. A frame the kernel rejects on its own, e.g.
+// with EMSGSIZE, is dropped and counted in `failed` so it cannot block the
+// frames behind it; only connection errors return `false`.
+bool SocketSink::send_datagrams(std::deque<std::string>& batch,
+                                std::size_t& failed) {
+#if defined(__linux__)
+    std::vector<iovec> iov(batch.size());
+    std::vector<mmsghdr> msgs(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        iov[i] = iovec{batch[i].data(), batch[i].size()};
+        msgs[i] = mmsghdr{};
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    std::size_t done = 0;
+    while (done < msgs.size()) {
+        auto sent = ::sendmmsg(fd, msgs.data() + done,
+                               static_cast<unsigned>(msgs.size() - done),
+                               MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (would_block(errno) &&
+                wait_writable(fd, options.flush_interval)) {
+                continue;
+            }
+            if (!would_block(errno) && !is_connection_error(errno)) {
+                ++failed;
+                ++done;
+                continue;
+            }
+            batch.erase(batch.begin(), batch.begin() + done);
+            return !is_connection_error(errno);
+        }
+        done += static_cast<std::size_t>(sent);
+    }
+    batch.clear();
+    return true;
+#else
+    while (!batch.empty()) {
+        auto sent = ::send(fd, batch.front().data(), batch.front().size(),
+                           MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (would_block(errno) &&
+                wait_writable(fd, options.flush_interval)) {
+                continue;
+            }
+            if (!would_block(errno) && !is_connection_error(errno)) {
+                ++failed;
+                batch.pop_front();
+                continue;
+            }
+            return !is_connection_error(errno);
+        }
+        batch.pop_front();
+    }
+    return true;
+#endif
+}
+
+void SocketSink::requeue_front_locked(std::deque<std::string>& batch) {
+    for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+        queued_bytes += it->size();
+        queue.push_front(std::move(*it));
+    }
+    batch.clear();
+    while (queued_bytes > options.spill_capacity && !queue.empty()) {
+        queued_bytes -= queue.front().size();
+        queue.pop_front();
+        ++dropped;
+    }
+}
+
+void SocketSink::drop_queue_locked() noexcept {
+    dropped += queue.size();
+    queue.clear();
+    queued_bytes = 0;
+}
+
+void SocketSink::run() {
+    std::unique_lock lock(mutex);
+    std::deque<std::string> batch;
+    for (;;) {
+        if (fd >= 0) {
+            wake.wait_for(lock, options.flush_interval, [&] {
+                return stopping || flush_requested ||
+                       queue.size() >= options.max_batch;
+            });
+        } else if (queue.empty()) {
+            wake.wait(lock, [&] { return stopping || !queue.empty(); });
+        } else if (stopping) {
+            // Keep reconnecting until the stop deadline.
+            wake.wait_until(lock, std::min(next_connect, stop_deadline));
+        } else {
+            wake.wait_until(lock, next_connect, [&] { return stopping; });
+        }
+
+        if (queue.empty()) {
+            flush_requested = false;
+            drained.notify_all();
+            if (stopping) {
+                return;
+            }
+            continue;
+        }
+
+        if (fd < 0) {
+            lock.unlock();
+            bool connected = ensure_connected();
+            lock.lock();
+            if (!connected) {
+                flush_requested = false;
+                drained.notify_all();
+                if (stopping &&
+                    std::chrono::steady_clock::now() >= stop_deadline) {
+                    drop_queue_locked();
+                    return;
+                }
+                continue;
+            }
+        }
+
+        auto count = std::min(queue.size(), options.max_batch);
+        for (std::size_t i = 0; i < count; ++i) {
+            queued_bytes -= queue.front().size();
+            batch.push_back(std::move(queue.front()));
+            queue.pop_front();
+        }
+        in_flight = batch.size();
+        lock.unlock();
+
+        std::size_t failed = 0;
+        bool ok = is_stream(options.kind) ? send_stream(batch)
+                                          : send_datagrams(batch, failed);
+        if (!ok) {
+            disconnect();
+        }
+
+        lock.lock();
+        in_flight = 0;
+        dropped += failed;
+        requeue_front_locked(batch);
+        // A peer that stops reading must not keep the destructor waiting.
+        if (stopping && std::chrono::steady_clock::now() >= stop_deadline) {
+            drop_queue_locked();
+        }
+        if (queue.empty()) {
+            flush_requested = false;
+            drained.notify_all();
+        }
+    }
+}
+
+}  // namespace log_pp
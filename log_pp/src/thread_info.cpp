@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+#include "thread_info.hpp"
+
+namespace {
+
+uint64_t os_thread_id() noexcept {
+#if defined(_WIN32)
+    return static_cast<uint64_t>(::GetCurrentThreadId());
+#elif defined(__linux__)
+    return static_cast<uint64_t>(::syscall(SYS_gettid));
+#elif defined(__APPLE__)
+    uint64_t id = 0;
+    ::pthread_threadid_np(nullptr, &id);
+    return id;
+#else
+    return static_cast<uint64_t>(
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+}
+
+void assign_name(log_pp::ThreadInfo& info, std::string_view name) noexcept {
+    auto length = std::min(name.size(), log_pp::ThreadInfo::NAME_CAPACITY);
+    std::memcpy(info.name, name.data(), length);
+    info.name[length] = '\0';
+    info.name_length = static_cast<uint8_t>(length);
+}
+
+log_pp::ThreadInfo load_thread_info() noexcept {
+    log_pp::ThreadInfo info;
+    info.id = os_thread_id();
+#if defined(__linux__) || defined(__APPLE__)
+    char name[64]{};
+    if (::pthread_getname_np(::pthread_self(), name, sizeof(name)) == 0) {
+        assign_name(info, name);
+    }
+#endif
+    return info;
+}
+
+log_pp::ThreadInfo& thread_info() noexcept {
+    thread_local log_pp::ThreadInfo info = load_thread_info();
+    return info;
+}
+
+}  // namespace
+
+namespace log_pp {
+
+const ThreadInfo& current_thread() noexcept {
+    return thread_info();
+}
+
+void set_thread_name(std::string_view name) noexcept {
+    assign_name(thread_info(), name);
+}
+
+}  // namespace log_pp
@@ -0,0 +1,133 @@
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "binary_encoder.hpp"
+#include "log.hpp"
+
+namespace {
+
+// Minimal reader for the layout documented on BinaryEncoder.
+struct Reader {
+    std::string_view data;
+
+    uint8_t u8() {
+        auto value = static_cast<uint8_t>(data.front());
+        data.remove_prefix(1);
+        return value;
+    }
+
+    uint64_t le(std::size_t size) {
+        uint64_t value = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            value |= uint64_t{u8()} << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            auto byte = u8();
+            value |= uint64_t{byte & 0x7Fu} << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+    }
+
+    std::string_view str() {
+        auto size = varint();
+        auto text = data.substr(0, size);
+        data.remove_prefix(size);
+        return text;
+    }
+};
+
+}  // namespace
+
+TEST(log_pp_binary_encoder, writes_documented_layout) {
+    std::array<uint8_t, 70> payload{};
+    payload[0] = 0x00;
+    payload[1] = '\n';
+    payload[69] = 0xff;
+    int count = 3;
+    auto args = std::make_format_args(count);
+    log_pp::KVList kvs{{"neg", -2},
+                       {"big", uint64_t{1} << 40},
+                       {"f", 0.5f},
+                       {"d", 2.25},
+                       {"ok", true},
+                       {"host", "db1"},
+                       {"raw", log_pp::bytes(payload)},
+                       {"hex", 255, "{:#x}"}};
+    auto location = std::source_location::current();
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Warning)
+                      .set_target("net")
+                      .set_format_string("{} retries")
+                      .set_args(args)
+                      .set_kvs(kvs)
+                      .set_module(location)
+                      .set_timestamp(log_pp::Timestamp{1'500'000'000})
+                      .set_thread(log_pp::current_thread())
+                      .build();
+    std::string out;
+    log_pp::BinaryEncoder{}.encode(record, out);
+
+    Reader reader{out};
+    EXPECT_EQ(out.size() - 4, reader.le(4));
+    EXPECT_EQ(2u, reader.u8());
+    EXPECT_EQ(log_pp::BinaryEncoder::HAS_TIMESTAMP |
+                  log_pp::BinaryEncoder::HAS_SOURCE |
+                  log_pp::BinaryEncoder::HAS_THREAD,
+              reader.u8());
+    EXPECT_EQ(1'500'000'000u, reader.le(8));
+    EXPECT_EQ(location.file_name(), reader.str());
+    EXPECT_EQ(location.line(), reader.varint());
+    EXPECT_EQ(log_pp::current_thread().id, reader.varint());
+    EXPECT_EQ(log_pp::current_thread().get_name(), reader.str());
+    EXPECT_EQ("net", reader.str());
+    EXPECT_EQ("3 retries", reader.str());
+    ASSERT_EQ(kvs.size(), reader.varint());
+
+    auto expect_key = [&](std::string_view key, log_pp::BinaryValueType type) {
+        EXPECT_EQ(key, reader.str());
+        EXPECT_EQ(static_cast<uint8_t>(type), reader.u8());
+    };
+    expect_key("neg", log_pp::BinaryValueType::Int64);
+    EXPECT_EQ(3u, reader.varint());  // zigzag(-2)
+    expect_key("big", log_pp::BinaryValueType::UInt64);
+    EXPECT_EQ(uint64_t{1} << 40, reader.varint());
+    expect_key("f", log_pp::BinaryValueType::Float);
+    EXPECT_EQ(0.5f, std::bit_cast<float>(static_cast<uint32_t>(reader.le(4))));
+    expect_key("d", log_pp::BinaryValueType::Double);
+    EXPECT_EQ(2.25, std::bit_cast<double>(reader.le(8)));
+    expect_key("ok", log_pp::BinaryValueType::Bool);
+    EXPECT_EQ(1u, reader.u8());
+    expect_key("host", log_pp::BinaryValueType::String);
+    EXPECT_EQ("db1", reader.str());
+    // Bytes are copied untouched and not truncated to max_size.
+    expect_key("raw", log_pp::BinaryValueType::Bytes);
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(payload.data()),
+                               payload.size()),
+              reader.str());
+    expect_key("hex", log_pp::BinaryValueType::Custom);
+    EXPECT_EQ("0xff", reader.str());
+    EXPECT_TRUE(reader.data.empty());
+}
+
+TEST(log_pp_binary_encoder, omits_absent_fields) {
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_format_string("hi")
+                      .build();
+    std::string out;
+    log_pp::BinaryEncoder{}.encode(record, out);
+    EXPECT_EQ(std::string("\x07\x00\x00\x00\x03\x00\x00\x02hi\x00", 11), out);
+}
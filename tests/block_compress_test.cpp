@@ -0,0 +1,298 @@
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "binary_encoder.hpp"
+#include "block_compress.hpp"
+#include "compressed_file_sink.hpp"
+#include "log.hpp"
+
+namespace {
+
+std::filesystem::path temp_log_dir(const char* name) {
+    auto dir =
+        std::filesystem::temp_directory_path() / "log_pp_block_compress" / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+std::string log_text(std::size_t lines) {
+    std::string text;
+    for (std::size_t i = 0; i < lines; ++i) {
+        text += "2026-10-18T09:00:00.000123Z [INFO] [db] query done rows=" +
+                std::to_string(i % 97) + " elapsed_ms=" +
+                std::to_string(i * 7 % 1000) + "\n";
+    }
+    return text;
+}
+
+std::optional<std::string> round_trip(std::string_view input) {
+    std::string compressed(log_pp::lz_compress_bound(input.size()), '\0');
+    compressed.resize(log_pp::lz_compress(input, compressed.data()));
+    std::string output(input.size(), '\0');
+    auto size = log_pp::lz_decompress(compressed, output.data(), output.size());
+    if (!size) {
+        return std::nullopt;
+    }
+    output.resize(*size);
+    return output;
+}
+
+// Splits a file into blocks using only the headers.
+std::vector<std::string_view> split_blocks(std::string_view data) {
+    std::vector<std::string_view> blocks;
+    while (auto header = log_pp::read_block_header(data)) {
+        auto size = log_pp::BLOCK_HEADER_SIZE + header->stored_size;
+        blocks.push_back(data.substr(0, size));
+        data.remove_prefix(size);
+    }
+    EXPECT_TRUE(data.empty());
+    return blocks;
+}
+
+}  // namespace
+
+TEST(log_pp_block_compress, round_trips_any_input) {
+    std::mt19937 rng(42);
+    std::string random(100'000, '\0');
+    for (auto& ch : random) {
+        ch = static_cast<char>(rng());
+    }
+    std::vector<std::string> inputs{"", "a", "abcdefghijkl", "abcdefghijklm",
+                                    std::string(1000, 'x'), random,
+                                    log_text(2000)};
+    for (std::size_t size = 0; size < 300; ++size) {
+        inputs.push_back(log_text(4).substr(0, size));
+    }
+    for (const auto& input : inputs) {
+        EXPECT_EQ(input, round_trip(input)) << input.size();
+    }
+
+    auto text = log_text(2000);
+    std::string compressed(log_pp::lz_compress_bound(text.size()), '\0');
+    auto size = log_pp::lz_compress(text, compressed.data());
+    EXPECT_LT(size, text.size() / 3);
+    // Incompressible input only grows by the token and literal length bytes.
+    compressed.resize(log_pp::lz_compress_bound(random.size()));
+    EXPECT_LE(log_pp::lz_compress(random, compressed.data()),
+              random.size() + random.size() / 255 + 2);
+}
+
+TEST(log_pp_block_compress, rejects_corrupt_input) {
+    auto text = log_text(50);
+    std::string compressed(log_pp::lz_compress_bound(text.size()), '\0');
+    compressed.resize(log_pp::lz_compress(text, compressed.data()));
+    std::string output(text.size(), '\0');
+
+    EXPECT_FALSE(log_pp::lz_decompress("", output.data(), output.size()));
+    EXPECT_FALSE(log_pp::lz_decompress(compressed, output.data(), 10));
+    for (std::size_t cut = 1; cut < compressed.size(); cut += 7) {
+        auto size = log_pp::lz_decompress(compressed.substr(0, cut),
+                                          output.data(), output.size());
+        EXPECT_TRUE(!size || *size < text.size()) << cut;
+    }
+    // Offset pointing before the start of the output.
+    EXPECT_FALSE(log_pp::lz_decompress(std::string_view("\x10" "a\x10\x00", 4),
+                                       output.data(), output.size()));
+}
+
+TEST(log_pp_block_compress, blocks_are_self_describing) {
+    auto text = log_text(100);
+    std::string file;
+    log_pp::append_block(file, text, true);
+    log_pp::append_block(file, "short", true);
+    log_pp::append_block(file, text, false);
+
+    auto blocks = split_blocks(file);
+    ASSERT_EQ(3u, blocks.size());
+    EXPECT_TRUE(log_pp::read_block_header(blocks[0])->compressed);
+    // Compression that does not pay off is skipped.
+    EXPECT_FALSE(log_pp::read_block_header(blocks[1])->compressed);
+    EXPECT_FALSE(log_pp::read_block_header(blocks[2])->compressed);
+
+    std::string out;
+    for (auto block : blocks) {
+        ASSERT_TRUE(log_pp::read_block(block, out));
+    }
+    EXPECT_EQ(text + "short" + text, out);
+
+    out.clear();
+    EXPECT_FALSE(log_pp::read_block(blocks[0].substr(0, 20), out));
+    EXPECT_TRUE(out.empty());
+    EXPECT_FALSE(log_pp::read_block_header("LPB0 not a block"));
+
+    // A corrupt size must not make the reader allocate gigabytes.
+    std::string huge(blocks[0]);
+    huge[7] = '\x7f';
+    EXPECT_FALSE(log_pp::read_block_header(huge));
+}
+
+TEST(log_pp_block_compress, sink_writes_independent_blocks) {
+    auto dir = temp_log_dir("sink");
+    auto path = dir / "app.lpb";
+    constexpr int RECORDS = 5000;
+    {
+        log_pp::CompressedFileSink sink(
+            std::make_shared<log_pp::TextEncoder>(),
+            {.path = path, .block_size = 16 * 1024, .max_pending_blocks = 2});
+        ASSERT_TRUE(sink.is_open());
+        for (int i = 0; i < RECORDS; ++i) {
+            LOG_PP_INFO(sink, {"db"}, {{"rows", i % 13}}, "query {} done", i);
+        }
+        sink.flush();
+        EXPECT_EQ(std::filesystem::file_size(path), sink.written_bytes());
+    }
+
+    auto data = read_file(path);
+    auto blocks = split_blocks(data);
+    ASSERT_GT(blocks.size(), 4u);
+
+    // Decode every block on its own thread; each holds whole records.
+    std::vector<std::string> decoded(blocks.size());
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        workers.emplace_back(
+            [&, i] { EXPECT_TRUE(log_pp::read_block(blocks[i], decoded[i])); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::size_t raw_size = 0;
+    int next = 0;
+    for (const auto& block : decoded) {
+        raw_size += block.size();
+        ASSERT_FALSE(block.empty());
+        EXPECT_EQ('\n', block.back());
+        std::istringstream lines(block);
+        for (std::string line; std::getline(lines, line); ++next) {
+            EXPECT_EQ("[INFO] [db] rows: " + std::to_string(next % 13) +
+                          ", query " + std::to_string(next) + " done",
+                      line);
+        }
+    }
+    EXPECT_EQ(RECORDS, next);
+    EXPECT_LT(data.size(), raw_size / 2);
+}
+
+TEST(log_pp_block_compress, sink_pairs_with_binary_encoder) {
+    auto dir = temp_log_dir("binary");
+    auto path = dir / "app.lpb";
+    std::array<uint8_t, 16> digest{1, 2, 3, 4, 5, 6, 7, 8,
+                                   9, 10, 11, 12, 13, 14, 15, 16};
+    {
+        log_pp::CompressedFileSink sink(
+            std::make_shared<log_pp::BinaryEncoder>(),
+            {.path = path, .block_size = 4096});
+        for (int i = 0; i < 500; ++i) {
+            LOG_PP_INFO(sink, {{"digest", log_pp::bytes(digest)}}, "n={}", i);
+        }
+    }
+
+    auto data = read_file(path);
+    std::string raw;
+    for (auto block : split_blocks(data)) {
+        ASSERT_TRUE(log_pp::read_block(block, raw));
+    }
+    // Walk the length-prefixed frames.
+    int frames = 0;
+    std::string_view rest(raw);
+    while (rest.size() >= 4) {
+        uint32_t size = 0;
+        for (int i = 0; i < 4; ++i) {
+            size |= uint32_t{static_cast<uint8_t>(rest[i])} << (8 * i);
+        }
+        ASSERT_LE(4 + size, rest.size());
+        EXPECT_NE(std::string_view::npos,
+                  rest.substr(4, size).find(std::string_view(
+                      reinterpret_cast<const char*>(digest.data()),
+                      digest.size())));
+        rest.remove_prefix(4 + size);
+        ++frames;
+    }
+    EXPECT_TRUE(rest.empty());
+    EXPECT_EQ(500, frames);
+}
+
+TEST(log_pp_block_compress, readers_resync_past_damaged_blocks) {
+    auto text = log_text(20);
+    std::string file;
+    log_pp::append_block(file, text, true);
+    auto first_size = file.size();
+    log_pp::append_block(file, "lost", false);
+    file.resize(first_size + 6);  // torn header
+    log_pp::append_block(file, "kept", false);
+
+    std::string_view data = file;
+    EXPECT_EQ(0u, log_pp::find_block(data));
+    data.remove_prefix(first_size);
+    EXPECT_FALSE(log_pp::read_block_header(data));
+    auto offset = log_pp::find_block(data);
+    ASSERT_EQ(6u, offset);
+    std::string out;
+    EXPECT_TRUE(log_pp::read_block(data.substr(offset), out));
+    EXPECT_EQ("kept", out);
+    EXPECT_EQ(std::string_view::npos, log_pp::find_block("no blocks here"));
+}
+
+TEST(log_pp_block_compress, sink_cuts_torn_tail_when_reopened) {
+    auto dir = temp_log_dir("torn");
+    auto path = dir / "app.lpb";
+    {
+        log_pp::CompressedFileSink sink(std::make_shared<log_pp::TextEncoder>(),
+                                        {.path = path});
+        LOG_PP_INFO(sink, "before");
+    }
+    // A crash in the middle of the next block leaves part of it behind.
+    std::string torn;
+    log_pp::append_block(torn, log_text(10), false);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out.write(torn.data(), 40);
+    }
+    {
+        log_pp::CompressedFileSink sink(std::make_shared<log_pp::TextEncoder>(),
+                                        {.path = path});
+        LOG_PP_INFO(sink, "after");
+    }
+
+    auto data = read_file(path);
+    std::string out;
+    for (auto block : split_blocks(data)) {
+        ASSERT_TRUE(log_pp::read_block(block, out));
+    }
+    EXPECT_EQ("[INFO] [] before\n[INFO] [] after\n", out);
+}
+
+#if defined(__linux__)
+TEST(log_pp_block_compress, sink_counts_blocks_it_cannot_write) {
+    log_pp::CompressedFileSink sink(std::make_shared<log_pp::TextEncoder>(),
+                                    {.path = "/dev/full"});
+    if (!sink.is_open()) {
+        GTEST_SKIP() << "/dev/full is not writable";
+    }
+    LOG_PP_INFO(sink, "no space");
+    sink.flush();
+    EXPECT_EQ(1u, sink.failed_blocks());
+    EXPECT_EQ(0u, sink.written_bytes());
+}
+#endif
@@ -0,0 +1,124 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "bytes.hpp"
+#include "json_encoder.hpp"
+#include "log.hpp"
+#include "logfmt_encoder.hpp"
+
+namespace {
+
+std::string reference_hex(const std::vector<uint8_t>& data) {
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string out;
+    for (auto byte : data) {
+        out.push_back(digits[byte >> 4]);
+        out.push_back(digits[byte & 0x0F]);
+    }
+    return out;
+}
+
+std::string reference_base64(const std::vector<uint8_t>& data) {
+    static constexpr char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    std::size_t i = 0;
+    for (; i + 3 <= data.size(); i += 3) {
+        uint32_t group = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        for (int shift = 18; shift >= 0; shift -= 6) {
+            out.push_back(alphabet[(group >> shift) & 0x3F]);
+        }
+    }
+    if (i + 1 == data.size()) {
+        uint32_t group = data[i] << 16;
+        out += {alphabet[group >> 18], alphabet[(group >> 12) & 0x3F], '=',
+                '='};
+    } else if (i + 2 == data.size()) {
+        uint32_t group = (data[i] << 16) | (data[i + 1] << 8);
+        out += {alphabet[group >> 18], alphabet[(group >> 12) & 0x3F],
+                alphabet[(group >> 6) & 0x3F], '='};
+    }
+    return out;
+}
+
+std::string render(const log_pp::Bytes& value) {
+    std::string out;
+    log_pp::detail::append_bytes(out, value);
+    return out;
+}
+
+}  // namespace
+
+TEST(log_pp_bytes_kv, vector_kernels_match_scalar_reference) {
+    std::vector<uint8_t> data;
+    for (std::size_t size = 0; size <= 130; ++size) {
+        data.resize(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<uint8_t>(i * 37 + size * 11);
+        }
+        EXPECT_EQ(reference_hex(data),
+                  render(log_pp::bytes(data, log_pp::BytesEncoding::Hex,
+                                       size)))
+            << size;
+        EXPECT_EQ(reference_base64(data),
+                  render(log_pp::bytes(data, log_pp::BytesEncoding::Base64,
+                                       size)))
+            << size;
+    }
+}
+
+TEST(log_pp_bytes_kv, known_vectors_and_truncation) {
+    std::array<uint8_t, 4> header{0xde, 0xad, 0xbe, 0xef};
+    EXPECT_EQ("deadbeef", render(log_pp::bytes(header)));
+    EXPECT_EQ("dead...", render(log_pp::bytes(header,
+                                              log_pp::BytesEncoding::Hex, 2)));
+    EXPECT_EQ("Zm9vYmFy",
+              render(log_pp::bytes(std::string_view("foobar"),
+                                   log_pp::BytesEncoding::Base64)));
+    EXPECT_EQ("Zm9vYg==",
+              render(log_pp::bytes("foobar", 4,
+                                   log_pp::BytesEncoding::Base64)));
+    EXPECT_EQ("", render(log_pp::bytes(nullptr, 0)));
+
+    std::vector<uint8_t> large(1000, 0xAB);
+    EXPECT_EQ(log_pp::Bytes::DEFAULT_MAX_SIZE * 2 + 3,
+              render(log_pp::bytes(large)).size());
+}
+
+TEST(log_pp_bytes_kv, kv_keeps_span_and_renders_lazily) {
+    std::array<std::byte, 3> digest{std::byte{0x01}, std::byte{0x02},
+                                    std::byte{0xff}};
+    log_pp::KV kv("digest", log_pp::bytes(digest));
+    auto value = kv.get_value();
+    ASSERT_TRUE(std::holds_alternative<log_pp::Bytes>(value));
+    EXPECT_EQ(digest.data(), std::get<log_pp::Bytes>(value).data.data());
+    EXPECT_EQ(3u, std::get<log_pp::Bytes>(value).data.size());
+    EXPECT_EQ("0102ff", kv.get_value_string());
+}
+
+TEST(log_pp_bytes_kv, encoders_render_bytes) {
+    std::array<uint8_t, 2> payload{0x0a, 0xfb};
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_format_string("packet")
+                      .set_kvs({{"hex", log_pp::bytes(payload)},
+                                {"b64", log_pp::bytes(
+                                            payload,
+                                            log_pp::BytesEncoding::Base64)}})
+                      .build();
+
+    std::string json;
+    log_pp::JsonEncoder{}.encode(record, json);
+    EXPECT_NE(std::string::npos,
+              json.find("\"hex\":\"0afb\",\"b64\":\"Cvs=\""));
+
+    std::string logfmt;
+    log_pp::LogfmtEncoder{}.encode(record, logfmt);
+    EXPECT_NE(std::string::npos, logfmt.find("hex=0afb b64=\"Cvs=\""));
+}
@@ -0,0 +1,114 @@
+#include <format>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "callsite.hpp"
+#include "log.hpp"
+
+namespace {
+
+struct CaptureLogger : public log_pp::BasicLogger<char> {
+    std::string last_message;
+    mutable std::optional<std::string_view> last_file;
+    mutable std::optional<std::string_view> last_function;
+    int calls = 0;
+
+    bool enabled(const log_pp::BasicMetadata<char>& metadata) const noexcept
+        override {
+        last_file = metadata.get_file();
+        last_function = metadata.get_module_path();
+        return true;
+    }
+
+    void log(const log_pp::BasicRecord<char>& record) noexcept override {
+        ++calls;
+        last_message =
+            std::vformat(record.get_format_string(), record.get_args());
+    }
+
+    void flush() noexcept override {}
+};
+
+struct Parser {
+    static void parse_header(CaptureLogger& logger, int n) {
+        LOG_PP_DEBUG(logger, "header {}", n);
+    }
+    static void skip(CaptureLogger& logger, int n) {
+        LOG_PP_DEBUG(logger, "skip {}", n);
+    }
+};
+
+void net_trace(CaptureLogger& logger, int n) {
+    LOG_PP_TRACE(logger, "trace {}", n);
+}
+
+}  // namespace
+
+TEST(log_pp_callsite, glob_match) {
+    EXPECT_TRUE(log_pp::glob_match("*", ""));
+    EXPECT_TRUE(log_pp::glob_match("src/net/*.cpp", "src/net/io.cpp"));
+    EXPECT_TRUE(log_pp::glob_match("src/net/*.cpp", "src/net/a/b.cpp"));
+    EXPECT_FALSE(log_pp::glob_match("src/net/*.cpp", "src/net/io.hpp"));
+    EXPECT_TRUE(log_pp::glob_match("Parser::parse*", "Parser::parse"));
+    EXPECT_TRUE(log_pp::glob_match("*::parse_?eader", "ns::P::parse_header"));
+    EXPECT_FALSE(log_pp::glob_match("Parser::parse*", "ns::Parser::parse"));
+    EXPECT_TRUE(log_pp::glob_match("a*b*c", "aXbYbZc"));
+    EXPECT_FALSE(log_pp::glob_match("a*b*c", "aXbYbZ"));
+}
+
+TEST(log_pp_callsite, qualified_function_name) {
+    EXPECT_EQ("ns::Parser::parse",
+              log_pp::qualified_function_name("void ns::Parser::parse(int)"));
+    EXPECT_EQ("f", log_pp::qualified_function_name("int* f()"));
+    EXPECT_EQ("Parser::parse",
+              log_pp::qualified_function_name(
+                  "void __cdecl Parser::parse(const std::string &)"));
+    EXPECT_EQ("ns::get", log_pp::qualified_function_name(
+                             "std::map<int, std::vector<int> > ns::get(T) "
+                             "[with T = int]"));
+    EXPECT_EQ("main", log_pp::qualified_function_name("main"));
+}
+
+TEST(log_pp_callsite, metadata_exposes_callsite) {
+    CaptureLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+    Parser::parse_header(logger, 1);
+    ASSERT_TRUE(logger.last_file.has_value());
+    EXPECT_NE(std::string_view::npos,
+              logger.last_file->find("callsite_test.cpp"));
+    ASSERT_TRUE(logger.last_function.has_value());
+    EXPECT_NE(std::string_view::npos,
+              log_pp::qualified_function_name(*logger.last_function)
+                  .find("Parser::parse_header"));
+}
+
+TEST(log_pp_callsite, rules_override_max_level) {
+    CaptureLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Info);
+
+    net_trace(logger, 1);
+    Parser::parse_header(logger, 1);
+    EXPECT_EQ(0, logger.calls);
+
+    // Cached callsites are re-evaluated when the rules change.
+    log_pp::set_callsite_rules({
+        {.file = "tests/*_test.cpp", .level = log_pp::LevelFilter::Trace},
+        {.function = "*Parser::parse*", .level = log_pp::LevelFilter::Debug},
+        {.function = "*Parser::skip", .level = log_pp::LevelFilter::Info},
+    });
+    net_trace(logger, 2);
+    EXPECT_EQ("trace 2", logger.last_message);
+    Parser::parse_header(logger, 2);
+    EXPECT_EQ("header 2", logger.last_message);
+    // The last matching rule wins.
+    Parser::skip(logger, 2);
+    EXPECT_EQ(2, logger.calls);
+
+    log_pp::set_callsite_rules({});
+    net_trace(logger, 3);
+    Parser::parse_header(logger, 3);
+    EXPECT_EQ(2, logger.calls);
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
@@ -0,0 +1,124 @@
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "clock.hpp"
+#include "log.hpp"
+#include "pattern_formatter.hpp"
+
+namespace {
+
+struct TimestampLogger : public log_pp::BasicLogger<char> {
+    bool accept = true;
+    int logged = 0;
+    std::optional<log_pp::Timestamp> last{};
+
+    bool enabled(const log_pp::BasicMetadata<char>&) const noexcept override {
+        return accept;
+    }
+
+    void log(const log_pp::BasicRecord<char>& record) override {
+        ++logged;
+        last = record.get_raw_timestamp();
+    }
+
+    void flush() override {}
+};
+
+std::chrono::nanoseconds distance_from_now(
+    std::chrono::system_clock::time_point time) {
+    auto diff = std::chrono::system_clock::now() - time;
+    return std::chrono::abs(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(diff));
+}
+
+// Restores the default clock when a test ends.
+struct ClockGuard {
+    ~ClockGuard() { log_pp::set_clock_source(log_pp::ClockSource::Realtime); }
+};
+
+}  // namespace
+
+TEST(log_pp_clock, realtime_is_default_and_matches_system_clock) {
+    EXPECT_EQ(log_pp::ClockSource::Realtime, log_pp::clock_source());
+    auto ts = log_pp::capture_timestamp();
+    EXPECT_EQ(log_pp::ClockSource::Realtime, ts.source);
+    EXPECT_LT(distance_from_now(log_pp::to_time_point(ts)),
+              std::chrono::milliseconds(100));
+}
+
+TEST(log_pp_clock, coarse_clock_is_close_to_realtime) {
+    ClockGuard guard;
+    ASSERT_TRUE(log_pp::set_clock_source(log_pp::ClockSource::RealtimeCoarse));
+    auto ts = log_pp::capture_timestamp();
+    EXPECT_EQ(log_pp::ClockSource::RealtimeCoarse, ts.source);
+    EXPECT_LT(distance_from_now(log_pp::to_time_point(ts)),
+              std::chrono::milliseconds(100));
+}
+
+TEST(log_pp_clock, tsc_converts_to_wall_time_when_available) {
+    ClockGuard guard;
+    if (!log_pp::set_clock_source(log_pp::ClockSource::Tsc)) {
+        EXPECT_EQ(log_pp::ClockSource::Realtime, log_pp::clock_source());
+        GTEST_SKIP() << "no invariant TSC on this machine";
+    }
+    auto first = log_pp::capture_timestamp();
+    auto second = log_pp::capture_timestamp();
+    EXPECT_EQ(log_pp::ClockSource::Tsc, first.source);
+    EXPECT_LE(log_pp::to_time_point(first), log_pp::to_time_point(second));
+    EXPECT_LT(distance_from_now(log_pp::to_time_point(second)),
+              std::chrono::milliseconds(100));
+}
+
+TEST(log_pp_clock, tsc_reanchors_after_an_interval) {
+    ClockGuard guard;
+    if (!log_pp::set_clock_source(log_pp::ClockSource::Tsc)) {
+        GTEST_SKIP() << "no invariant TSC on this machine";
+    }
+    auto before = log_pp::capture_timestamp();
+    auto before_time = log_pp::to_time_point(before);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    auto after = log_pp::capture_timestamp();
+    auto after_time = log_pp::to_time_point(after);
+    EXPECT_LT(distance_from_now(after_time), std::chrono::milliseconds(100));
+    // Timestamps taken before the new anchor still convert consistently.
+    EXPECT_LT(std::chrono::abs(log_pp::to_time_point(before) - before_time),
+              std::chrono::milliseconds(1));
+    EXPECT_GT(after_time - before_time, std::chrono::milliseconds(1000));
+}
+
+TEST(log_pp_clock, macros_capture_timestamp_only_for_enabled_records) {
+    TimestampLogger logger;
+    LOG_PP_INFO(logger, "enabled");
+    ASSERT_EQ(1, logger.logged);
+    ASSERT_TRUE(logger.last.has_value());
+    EXPECT_LT(distance_from_now(log_pp::to_time_point(*logger.last)),
+              std::chrono::milliseconds(100));
+
+    logger.accept = false;
+    logger.last.reset();
+    LOG_PP_INFO(logger, "disabled");
+    EXPECT_EQ(1, logger.logged);
+    EXPECT_FALSE(logger.last.has_value());
+}
+
+TEST(log_pp_clock, pattern_formatter_uses_record_timestamp) {
+    // 1970-01-02T03:04:05.006Z
+    constexpr uint64_t NS = ((24ull + 3) * 3600 + 4 * 60 + 5) * 1'000'000'000 +
+                            6'000'000;
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_format_string("x")
+                      .set_timestamp({NS, log_pp::ClockSource::Realtime})
+                      .build();
+    log_pp::PatternFormatter formatter("%Y-%m-%dT%H:%M:%S.%e");
+    std::string out;
+    formatter.encode(record, out);
+    EXPECT_EQ("1970-01-02T03:04:05.006\n", out);
+
+    auto unset = log_pp::RecordBuilder{}.build();
+    EXPECT_FALSE(unset.get_timestamp().has_value());
+}
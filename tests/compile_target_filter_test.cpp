@@ -0,0 +1,73 @@
+#include <format>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+
+namespace {
+
+struct CaptureLogger : public log_pp::BasicLogger<char> {
+    std::string last_message;
+    int calls = 0;
+
+    bool enabled(const log_pp::BasicMetadata<char>&) const noexcept override {
+        return true;
+    }
+
+    void log(const log_pp::BasicRecord<char>& record) noexcept override {
+        ++calls;
+        last_message =
+            std::vformat(record.get_format_string(), record.get_args());
+    }
+
+    void flush() noexcept override {}
+};
+
+using namespace std::string_view_literals;
+
+// Built with LOG_PP_LEVEL_FILTER_DEBUG and
+// LOG_PP_TARGET_LEVEL_FILTER="wire=info, db::pool=off, noisy=trace".
+static_assert(log_pp::get_comptime_level(""sv) == log_pp::LevelFilter::Debug);
+static_assert(log_pp::get_comptime_level("wire"sv) ==
+              log_pp::LevelFilter::Info);
+static_assert(log_pp::get_comptime_level("wire::frame"sv) ==
+              log_pp::LevelFilter::Info);
+static_assert(log_pp::get_comptime_level("wired"sv) ==
+              log_pp::LevelFilter::Debug);
+static_assert(log_pp::get_comptime_level("db::pool::conn"sv) ==
+              log_pp::LevelFilter::Off);
+static_assert(log_pp::get_comptime_level("db"sv) ==
+              log_pp::LevelFilter::Debug);
+static_assert(log_pp::get_comptime_level(L"noisy"sv) ==
+              log_pp::LevelFilter::Trace);
+
+static_assert(log_pp::detail::parse_target_levels<1>("a=warn").valid);
+static_assert(!log_pp::detail::parse_target_levels<1>("a").valid);
+static_assert(!log_pp::detail::parse_target_levels<1>("a=loud").valid);
+static_assert(!log_pp::detail::parse_target_levels<1>("=info").valid);
+static_assert(log_pp::detail::count_directives(" a=info,, b=off ,") == 2);
+
+}  // namespace
+
+TEST(log_pp_compile_target_filter, filters_per_target) {
+    CaptureLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+
+    LOG_PP_DEBUG(logger, {"wire"}, "wire debug");
+    LOG_PP_DEBUG(logger, {"wire::frame"}, "wire frame debug");
+    LOG_PP_ERROR(logger, {"db::pool"}, "pool error");
+    LOG_PP_TRACE(logger, {"app"}, "app trace");
+    EXPECT_EQ(0, logger.calls);
+
+    LOG_PP_INFO(logger, {"wire"}, "wire info");
+    EXPECT_EQ("wire info", logger.last_message);
+    LOG_PP_DEBUG(logger, {"app"}, "app debug");
+    EXPECT_EQ("app debug", logger.last_message);
+    LOG_PP_ERROR(logger, {"db"}, "db error");
+    EXPECT_EQ("db error", logger.last_message);
+    // A directive may also allow more than the build-wide level.
+    LOG_PP_TRACE(logger, {"noisy"}, "noisy trace");
+    EXPECT_EQ("noisy trace", logger.last_message);
+    EXPECT_EQ(4, logger.calls);
+}
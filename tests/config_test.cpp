@@ -0,0 +1,238 @@
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <source_location>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "config.hpp"
+#include "log.hpp"
+
+namespace {
+
+std::filesystem::path temp_log_dir(const char* name) {
+    auto dir = std::filesystem::temp_directory_path() / "log_pp_config" / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+void write_file(const std::filesystem::path& path, const std::string& text) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+}
+
+struct Parser {
+    static void parse(log_pp::ILogger& logger) {
+        LOG_PP_DEBUG(logger, "parsed");
+    }
+};
+
+}  // namespace
+
+TEST(log_pp_config, parses_sections) {
+    auto config = log_pp::parse_config(R"(
+; comment
+[log]
+level = info
+targets = db=debug, http::client=trace
+
+[callsite.parser]
+function = Parser::parse*
+level = debug
+
+[sink.main]
+type = file
+path = app.log
+encoder = pattern
+pattern = "%l %v "
+max_file_size = 1024
+level = warn
+)");
+    ASSERT_TRUE(config.has_value());
+    EXPECT_EQ("info,db=debug, http::client=trace", config->directives);
+    ASSERT_EQ(1u, config->callsites.size());
+    EXPECT_EQ("*", config->callsites[0].file);
+    EXPECT_EQ("Parser::parse*", config->callsites[0].function);
+    EXPECT_EQ(log_pp::LevelFilter::Debug, config->callsites[0].level);
+    ASSERT_EQ(1u, config->sinks.size());
+    const auto& sink = config->sinks[0];
+    EXPECT_EQ("main", sink.name);
+    EXPECT_EQ("app.log", sink.path);
+    EXPECT_EQ("%l %v ", sink.pattern);
+    EXPECT_EQ(1024u, sink.max_file_size);
+    EXPECT_EQ(log_pp::LevelFilter::Warn, sink.level);
+}
+
+TEST(log_pp_config, reports_errors_with_line) {
+    std::string error;
+    EXPECT_FALSE(log_pp::parse_config("[log]\nlevel = loud\n", &error));
+    EXPECT_EQ("line 2: unknown level `loud`", error);
+    EXPECT_FALSE(log_pp::parse_config("[log]\nlevle = info\n", &error));
+    EXPECT_EQ("line 2: unknown key `levle`", error);
+    EXPECT_FALSE(log_pp::parse_config("[sink.a]\ntype = file\n", &error));
+    EXPECT_EQ("line 1: file sink without `path`", error);
+    EXPECT_FALSE(log_pp::parse_config(
+        "[sink.a]\ntype = stdout\n[sink.a]\ntype = stderr\n", &error));
+    EXPECT_EQ("line 3: duplicate [sink.a]", error);
+    EXPECT_FALSE(log_pp::parse_config("[metrics]\n", &error));
+    EXPECT_EQ("line 1: unknown section [metrics]", error);
+}
+
+TEST(log_pp_config, reload_keeps_unchanged_sinks) {
+    auto dir = temp_log_dir("reload");
+    auto keep = (dir / "keep.log").string();
+    auto drop = (dir / "drop.log").string();
+    log_pp::ConfigLogger logger;
+    ASSERT_TRUE(logger.load(std::format(R"(
+[log]
+level = info
+[sink.keep]
+path = {}
+[sink.drop]
+path = {}
+)",
+                                        keep, drop)));
+    auto kept = logger.get_sink("keep");
+    ASSERT_NE(nullptr, kept);
+    LOG_PP_INFO(logger, {"app"}, "one");
+    LOG_PP_DEBUG(logger, {"app"}, "hidden");
+
+    ASSERT_TRUE(logger.load(std::format(R"(
+[log]
+level = info
+targets = app=debug
+[sink.keep]
+path = {}
+level = debug
+)",
+                                        keep)));
+    // Same section: same sink, buffer included, with the new level.
+    EXPECT_EQ(kept, logger.get_sink("keep"));
+    EXPECT_EQ(log_pp::LevelFilter::Debug, kept->get_level());
+    EXPECT_EQ(nullptr, logger.get_sink("drop"));
+    LOG_PP_DEBUG(logger, {"app"}, "two");
+    LOG_PP_TRACE(logger, {"app"}, "hidden");
+    logger.flush();
+    EXPECT_EQ("[INFO] [app] one\n[DEBUG] [app] two\n", read_file(keep));
+
+    // A bad config keeps the running one.
+    EXPECT_FALSE(logger.load("[log]\nlevel = loud\n"));
+    EXPECT_EQ("line 2: unknown level `loud`", logger.get_last_error());
+    EXPECT_EQ(kept, logger.get_sink("keep"));
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+TEST(log_pp_config, callsite_rules_raise_past_directives) {
+    auto dir = temp_log_dir("callsite");
+    auto path = (dir / "app.log").string();
+    log_pp::ConfigLogger logger;
+    ASSERT_TRUE(logger.load(std::format(R"(
+[log]
+level = info
+[callsite.parser]
+function = *Parser::parse
+level = debug
+[sink.main]
+path = {}
+level = info
+)",
+                                        path)));
+    Parser::parse(logger);
+    LOG_PP_DEBUG(logger, "elsewhere");
+    logger.flush();
+    EXPECT_EQ("[DEBUG] [] parsed\n", read_file(path));
+
+    log_pp::set_callsite_rules({});
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+TEST(log_pp_config, keeps_callsite_rules_set_from_code) {
+    auto dir = temp_log_dir("code_rules");
+    auto path = (dir / "app.log").string();
+    log_pp::set_callsite_rules({
+        {.function = "*Parser::parse", .level = log_pp::LevelFilter::Debug},
+    });
+    log_pp::ConfigLogger logger;
+    ASSERT_TRUE(logger.load(
+        std::format("[log]\nlevel = info\n[sink.main]\npath = {}\n", path)));
+    Parser::parse(logger);
+    logger.flush();
+    EXPECT_EQ("[DEBUG] [] parsed\n", read_file(path));
+
+    log_pp::set_callsite_rules({});
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+TEST(log_pp_config, reload_swaps_sinks_and_directives_together) {
+    auto dir = temp_log_dir("swap");
+    auto quiet = (dir / "quiet.log").string();
+    auto verbose = (dir / "verbose.log").string();
+    auto quiet_config = std::format("[log]\nlevel = info\n"
+                                    "[sink.quiet]\npath = {}\n",
+                                    quiet);
+    auto verbose_config = std::format("[log]\nlevel = debug\n"
+                                      "[sink.verbose]\npath = {}\n",
+                                      verbose);
+    log_pp::ConfigLogger logger;
+    ASSERT_TRUE(logger.load(verbose_config));
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            // Skips the global max level, which changes with each reload.
+            log_pp::log(log_pp::Level::Debug, std::source_location::current(),
+                        logger, {}, "debug");
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(logger.load(i % 2 == 0 ? quiet_config : verbose_config));
+    }
+    stop = true;
+    writer.join();
+    logger.flush();
+
+    // Debug records only ever pass the verbose config's directives.
+    EXPECT_EQ(std::string::npos, read_file(quiet).find("DEBUG"));
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+#if defined(__linux__)
+TEST(log_pp_config, watch_reloads_on_change) {
+    auto dir = temp_log_dir("watch");
+    auto path = dir / "log.ini";
+    write_file(path, "[log]\nlevel = warn\n");
+    log_pp::ConfigLogger logger;
+    ASSERT_TRUE(logger.watch(path));
+    EXPECT_EQ(log_pp::LevelFilter::Warn, log_pp::max_level());
+
+    // Save the way editors do: write a new file and rename it over.
+    write_file(dir / "log.ini.tmp", "[log]\nlevel = debug\n");
+    std::filesystem::rename(dir / "log.ini.tmp", path);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (log_pp::max_level() != log_pp::LevelFilter::Debug &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(log_pp::LevelFilter::Debug, log_pp::max_level());
+
+    write_file(path, "[log]\nlevel = error\n");
+    while (log_pp::max_level() != log_pp::LevelFilter::Error &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(log_pp::LevelFilter::Error, log_pp::max_level());
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+#endif
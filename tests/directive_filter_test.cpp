@@ -0,0 +1,111 @@
+#include <atomic>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "directive_filter.hpp"
+#include "log.hpp"
+
+namespace {
+
+bool allows(const log_pp::DirectiveFilter& filter,
+            log_pp::Level level,
+            std::string_view target) {
+    return filter.enabled(log_pp::Metadata{level, target});
+}
+
+}  // namespace
+
+TEST(log_pp_directive_filter, parses_level_names) {
+    EXPECT_EQ(log_pp::LevelFilter::Off, log_pp::parse_level_filter("off"));
+    EXPECT_EQ(log_pp::LevelFilter::Warn, log_pp::parse_level_filter("WARN"));
+    EXPECT_EQ(log_pp::LevelFilter::Warn,
+              log_pp::parse_level_filter("Warning"));
+    EXPECT_EQ(log_pp::LevelFilter::Trace,
+              log_pp::parse_level_filter(std::wstring_view(L"trace")));
+    EXPECT_FALSE(log_pp::parse_level_filter("verbose"));
+    EXPECT_FALSE(log_pp::parse_level_filter(""));
+}
+
+TEST(log_pp_directive_filter, most_specific_directive_wins) {
+    log_pp::DirectiveFilter filter(
+        " info, db=debug ,db::pool=trace,http=warn,audit");
+
+    EXPECT_EQ(log_pp::LevelFilter::Info, filter.level_for("app"));
+    EXPECT_EQ(log_pp::LevelFilter::Info, filter.level_for(""));
+    EXPECT_EQ(log_pp::LevelFilter::Debug, filter.level_for("db"));
+    EXPECT_EQ(log_pp::LevelFilter::Debug, filter.level_for("db::query"));
+    EXPECT_EQ(log_pp::LevelFilter::Trace, filter.level_for("db::pool"));
+    EXPECT_EQ(log_pp::LevelFilter::Trace, filter.level_for("db::pool::conn"));
+    // Hierarchy follows `::` boundaries, not raw prefixes.
+    EXPECT_EQ(log_pp::LevelFilter::Info, filter.level_for("dbx"));
+    EXPECT_EQ(log_pp::LevelFilter::Debug, filter.level_for("db::poolx"));
+    EXPECT_EQ(log_pp::LevelFilter::Warn, filter.level_for("http"));
+    EXPECT_EQ(log_pp::LevelFilter::Trace, filter.level_for("audit"));
+
+    EXPECT_TRUE(allows(filter, log_pp::Level::Debug, "db::query"));
+    EXPECT_FALSE(allows(filter, log_pp::Level::Trace, "db::query"));
+    EXPECT_FALSE(allows(filter, log_pp::Level::Info, "http::client"));
+    EXPECT_TRUE(allows(filter, log_pp::Level::Warning, "http::client"));
+    EXPECT_FALSE(allows(filter, log_pp::Level::Debug, "app"));
+}
+
+TEST(log_pp_directive_filter, reload_feeds_max_level) {
+    log_pp::DirectiveFilter filter;
+    EXPECT_EQ(log_pp::LevelFilter::Error, filter.level_for("app"));
+
+    ASSERT_TRUE(filter.reload("warn,db=debug", true));
+    EXPECT_EQ(log_pp::LevelFilter::Debug, filter.max_level());
+    EXPECT_EQ(log_pp::LevelFilter::Debug, log_pp::max_level());
+
+    ASSERT_TRUE(filter.reload("off,http=info", true));
+    EXPECT_EQ(log_pp::LevelFilter::Info, log_pp::max_level());
+    EXPECT_FALSE(allows(filter, log_pp::Level::Error, "db"));
+    EXPECT_TRUE(allows(filter, log_pp::Level::Info, "http"));
+
+    // Invalid specs keep the current directives and max level.
+    EXPECT_FALSE(filter.reload("trace,db=loud", true));
+    EXPECT_FALSE(filter.reload("=debug", true));
+    EXPECT_EQ(log_pp::LevelFilter::Info, log_pp::max_level());
+    EXPECT_EQ(log_pp::LevelFilter::Info, filter.level_for("http"));
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+TEST(log_pp_directive_filter, leaves_max_level_alone_by_default) {
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+    log_pp::DirectiveFilter filter("warn");
+    ASSERT_TRUE(filter.reload("error,db=info"));
+    EXPECT_EQ(log_pp::LevelFilter::Info, filter.max_level());
+    EXPECT_EQ(log_pp::LevelFilter::Trace, log_pp::max_level());
+}
+
+TEST(log_pp_directive_filter, reload_while_reading) {
+    log_pp::DirectiveFilter filter("error,db=debug");
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                // Every published spec keeps Debug for `db` and nothing
+                // more verbose than Debug anywhere.
+                if (!allows(filter, log_pp::Level::Debug, "db::pool") ||
+                    allows(filter, log_pp::Level::Trace, "db::pool")) {
+                    bad.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 2000; ++i) {
+        ASSERT_TRUE(filter.reload(i % 2 == 0 ? "info,db=debug,http=warn"
+                                             : "db=debug,db::pool=debug"));
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(0, bad.load());
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
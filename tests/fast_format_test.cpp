@@ -0,0 +1,129 @@
+#include <format>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "encoder.hpp"
+#include "fast_format.hpp"
+#include "log.hpp"
+
+namespace {
+
+template <typename... Args>
+std::string render_fast(std::string_view format, Args... args) {
+    std::string out = "prefix:";
+    bool fast = log_pp::detail::append_fast_vformat(
+        out, format, std::format_args(std::make_format_args(args...)));
+    EXPECT_TRUE(fast) << format;
+    return out.substr(7);
+}
+
+template <typename... Args>
+void expect_like_std_format(std::string_view format, Args... args) {
+    EXPECT_EQ(render_fast(format, args...),
+              std::vformat(format, std::make_format_args(args...)))
+        << format;
+}
+
+template <typename... Args>
+bool takes_fast_path(std::string_view format, Args... args) {
+    std::string out = "keep";
+    bool fast = log_pp::detail::append_fast_vformat(
+        out, format, std::format_args(std::make_format_args(args...)));
+    if (!fast) {
+        EXPECT_EQ(out, "keep");
+    }
+    return fast;
+}
+
+}  // namespace
+
+TEST(log_pp_fast_format, integers_match_std_format) {
+    expect_like_std_format("{}", 42);
+    expect_like_std_format("{}", -42);
+    expect_like_std_format("{:d}", 7u);
+    expect_like_std_format("{:x}", 255);
+    expect_like_std_format("{:X}", 48879u);
+    expect_like_std_format("{:04X}", 255);
+    expect_like_std_format("{:08x}", -255);
+    expect_like_std_format("{:b}", 5);
+    expect_like_std_format("{:o}", 64);
+    expect_like_std_format("{:6}", -12);
+    expect_like_std_format("{}", std::numeric_limits<long long>::min());
+    expect_like_std_format("{}",
+                           std::numeric_limits<unsigned long long>::max());
+}
+
+TEST(log_pp_fast_format, floats_match_std_format) {
+    expect_like_std_format("{}", 1.25);
+    expect_like_std_format("{}", 0.1f);
+    expect_like_std_format("{}", 1e300);
+    expect_like_std_format("{:.2f}", 1.236);
+    expect_like_std_format("{:.0f}", 2.5);
+    expect_like_std_format("{:f}", 3.0);
+    expect_like_std_format("{:e}", 12345.678);
+    expect_like_std_format("{:.3E}", 0.000123);
+    expect_like_std_format("{:g}", 1e-7);
+    expect_like_std_format("{:08.3f}", -3.14159);
+    expect_like_std_format("{}", std::numeric_limits<double>::infinity());
+}
+
+TEST(log_pp_fast_format, mixed_fields_match_std_format) {
+    expect_like_std_format("ok={} id={:x} {:c} {{literal}} {}", true, 1, 'x',
+                           3);
+    expect_like_std_format("{1} before {0}", 1, 2);
+}
+
+TEST(log_pp_fast_format, strings_are_copied_through) {
+    const char* path = "/api";
+    std::string out;
+    log_pp::detail::FastSpec spec;
+    EXPECT_TRUE(log_pp::detail::append_fast<char>(
+        out, std::string_view("alice "), spec));
+    EXPECT_TRUE(log_pp::detail::append_fast<char>(out, path, spec));
+    EXPECT_EQ(out, "alice /api");
+
+    spec.width = 8;
+    EXPECT_FALSE(log_pp::detail::append_fast<char>(out, path, spec));
+    EXPECT_EQ(out, "alice /api");
+}
+
+TEST(log_pp_fast_format, falls_back_for_unsupported_specs) {
+    EXPECT_TRUE(takes_fast_path("{:04X} {:.2f} {}", 255, 1.5, true));
+    EXPECT_FALSE(takes_fast_path("{:>8}", 1));
+    EXPECT_FALSE(takes_fast_path("{:+}", 1));
+    EXPECT_FALSE(takes_fast_path("{:#x}", 1));
+    EXPECT_FALSE(takes_fast_path("{:10}", std::string_view("text")));
+    EXPECT_FALSE(takes_fast_path("{:d}", true));
+    EXPECT_FALSE(takes_fast_path("{:.2}", 1.5));
+    EXPECT_FALSE(takes_fast_path("{:{}}", 1, 4));
+    EXPECT_FALSE(takes_fast_path("{} {0}", 1));
+    EXPECT_FALSE(takes_fast_path("{}", static_cast<const void*>(nullptr)));
+}
+
+TEST(log_pp_fast_format, messages_render_through_fast_path) {
+    int id = 255;
+    double ratio = 1.236;
+    int count = 7;
+    auto args = std::make_format_args(id, ratio, count);
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_format_string("id={:04X} ratio={:.2f} {:>3}")
+                      .set_args(args)
+                      .build();
+    std::string out;
+    log_pp::detail::append_message(out, record);
+    // The last field needs alignment, so the whole message takes
+    // std::format and still renders correctly.
+    EXPECT_EQ(out, std::vformat("id={:04X} ratio={:.2f} {:>3}", args));
+}
+
+TEST(log_pp_fast_format, kv_specs_render_through_fast_path) {
+    EXPECT_EQ(log_pp::KV("id", 255, "0x{:04X}").get_value_string(), "0x00FF");
+    EXPECT_EQ(log_pp::KV("ratio", 1.236, "{:.2f}").get_value_string(), "1.24");
+    EXPECT_EQ(log_pp::KV("ratio", 1.236, "{:>6.2f}").get_value_string(),
+              "  1.24");
+    EXPECT_EQ(log_pp::KV("ok", true, "[{}]").get_value_string(), "[true]");
+}
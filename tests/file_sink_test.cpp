@@ -0,0 +1,64 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "file_sink.hpp"
+#include "log.hpp"
+
+namespace {
+
+std::filesystem::path temp_log_dir(const char* name) {
+    auto dir = std::filesystem::temp_directory_path() / "log_pp_file_sink" / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+}  // namespace
+
+TEST(log_pp_file_sink, buffers_until_flush) {
+    auto dir = temp_log_dir("buffer");
+    log_pp::FileSink sink(std::make_shared<log_pp::TextEncoder>(),
+                          {.path = dir / "app.log", .buffer_size = 1024});
+    ASSERT_TRUE(sink.is_open());
+
+    LOG_PP_INFO(sink, {"db"}, "hello {}", 1);
+    EXPECT_EQ("", read_file(dir / "app.log"));
+
+    sink.flush();
+    EXPECT_EQ("[INFO] [db] hello 1\n", read_file(dir / "app.log"));
+}
+
+TEST(log_pp_file_sink, rotates_without_splitting_records) {
+    auto dir = temp_log_dir("rotate");
+    {
+        log_pp::FileSink sink(std::make_shared<log_pp::TextEncoder>(),
+                              {.path = dir / "app.log",
+                               .buffer_size = 16,
+                               .max_file_size = 40,
+                               .max_files = 2});
+        for (int i = 0; i < 6; ++i) {
+            LOG_PP_INFO(sink, "line {}", i);
+        }
+    }
+
+    // Each record is "[INFO] [] line N\n" (17 bytes), so two fit per file.
+    EXPECT_EQ("[INFO] [] line 4\n[INFO] [] line 5\n",
+              read_file(dir / "app.log"));
+    EXPECT_EQ("[INFO] [] line 2\n[INFO] [] line 3\n",
+              read_file(dir / "app.log.1"));
+    EXPECT_EQ("[INFO] [] line 0\n[INFO] [] line 1\n",
+              read_file(dir / "app.log.2"));
+    EXPECT_FALSE(std::filesystem::exists(dir / "app.log.3"));
+}
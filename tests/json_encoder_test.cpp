@@ -0,0 +1,131 @@
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "json_encoder.hpp"
+#include "log.hpp"
+#include "text_scan.hpp"
+
+namespace {
+
+std::string encode(const log_pp::Record& record) {
+    std::string out;
+    log_pp::JsonEncoder{}.encode(record, out);
+    return out;
+}
+
+log_pp::Record make_record(std::string_view message,
+                           const log_pp::KVList& kvs = {}) {
+    return log_pp::RecordBuilder{}
+        .set_level(log_pp::Level::Info)
+        .set_target("db")
+        .set_format_string(message)
+        .set_kvs(kvs)
+        .build();
+}
+
+std::string escape(std::string_view text) {
+    std::string out;
+    log_pp::detail::append_json_escaped(out, text);
+    return out;
+}
+
+}  // namespace
+
+TEST(log_pp_json_encoder, writes_one_object_per_line) {
+    EXPECT_EQ(R"({"level":"INFO","target":"db","message":"connected"})"
+              "\n",
+              encode(make_record("connected")));
+}
+
+TEST(log_pp_json_encoder, writes_source_location) {
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Error)
+                      .set_format_string("x")
+                      .set_module(std::source_location::current())
+                      .build();
+    auto out = encode(record);
+    EXPECT_NE(std::string::npos, out.find("json_encoder_test.cpp\",\"line\":" +
+                                          std::to_string(*record.get_line()) +
+                                          ",\"message\":\"x\""))
+        << out;
+}
+
+TEST(log_pp_json_encoder, numeric_fields_are_unquoted) {
+    int attempts = 3;
+    log_pp::KVList kvs{{"attempts", attempts},
+                       {"ratio", 0.5},
+                       {"ok", true},
+                       {"host", "a\"b"},
+                       {"hex", 255, "0x{:X}"},
+                       {"letter", 'c'}};
+    EXPECT_EQ(R"({"level":"INFO","target":"db","message":"m","fields":)"
+              R"({"attempts":3,"ratio":0.5,"ok":true,"host":"a\"b",)"
+              R"("hex":"0xFF","letter":"c"}})"
+              "\n",
+              encode(make_record("m", kvs)));
+}
+
+TEST(log_pp_json_encoder, non_finite_numbers_are_strings) {
+    log_pp::KVList kvs{{"v", std::numeric_limits<double>::infinity()}};
+    EXPECT_NE(std::string::npos, encode(make_record("m", kvs))
+                                     .find(R"("fields":{"v":"inf"})"));
+}
+
+TEST(log_pp_json_encoder, escapes_message_after_formatting) {
+    int value = 1;
+    auto args = std::make_format_args(value);
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_format_string("line {}\n\t\"quoted\" \\ \x01")
+                      .set_args(args)
+                      .build();
+    EXPECT_NE(std::string::npos,
+              encode(record).find(
+                  R"("message":"line 1\n\t\"quoted\" \\ \u0001")"));
+}
+
+TEST(log_pp_json_encoder, escaping_handles_utf8) {
+    EXPECT_EQ("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80",
+              escape("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80"));
+    // Stray continuation, truncated sequence, overlong and surrogate forms.
+    EXPECT_EQ("a\xEF\xBF\xBD" "b", escape("a\x80" "b"));
+    EXPECT_EQ("a\xEF\xBF\xBD", escape("a\xE2\x82"));
+    EXPECT_EQ("\xEF\xBF\xBD\xEF\xBF\xBD", escape("\xC0\xAF"));
+    EXPECT_EQ("\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD", escape("\xED\xA0\x80"));
+}
+
+TEST(log_pp_json_encoder, vector_scan_matches_scalar_scan) {
+    std::mt19937 rng(7);
+    const char alphabet[] = "abcdefgh \"\\\n\x01\x7f\xc3\xa9";
+    for (int round = 0; round < 2000; ++round) {
+        std::string text(rng() % 70, 'x');
+        for (auto& ch : text) {
+            if (rng() % 8 == 0) {
+                ch = alphabet[rng() % (sizeof(alphabet) - 1)];
+            }
+        }
+        for (std::size_t pos = 0; pos <= text.size(); pos += 5) {
+            ASSERT_EQ(log_pp::detail::find_byte_class_scalar(
+                          text, pos, log_pp::detail::JSON_SPECIAL),
+                      log_pp::detail::find_byte_class(
+                          text, pos, log_pp::detail::JSON_SPECIAL))
+                << text;
+        }
+    }
+}
+
+TEST(log_pp_json_encoder, supports_wide_characters) {
+    auto record = log_pp::BasicRecordBuilder<wchar_t>{}
+                      .set_level(log_pp::Level::Warning)
+                      .set_target(L"w")
+                      .set_format_string(L"say \"hi\"")
+                      .build();
+    std::wstring out;
+    log_pp::BasicJsonEncoder<wchar_t>{}.encode(record, out);
+    EXPECT_EQ(
+        L"{\"level\":\"WARNING\",\"target\":\"w\",\"message\":\"say "
+        L"\\\"hi\\\"\"}\n",
+        out);
+}
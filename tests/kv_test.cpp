@@ -1,6 +1,8 @@
 #include <format>
+#include <memory_resource>
 #include <string>
 #include <string_view>
+#include <variant>
 
 #include <gtest/gtest.h>
 
@@ -200,6 +202,21 @@ TEST(log_pp_kv, kv_keeps_rvalue_value_by_ownership) {
     EXPECT_EQ("alice", kv.get_value_string());
 }
 
+TEST(log_pp_kv, kv_owns_temporary_string_like_values) {
+    struct Name {
+        std::string text;
+        operator std::string_view() const { return text; }
+    };
+    log_pp::KV pmr{"pmr", std::pmr::string(64, 'p')};
+    log_pp::KV name{"name", Name{std::string(64, 'n')}};
+    // Reuse the freed storage before reading the values back.
+    std::string reused(64, 'x');
+
+    EXPECT_EQ(std::string(64, 'p'),
+              std::get<std::string_view>(pmr.get_value()));
+    EXPECT_EQ(std::string(64, 'n'), name.get_value_string());
+}
+
 TEST(log_pp_kv, wchar_kv_only_with_explicit_logger_without_target) {
     static CaptureLogger<wchar_t> logger;
 
@@ -222,3 +239,56 @@ TEST(log_pp_kv, wchar_kv_only_with_explicit_logger_with_target) {
     EXPECT_EQ(L"", logger.last_message);
     EXPECT_EQ(L"status=ok;attempt=2", logger.last_kv_dump);
 }
+
+TEST(log_pp_kv, kv_keeps_native_value_category) {
+    int count = -3;
+    unsigned short port = 8080;
+    std::string host = "db1";
+    log_pp::KVList kvs{{"count", count},  {"port", port},
+                       {"ratio", 0.25},   {"scale", 1.5f},
+                       {"ok", true},      {"host", host},
+                       {"zone", "eu-1"},  {"id", 255, "{:X}"},
+                       {"owned", std::string{"tmp"}}};
+
+    EXPECT_EQ(-3, std::get<int64_t>(kvs[0].get_value()));
+    EXPECT_EQ(8080u, std::get<uint64_t>(kvs[1].get_value()));
+    EXPECT_EQ(0.25, std::get<double>(kvs[2].get_value()));
+    EXPECT_EQ(1.5f, std::get<float>(kvs[3].get_value()));
+    EXPECT_TRUE(std::get<bool>(kvs[4].get_value()));
+    EXPECT_EQ("db1", std::get<std::string_view>(kvs[5].get_value()));
+    EXPECT_EQ("eu-1", std::get<std::string_view>(kvs[6].get_value()));
+    EXPECT_EQ("FF", std::get<log_pp::BasicKVCustom<char>>(kvs[7].get_value())
+                        .to_string());
+    EXPECT_EQ("tmp", std::get<std::string_view>(kvs[8].get_value()));
+
+    host = "db2";
+    EXPECT_EQ("db2", std::get<std::string_view>(kvs[5].get_value()));
+}
+
+TEST(log_pp_kv, kv_visit_sees_native_types) {
+    log_pp::KV kv{"n", 42};
+    std::string seen;
+    kv.visit([&](const auto& value) {
+        using V = std::remove_cvref_t<decltype(value)>;
+        if constexpr (std::same_as<V, int64_t>) {
+            seen = "int64:" + std::to_string(value);
+        } else {
+            seen = "other";
+        }
+    });
+    EXPECT_EQ("int64:42", seen);
+}
+
+TEST(log_pp_kv, kv_native_values_format_like_std_format) {
+    log_pp::KVList kvs{{"f", 0.1f}, {"d", 1e21}, {"neg", -7}, {"b", false},
+                       {"c", 'x'}};
+    for (const auto& kv : kvs) {
+        std::string expected =
+            kv.get_key_str() == "f"     ? std::format("{}", 0.1f)
+            : kv.get_key_str() == "d"   ? std::format("{}", 1e21)
+            : kv.get_key_str() == "neg" ? std::format("{}", -7)
+            : kv.get_key_str() == "b"   ? std::format("{}", false)
+                                        : std::format("{}", 'x');
+        EXPECT_EQ(expected, kv.get_value_string()) << kv.get_key_str();
+    }
+}
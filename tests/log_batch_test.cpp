@@ -0,0 +1,151 @@
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "file_sink.hpp"
+#include "log.hpp"
+#include "router_logger.hpp"
+#include "tee_logger.hpp"
+
+namespace {
+
+struct RecordingLogger : public log_pp::ILogger {
+    std::vector<std::string> messages{};
+
+    bool enabled(const log_pp::Metadata&) const noexcept override {
+        return true;
+    }
+    void log(const log_pp::Record& record) override {
+        messages.emplace_back(record.get_format_string());
+    }
+    void flush() override {}
+};
+
+struct BatchRecorder : public log_pp::ILogger {
+    std::vector<std::size_t> batches{};
+
+    bool enabled(const log_pp::Metadata&) const noexcept override {
+        return true;
+    }
+    void log(const log_pp::Record&) override { batches.push_back(1); }
+    void log_batch(std::span<const log_pp::Record> records) override {
+        batches.push_back(records.size());
+    }
+    void flush() override {}
+};
+
+struct CaptureSink : public log_pp::Sink {
+    std::vector<std::string> writes{};
+
+    CaptureSink() : log_pp::Sink(std::make_shared<log_pp::TextEncoder>()) {}
+    explicit CaptureSink(std::shared_ptr<const log_pp::Encoder> encoder)
+        : log_pp::Sink(std::move(encoder)) {}
+
+    void write(std::string_view bytes) override { writes.emplace_back(bytes); }
+    void flush() override {}
+};
+
+std::vector<log_pp::Record> make_records() {
+    return {
+        log_pp::RecordBuilder{}
+            .set_level(log_pp::Level::Info)
+            .set_target("db")
+            .set_format_string("first")
+            .build(),
+        log_pp::RecordBuilder{}
+            .set_level(log_pp::Level::Warning)
+            .set_format_string("second")
+            .build(),
+        log_pp::RecordBuilder{}
+            .set_level(log_pp::Level::Error)
+            .set_format_string("third")
+            .build(),
+    };
+}
+
+}  // namespace
+
+TEST(log_pp_log_batch, default_forwards_each_record_to_log) {
+    RecordingLogger logger;
+    auto records = make_records();
+    logger.log_batch(records);
+    EXPECT_EQ((std::vector<std::string>{"first", "second", "third"}),
+              logger.messages);
+}
+
+TEST(log_pp_log_batch, sink_encodes_batch_into_one_write) {
+    CaptureSink sink;
+    auto records = make_records();
+    sink.log_batch(records);
+    ASSERT_EQ(1u, sink.writes.size());
+    EXPECT_EQ(
+        "[INFO] [db] first\n[WARNING] [] second\n[ERROR] [] third\n",
+        sink.writes[0]);
+
+    sink.log_batch({});
+    EXPECT_EQ(1u, sink.writes.size());
+}
+
+TEST(log_pp_log_batch, file_sink_writes_batch) {
+    auto path = (std::filesystem::temp_directory_path() / "log_pp_batch.log")
+                    .string();
+    std::filesystem::remove(path);
+    {
+        log_pp::FileSink sink(std::make_shared<log_pp::TextEncoder>(),
+                              {.path = path});
+        auto records = make_records();
+        sink.log_batch(records);
+    }
+    std::ifstream in(path);
+    std::string content((std::istreambuf_iterator<char>(in)),
+                        std::istreambuf_iterator<char>());
+    EXPECT_EQ(
+        "[INFO] [db] first\n[WARNING] [] second\n[ERROR] [] third\n",
+        content);
+    std::filesystem::remove(path);
+}
+
+TEST(log_pp_log_batch, tee_encodes_batch_once_per_encoder) {
+    auto encoder = std::make_shared<log_pp::TextEncoder>();
+    auto all = std::make_shared<CaptureSink>(encoder);
+    auto also_all = std::make_shared<CaptureSink>(encoder);
+    auto warn = std::make_shared<CaptureSink>(encoder);
+    warn->set_level(log_pp::LevelFilter::Warn);
+    log_pp::TeeLogger tee;
+    tee.add_sink(all);
+    tee.add_sink(also_all);
+    tee.add_sink(warn);
+
+    auto records = make_records();
+    tee.log_batch(records);
+
+    const std::string expected =
+        "[INFO] [db] first\n[WARNING] [] second\n[ERROR] [] third\n";
+    ASSERT_EQ(1u, all->writes.size());
+    EXPECT_EQ(expected, all->writes[0]);
+    EXPECT_EQ(all->writes, also_all->writes);
+    // The run the warn sink accepts still arrives as one write.
+    ASSERT_EQ(1u, warn->writes.size());
+    EXPECT_EQ("[WARNING] [] second\n[ERROR] [] third\n", warn->writes[0]);
+}
+
+TEST(log_pp_log_batch, router_forwards_runs_per_route) {
+    auto db = std::make_shared<BatchRecorder>();
+    auto rest = std::make_shared<BatchRecorder>();
+    log_pp::RouterLogger router;
+    router.add_route("db", db);
+    router.set_fallback(rest);
+
+    auto records = make_records();
+    records.push_back(records[0]);
+    router.log_batch(records);
+
+    EXPECT_EQ((std::vector<std::size_t>{1, 1}), db->batches);
+    EXPECT_EQ((std::vector<std::size_t>{2}), rest->batches);
+}
@@ -0,0 +1,88 @@
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+#include "logfmt_encoder.hpp"
+#include "sink.hpp"
+
+namespace {
+
+std::string encode(const log_pp::Record& record) {
+    std::string out;
+    log_pp::LogfmtEncoder{}.encode(record, out);
+    return out;
+}
+
+log_pp::Record make_record(std::string_view target,
+                           std::string_view message,
+                           const log_pp::KVList& kvs = {}) {
+    return log_pp::RecordBuilder{}
+        .set_level(log_pp::Level::Info)
+        .set_target(target)
+        .set_format_string(message)
+        .set_kvs(kvs)
+        .build();
+}
+
+struct CaptureSink : public log_pp::Sink {
+    std::string out{};
+
+    CaptureSink() : log_pp::Sink(std::make_shared<log_pp::LogfmtEncoder>()) {}
+
+    void write(std::string_view bytes) override { out += bytes; }
+    void flush() override {}
+};
+
+}  // namespace
+
+TEST(log_pp_logfmt_encoder, bare_values_are_not_quoted) {
+    int request_id = 42;
+    log_pp::KVList kvs{{"request_id", request_id}, {"ok", true}};
+    EXPECT_EQ("level=info target=db msg=connected request_id=42 ok=true\n",
+              encode(make_record("db", "connected", kvs)));
+}
+
+TEST(log_pp_logfmt_encoder, quotes_only_values_that_need_it) {
+    log_pp::KVList kvs{{"path", "/a b"},
+                       {"expr", "x=1"},
+                       {"empty", ""},
+                       {"quote", "say \"hi\""},
+                       {"utf8", "caf\xC3\xA9"}};
+    EXPECT_EQ(
+        "level=info target=\"\" msg=\"two words\" path=\"/a b\" expr=\"x=1\" "
+        "empty=\"\" quote=\"say \\\"hi\\\"\" utf8=caf\xC3\xA9\n",
+        encode(make_record("", "two words", kvs)));
+}
+
+TEST(log_pp_logfmt_encoder, escapes_control_characters) {
+    EXPECT_EQ("level=info target=t msg=\"a\\nb\\tc\\u0001\"\n",
+              encode(make_record("t", "a\nb\tc\x01")));
+}
+
+TEST(log_pp_logfmt_encoder, long_values_are_scanned_past_first_block) {
+    std::string clean(40, 'x');
+    std::string spaced = clean + " tail";
+    EXPECT_EQ("level=info target=t msg=" + clean + "\n",
+              encode(make_record("t", clean)));
+    EXPECT_EQ("level=info target=t msg=\"" + spaced + "\"\n",
+              encode(make_record("t", spaced)));
+}
+
+TEST(log_pp_logfmt_encoder, plugs_into_sinks) {
+    CaptureSink sink;
+    LOG_PP_WARN(sink, {"db"}, "pool at {}%", 95);
+    EXPECT_EQ("level=warn target=db msg=\"pool at 95%\"\n", sink.out);
+}
+
+TEST(log_pp_logfmt_encoder, supports_wide_characters) {
+    auto record = log_pp::BasicRecordBuilder<wchar_t>{}
+                      .set_level(log_pp::Level::Error)
+                      .set_target(L"w")
+                      .set_format_string(L"a b")
+                      .build();
+    std::wstring out;
+    log_pp::BasicLogfmtEncoder<wchar_t>{}.encode(record, out);
+    EXPECT_EQ(L"level=error target=w msg=\"a b\"\n", out);
+}
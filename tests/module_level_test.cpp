@@ -0,0 +1,69 @@
+#define LOG_PP_MODULE_LEVEL Warn
+#define LOG_PP_RELEASE_MODULE_LEVEL Error
+
+#include <format>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+
+namespace {
+
+struct CaptureLogger : public log_pp::BasicLogger<char> {
+    std::string last_message;
+    int calls = 0;
+
+    bool enabled(const log_pp::BasicMetadata<char>&) const noexcept override {
+        return true;
+    }
+
+    void log(const log_pp::BasicRecord<char>& record) noexcept override {
+        ++calls;
+        last_message =
+            std::vformat(record.get_format_string(), record.get_args());
+    }
+
+    void flush() noexcept override {}
+};
+
+int next_id(int& counter) {
+    return ++counter;
+}
+
+}  // namespace
+
+TEST(log_pp_module_level, caps_statements_in_this_file) {
+    CaptureLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+    int counter = 0;
+
+    LOG_PP_INFO(logger, "info {}", next_id(counter));
+    LOG_PP_DEBUG(logger, {"db"}, "debug {}", next_id(counter));
+    EXPECT_EQ(0, logger.calls);
+    // Filtered statements do not evaluate their arguments.
+    EXPECT_EQ(0, counter);
+
+    LOG_PP_ERROR(logger, "error {}", next_id(counter));
+    EXPECT_EQ("error 1", logger.last_message);
+
+    LOG_PP_WARN(logger, "warn {}", next_id(counter));
+#ifdef NDEBUG
+    EXPECT_EQ(1, logger.calls);
+#else
+    EXPECT_EQ("warn 2", logger.last_message);
+    EXPECT_EQ(2, logger.calls);
+#endif
+}
+
+TEST(log_pp_module_level, applies_to_runtime_levels) {
+    CaptureLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+
+    for (auto level : {log_pp::Level::Trace, log_pp::Level::Info,
+                       log_pp::Level::Error}) {
+        LOG_PP(level, logger, "level {}", level);
+    }
+    EXPECT_EQ(1, logger.calls);
+    EXPECT_EQ("level ERROR", logger.last_message);
+}
@@ -0,0 +1,124 @@
+#include <format>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+#include "named_logger.hpp"
+
+namespace {
+
+struct CaptureLogger : public log_pp::BasicLogger<char> {
+    std::string last_message;
+    int calls = 0;
+
+    bool enabled(const log_pp::BasicMetadata<char>&) const noexcept override {
+        return true;
+    }
+
+    void log(const log_pp::BasicRecord<char>& record) noexcept override {
+        ++calls;
+        last_message =
+            std::vformat(record.get_format_string(), record.get_args());
+    }
+
+    void flush() noexcept override {}
+};
+
+CaptureLogger g_global_logger;
+
+void log_wal(int n) {
+    LOG_PP_INFO(LOG_PP_NAMED("storage::wal"), "wal {}", n);
+}
+
+}  // namespace
+
+TEST(log_pp_named_logger, falls_back_along_hierarchy) {
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+    log_pp::set_logger(g_global_logger);
+
+    // Unregistered names go to the global logger.
+    log_wal(1);
+    EXPECT_EQ("wal 1", g_global_logger.last_message);
+
+    auto storage = std::make_shared<CaptureLogger>();
+    log_pp::register_logger("storage", storage);
+    log_wal(2);
+    EXPECT_EQ("wal 2", storage->last_message);
+
+    auto wal = std::make_shared<CaptureLogger>();
+    log_pp::register_logger("storage::wal", wal);
+    log_wal(3);
+    EXPECT_EQ("wal 3", wal->last_message);
+    EXPECT_EQ(1, storage->calls);
+
+    EXPECT_TRUE(log_pp::unregister_logger("storage::wal"));
+    EXPECT_FALSE(log_pp::unregister_logger("storage::wal"));
+    log_wal(4);
+    EXPECT_EQ("wal 4", storage->last_message);
+
+    EXPECT_TRUE(log_pp::unregister_logger("storage"));
+    log_wal(5);
+    EXPECT_EQ("wal 5", g_global_logger.last_message);
+}
+
+TEST(log_pp_named_logger, handles_are_stable) {
+    auto& rpc = log_pp::named_logger("rpc");
+    EXPECT_EQ(&rpc, &log_pp::named_logger(std::string_view("rpc")));
+    EXPECT_EQ("rpc", rpc.get_name());
+    // A prefix without a `::` boundary is not a parent.
+    auto rp = std::make_shared<CaptureLogger>();
+    log_pp::register_logger("rp", rp);
+    LOG_PP_WARN(rpc, "rpc");
+    EXPECT_EQ(0, rp->calls);
+
+    // The root name overrides the global logger for every handle.
+    auto root = std::make_shared<CaptureLogger>();
+    log_pp::register_logger("", root);
+    LOG_PP_WARN(rpc, "root");
+    EXPECT_EQ("root", root->last_message);
+    log_pp::unregister_logger("");
+    log_pp::unregister_logger("rp");
+}
+
+TEST(log_pp_named_logger, replaced_loggers_stay_alive) {
+    auto audit = std::make_shared<CaptureLogger>();
+    std::weak_ptr<CaptureLogger> weak = audit;
+    log_pp::register_logger("audit", std::move(audit));
+    LOG_PP_ERROR(LOG_PP_NAMED("audit"), "first");
+    EXPECT_EQ("first", weak.lock()->last_message);
+    EXPECT_EQ(weak.lock().get(), &log_pp::named_logger("audit").get_logger());
+
+    // Handles may still be calling the replaced logger, so it is kept.
+    auto next = std::make_shared<CaptureLogger>();
+    log_pp::register_logger("audit", next);
+    EXPECT_FALSE(weak.expired());
+    LOG_PP_ERROR(LOG_PP_NAMED("audit"), "second");
+    EXPECT_EQ("second", next->last_message);
+    log_pp::unregister_logger("audit");
+}
+
+TEST(log_pp_named_logger, statements_stay_on_one_logger_across_a_swap) {
+    struct SwappingLogger : public CaptureLogger {
+        std::shared_ptr<CaptureLogger> next;
+
+        bool enabled(
+            const log_pp::BasicMetadata<char>&) const noexcept override {
+            // Retargets the handle between this statement's enabled() and
+            // log() calls.
+            log_pp::register_logger("swap", next);
+            return true;
+        }
+    };
+    auto first = std::make_shared<SwappingLogger>();
+    first->next = std::make_shared<CaptureLogger>();
+    log_pp::register_logger("swap", first);
+
+    LOG_PP_INFO(LOG_PP_NAMED("swap"), "one");
+    EXPECT_EQ("one", first->last_message);
+    EXPECT_EQ(0, first->next->calls);
+    LOG_PP_INFO(LOG_PP_NAMED("swap"), "two");
+    EXPECT_EQ("two", first->next->last_message);
+    log_pp::unregister_logger("swap");
+}
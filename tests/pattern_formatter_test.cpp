@@ -0,0 +1,95 @@
+#include <memory>
+#include <regex>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+#include "pattern_formatter.hpp"
+#include "sink.hpp"
+
+namespace {
+
+log_pp::Record make_record(const log_pp::KVList& kvs) {
+    return log_pp::RecordBuilder{}
+        .set_level(log_pp::Level::Warning)
+        .set_target("db::pool")
+        .set_format_string("pool exhausted")
+        .set_kvs(kvs)
+        .build();
+}
+
+struct CaptureSink : public log_pp::Sink {
+    std::string out{};
+
+    explicit CaptureSink(std::shared_ptr<const log_pp::Encoder> encoder)
+        : log_pp::Sink(std::move(encoder)) {}
+
+    void write(std::string_view bytes) override { out += bytes; }
+    void flush() override {}
+};
+
+std::string render(const log_pp::PatternFormatter& formatter,
+                   const log_pp::Record& record) {
+    std::string out;
+    formatter.encode(record, out);
+    return out;
+}
+
+}  // namespace
+
+TEST(log_pp_pattern_formatter, renders_record_fields) {
+    log_pp::KVList kvs{{"size", 8}, {"user", "alice"}};
+    log_pp::PatternFormatter formatter("%l|%L|%n|%v|%k");
+    EXPECT_EQ("WARNING|W|db::pool|pool exhausted|size=8 user=alice\n",
+              render(formatter, make_record(kvs)));
+}
+
+TEST(log_pp_pattern_formatter, merges_literals_and_escapes) {
+    log_pp::PatternFormatter formatter("100%% [%q] %v%");
+    // "100% [%q] " is one literal step, then the message, then "%".
+    EXPECT_EQ(3u, formatter.step_count());
+    EXPECT_EQ("100% [%q] pool exhausted%\n", render(formatter, make_record({})));
+}
+
+TEST(log_pp_pattern_formatter, renders_timestamp_fields) {
+    log_pp::PatternFormatter formatter("%Y-%m-%dT%H:%M:%S.%e|%f|%F");
+    auto out = render(formatter, make_record({}));
+    EXPECT_TRUE(std::regex_match(
+        out, std::regex(R"(\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3})"
+                        R"(\|\d{6}\|\d{9}\n)")))
+        << out;
+}
+
+TEST(log_pp_pattern_formatter, renders_source_location) {
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_format_string("x")
+                      .set_module(std::source_location::current())
+                      .build();
+    log_pp::PatternFormatter formatter("%s:%#");
+    auto expected = "pattern_formatter_test.cpp:" +
+                    std::to_string(record.get_line().value()) + "\n";
+    EXPECT_EQ(expected, render(formatter, record));
+
+    log_pp::PatternFormatter without_location("[%s:%#]");
+    EXPECT_EQ("[:]\n", render(without_location, make_record({})));
+}
+
+TEST(log_pp_pattern_formatter, works_as_sink_encoder) {
+    CaptureSink sink(std::make_shared<log_pp::PatternFormatter>("%L %n: %v"));
+    LOG_PP_ERROR(sink, {"net"}, "code {}", 7);
+    EXPECT_EQ("E net: code 7\n", sink.out);
+}
+
+TEST(log_pp_pattern_formatter, supports_wide_characters) {
+    auto record = log_pp::BasicRecordBuilder<wchar_t>{}
+                      .set_level(log_pp::Level::Info)
+                      .set_target(L"w")
+                      .set_format_string(L"wide")
+                      .build();
+    log_pp::BasicPatternFormatter<wchar_t> formatter(L"%l %n %v");
+    std::wstring out;
+    formatter.encode(record, out);
+    EXPECT_EQ(L"INFO w wide\n", out);
+}
@@ -0,0 +1,90 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+
+namespace {
+
+std::atomic<int> g_records{0};
+
+struct CountingLogger : public log_pp::BasicLogger<char> {
+    std::atomic<int> calls{0};
+
+    bool enabled(const log_pp::BasicMetadata<char>&) const noexcept override {
+        return true;
+    }
+
+    void log(const log_pp::BasicRecord<char>&) noexcept override {
+        ++calls;
+        g_records.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void flush() noexcept override {}
+};
+
+CountingLogger g_static_logger;
+
+}  // namespace
+
+TEST(log_pp_replace_logger, swaps_and_keeps_previous_alive) {
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+    ASSERT_TRUE(log_pp::set_logger(g_static_logger));
+    LOG_PP_INFO("static");
+    EXPECT_EQ(1, g_static_logger.calls.load());
+
+    auto first = std::make_shared<CountingLogger>();
+    auto previous = log_pp::replace_logger<char>(first);
+    // Loggers from set_logger are handed back without ownership.
+    EXPECT_EQ(&g_static_logger, previous.get());
+    EXPECT_EQ(0, previous.use_count());
+    LOG_PP_INFO("first");
+    EXPECT_EQ(1, first->calls.load());
+    EXPECT_EQ(&log_pp::logger(), first.get());
+
+    // "First call wins" still holds for set_logger.
+    EXPECT_FALSE(log_pp::set_logger(g_static_logger));
+
+    // Replaced loggers are never destroyed, so statements that loaded one
+    // before the swap need no read-side protection.
+    std::weak_ptr<CountingLogger> weak = first;
+    first.reset();
+    previous = log_pp::replace_logger<char>(
+        std::make_shared<CountingLogger>());
+    EXPECT_EQ(weak.lock(), previous);
+    previous.reset();
+    EXPECT_FALSE(weak.expired());
+}
+
+TEST(log_pp_replace_logger, concurrent_swaps_and_logging) {
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+    constexpr int THREADS = 4;
+    constexpr int RECORDS = 2000;
+    std::atomic<bool> done{false};
+    g_records.store(0);
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < THREADS; ++t) {
+        writers.emplace_back([] {
+            for (int i = 0; i < RECORDS; ++i) {
+                LOG_PP_INFO("record {}", i);
+            }
+        });
+    }
+    std::thread swapper([&] {
+        while (!done.load()) {
+            log_pp::replace_logger<char>(std::make_shared<CountingLogger>());
+        }
+    });
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done.store(true);
+    swapper.join();
+
+    // Every record reached some logger, even mid-swap.
+    EXPECT_EQ(THREADS * RECORDS, g_records.load());
+}
@@ -0,0 +1,92 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+#include "router_logger.hpp"
+#include "target_trie.hpp"
+
+namespace {
+
+struct CaptureLogger : public log_pp::BasicLogger<char> {
+    std::vector<std::string> messages{};
+    log_pp::Level max = log_pp::Level::Trace;
+
+    bool enabled(const log_pp::BasicMetadata<char>& metadata) const noexcept
+        override {
+        return metadata.get_level() <= max;
+    }
+
+    void log(const log_pp::BasicRecord<char>& record) override {
+        messages.push_back(
+            std::vformat(record.get_format_string(), record.get_args()));
+    }
+
+    void flush() override {}
+};
+
+}  // namespace
+
+TEST(log_pp_router, trie_prefers_exact_then_longest_prefix) {
+    log_pp::detail::TargetTrie<char> trie;
+    trie.insert_prefix("db", 0);
+    trie.insert_prefix("db::pool", 1);
+    trie.insert_exact("db::pool", 2);
+    trie.insert_exact("http", 3);
+    trie.compile();
+
+    EXPECT_EQ(0u, trie.find("db"));
+    EXPECT_EQ(0u, trie.find("db::query"));
+    EXPECT_EQ(2u, trie.find("db::pool"));
+    EXPECT_EQ(1u, trie.find("db::pool::conn"));
+    EXPECT_EQ(3u, trie.find("http"));
+    EXPECT_FALSE(trie.find("https").has_value());
+    EXPECT_FALSE(trie.find("").has_value());
+}
+
+TEST(log_pp_router, routes_targets_to_separate_loggers) {
+    auto db = std::make_shared<CaptureLogger>();
+    auto http = std::make_shared<CaptureLogger>();
+    auto audit = std::make_shared<CaptureLogger>();
+    auto other = std::make_shared<CaptureLogger>();
+    log_pp::RouterLogger router;
+    router.add_route("db*", db);
+    router.add_route("http", http);
+    router.add_route("audit", audit);
+
+    LOG_PP_INFO(router, {"db::pool"}, "db {}", 1);
+    LOG_PP_INFO(router, {"http"}, "http {}", 2);
+    LOG_PP_INFO(router, {"audit"}, "audit {}", 3);
+    LOG_PP_INFO(router, {"unrouted"}, "dropped");
+    router.set_fallback(other);
+    LOG_PP_INFO(router, {"unrouted"}, "fallback");
+    LOG_PP_INFO(router, "no target");
+
+    EXPECT_EQ(std::vector<std::string>{"db 1"}, db->messages);
+    EXPECT_EQ(std::vector<std::string>{"http 2"}, http->messages);
+    EXPECT_EQ(std::vector<std::string>{"audit 3"}, audit->messages);
+    EXPECT_EQ((std::vector<std::string>{"fallback", "no target"}),
+              other->messages);
+}
+
+TEST(log_pp_router, enabled_uses_routed_logger) {
+    auto http = std::make_shared<CaptureLogger>();
+    http->max = log_pp::Level::Warning;
+    log_pp::RouterLogger router;
+    router.add_route("http", http);
+
+    auto meta = [](log_pp::Level level, std::string_view target) {
+        return log_pp::MetadataBuilder{}
+            .set_level(level)
+            .set_target(target)
+            .build();
+    };
+    EXPECT_TRUE(router.enabled(meta(log_pp::Level::Error, "http")));
+    EXPECT_FALSE(router.enabled(meta(log_pp::Level::Info, "http")));
+    EXPECT_FALSE(router.enabled(meta(log_pp::Level::Error, "db")));
+
+    EXPECT_TRUE(router.remove_route("http"));
+    EXPECT_FALSE(router.enabled(meta(log_pp::Level::Error, "http")));
+}
@@ -0,0 +1,128 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "directive_filter.hpp"
+#include "log.hpp"
+#include "sampling.hpp"
+
+namespace {
+
+struct CountingLogger : public log_pp::BasicLogger<char> {
+    int calls = 0;
+
+    bool enabled(const log_pp::BasicMetadata<char>&) const noexcept override {
+        return true;
+    }
+
+    void log(const log_pp::BasicRecord<char>&) noexcept override { ++calls; }
+
+    void flush() noexcept override {}
+};
+
+struct FilteredLogger : public CountingLogger {
+    log_pp::DirectiveFilter filter{"info"};
+
+    bool enabled(const log_pp::BasicMetadata<char>& metadata) const noexcept
+        override {
+        return filter.enabled(metadata);
+    }
+};
+
+}  // namespace
+
+TEST(log_pp_sampling, decision_is_deterministic_and_rate_bound) {
+    static_assert(log_pp::sampling_hash("") == 0xCBF29CE484222325ull);
+    EXPECT_FALSE(log_pp::sample_key(42, 0.0));
+    EXPECT_TRUE(log_pp::sample_key(42, 1.0));
+
+    int sampled = 0;
+    for (uint64_t key = 0; key < 100000; ++key) {
+        EXPECT_EQ(log_pp::sample_key(key, 0.01),
+                  log_pp::sample_key(key, 0.01));
+        sampled += log_pp::sample_key(key, 0.01) ? 1 : 0;
+    }
+    // Sequential keys still land close to the requested rate.
+    EXPECT_NEAR(1000, sampled, 150);
+}
+
+TEST(log_pp_sampling, keeps_every_line_of_sampled_requests) {
+    CountingLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Info);
+
+    int sampled_requests = 0;
+    for (int request = 0; request < 200; ++request) {
+        auto before = logger.calls;
+        log_pp::SamplingScope sampling(
+            "trace-" + std::to_string(request), 0.1);
+        for (int line = 0; line < 5; ++line) {
+            LOG_PP_DEBUG(logger, "line {}", line);
+        }
+        LOG_PP_INFO(logger, "done");
+        if (sampling.sampled()) {
+            ++sampled_requests;
+            EXPECT_EQ(before + 6, logger.calls);
+        } else {
+            EXPECT_EQ(before + 1, logger.calls);
+        }
+    }
+    EXPECT_GT(sampled_requests, 0);
+    EXPECT_LT(sampled_requests, 60);
+    EXPECT_EQ(log_pp::LevelFilter::Info, log_pp::max_level());
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+TEST(log_pp_sampling, never_lowers_verbosity) {
+    CountingLogger logger;
+    ASSERT_EQ(log_pp::LevelFilter::Trace, log_pp::max_level());
+    {
+        log_pp::SamplingScope sampling(uint64_t{7}, 1.0);
+        ASSERT_TRUE(sampling.sampled());
+        LOG_PP_TRACE(logger, "trace");
+        EXPECT_EQ(log_pp::LevelFilter::Trace, log_pp::max_level());
+    }
+    EXPECT_EQ(1, logger.calls);
+
+    log_pp::set_max_level(log_pp::LevelFilter::Info);
+    {
+        log_pp::ThreadLevelGuard verbose(log_pp::LevelFilter::Trace);
+        log_pp::SamplingScope sampling(uint64_t{7}, 1.0);
+        LOG_PP_TRACE(logger, "trace");
+    }
+    EXPECT_EQ(2, logger.calls);
+    EXPECT_EQ(log_pp::LevelFilter::Info, log_pp::max_level());
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+TEST(log_pp_sampling, sampled_requests_pass_logger_filters) {
+    FilteredLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Info);
+    LOG_PP_DEBUG(logger, "unsampled");
+    EXPECT_EQ(0, logger.calls);
+    {
+        log_pp::SamplingScope sampling(uint64_t{7}, 1.0);
+        ASSERT_TRUE(sampling.sampled());
+        LOG_PP_DEBUG(logger, "sampled");
+        EXPECT_EQ(1, logger.calls);
+        // The directive still rejects levels past the sampled one.
+        LOG_PP_TRACE(logger, "trace");
+        EXPECT_EQ(1, logger.calls);
+    }
+    LOG_PP_DEBUG(logger, "unsampled");
+    EXPECT_EQ(1, logger.calls);
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+TEST(log_pp_sampling, follows_later_global_level_changes) {
+    CountingLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Info);
+    {
+        log_pp::SamplingScope sampling(uint64_t{7}, 1.0);
+        EXPECT_EQ(log_pp::LevelFilter::Debug, log_pp::max_level());
+        log_pp::set_max_level(log_pp::LevelFilter::Trace);
+        EXPECT_EQ(log_pp::LevelFilter::Trace, log_pp::max_level());
+        LOG_PP_TRACE(logger, "trace");
+        EXPECT_EQ(1, logger.calls);
+    }
+    EXPECT_EQ(log_pp::LevelFilter::Off, log_pp::thread_level_floor());
+}
@@ -0,0 +1,137 @@
+#include <unistd.h>
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+#include "shm_ring.hpp"
+
+namespace {
+
+std::string ring_name(const char* name) {
+    return "/log_pp_test_" + std::to_string(::getpid()) + "_" + name;
+}
+
+}  // namespace
+
+TEST(log_pp_shm_ring, reader_sees_sink_records_in_place) {
+    auto name = ring_name("sink");
+    log_pp::ShmRingSink sink(std::make_shared<log_pp::TextEncoder>(),
+                             {.name = name, .capacity = 4096});
+    ASSERT_TRUE(sink.get_ring().is_open());
+    EXPECT_EQ(4096u, sink.get_ring().capacity());
+
+    log_pp::ShmRingReader reader(name);
+    ASSERT_TRUE(reader.is_open());
+    EXPECT_FALSE(reader.peek().has_value());
+
+    LOG_PP_INFO(sink, {"db"}, "hello {}", 1);
+    LOG_PP_ERROR(sink, "boom");
+
+    std::vector<std::string> records;
+    EXPECT_EQ(2u, reader.drain([&](std::string_view record) {
+        records.emplace_back(record);
+    }));
+    ASSERT_EQ(2u, records.size());
+    EXPECT_EQ("[INFO] [db] hello 1\n", records[0]);
+    EXPECT_EQ("[ERROR] [] boom\n", records[1]);
+    EXPECT_FALSE(reader.peek().has_value());
+}
+
+TEST(log_pp_shm_ring, log_batch_publishes_separate_records) {
+    auto name = ring_name("batch");
+    log_pp::ShmRingSink sink(std::make_shared<log_pp::TextEncoder>(),
+                             {.name = name, .capacity = 4096});
+    log_pp::ShmRingReader reader(name);
+    ASSERT_TRUE(reader.is_open());
+
+    std::vector<log_pp::Record> records;
+    for (const char* message : {"a", "b"}) {
+        records.push_back(log_pp::RecordBuilder{}
+                              .set_level(log_pp::Level::Info)
+                              .set_format_string(message)
+                              .build());
+    }
+    sink.log_batch(records);
+
+    std::vector<std::string> received;
+    reader.drain(
+        [&](std::string_view record) { received.emplace_back(record); });
+    EXPECT_EQ((std::vector<std::string>{"[INFO] [] a\n", "[INFO] [] b\n"}),
+              received);
+}
+
+TEST(log_pp_shm_ring, wraps_and_drops_when_full) {
+    auto name = ring_name("wrap");
+    log_pp::ShmRingWriter writer({.name = name, .capacity = 4096});
+    log_pp::ShmRingReader reader(name);
+    ASSERT_TRUE(writer.is_open());
+    ASSERT_TRUE(reader.is_open());
+
+    // 100-byte payloads take 112 bytes, so records regularly straddle the
+    // end of the ring and force padding records.
+    for (int i = 0; i < 500; ++i) {
+        std::string payload(100, static_cast<char>('a' + i % 26));
+        ASSERT_TRUE(writer.publish(payload));
+        auto record = reader.peek();
+        ASSERT_TRUE(record.has_value());
+        EXPECT_EQ(payload, *record);
+        reader.pop();
+    }
+
+    std::size_t published = 0;
+    while (writer.publish(std::string(100, 'x'))) {
+        ++published;
+    }
+    EXPECT_EQ(36u, published);
+    EXPECT_EQ(1u, writer.dropped_count());
+    EXPECT_EQ(1u, reader.dropped_count());
+    EXPECT_EQ(published, reader.drain([](std::string_view) {}));
+    EXPECT_TRUE(writer.publish("again"));
+}
+
+TEST(log_pp_shm_ring, concurrent_producers_are_all_delivered) {
+    auto name = ring_name("mpsc");
+    log_pp::ShmRingWriter writer({.name = name, .capacity = 8192});
+    log_pp::ShmRingReader reader(name);
+    ASSERT_TRUE(reader.is_open());
+
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 2000;
+    std::atomic<int> done{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t) {
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                auto payload = std::to_string(t) + ":" + std::to_string(i);
+                while (!writer.publish(payload)) {
+                    std::this_thread::yield();
+                }
+            }
+            done.fetch_add(1);
+        });
+    }
+
+    std::set<std::string> seen;
+    while (done.load() < THREADS || reader.peek().has_value()) {
+        reader.drain([&](std::string_view record) {
+            EXPECT_TRUE(seen.emplace(record).second);
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(static_cast<std::size_t>(THREADS * PER_THREAD), seen.size());
+}
+
+TEST(log_pp_shm_ring, reader_rejects_missing_segment) {
+    log_pp::ShmRingReader reader(ring_name("missing"));
+    EXPECT_FALSE(reader.is_open());
+    EXPECT_FALSE(reader.peek().has_value());
+}
@@ -0,0 +1,311 @@
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+#include "socket_sink.hpp"
+
+namespace {
+
+// Minimal collector stand-in bound to a Unix socket path.
+struct LocalCollector {
+    std::string path;
+    int listen_fd = -1;
+    int conn_fd = -1;
+
+    LocalCollector(std::string in_path, int type) : path(std::move(in_path)) {
+        ::unlink(path.c_str());
+        listen_fd = ::socket(AF_UNIX, type, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        EXPECT_EQ(0, ::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr),
+                            sizeof(addr)));
+        if (type == SOCK_STREAM) {
+            EXPECT_EQ(0, ::listen(listen_fd, 4));
+        }
+    }
+
+    ~LocalCollector() {
+        if (conn_fd >= 0) {
+            ::close(conn_fd);
+        }
+        ::close(listen_fd);
+        ::unlink(path.c_str());
+    }
+
+    bool readable(int fd) const {
+        pollfd pfd{fd, POLLIN, 0};
+        return ::poll(&pfd, 1, 2000) == 1;
+    }
+
+    // Reads RFC 6587 octet-counted frames from the accepted connection.
+    std::vector<std::string> read_octet_counted(std::size_t count) {
+        if (conn_fd < 0 && readable(listen_fd)) {
+            conn_fd = ::accept(listen_fd, nullptr, nullptr);
+        }
+        std::string data;
+        std::vector<std::string> frames;
+        while (frames.size() < count && readable(conn_fd)) {
+            char buf[4096];
+            auto n = ::read(conn_fd, buf, sizeof(buf));
+            if (n <= 0) {
+                break;
+            }
+            data.append(buf, static_cast<std::size_t>(n));
+            for (;;) {
+                auto space = data.find(' ');
+                if (space == std::string::npos) {
+                    break;
+                }
+                auto len = std::stoul(data.substr(0, space));
+                if (data.size() < space + 1 + len) {
+                    break;
+                }
+                frames.push_back(data.substr(space + 1, len));
+                data.erase(0, space + 1 + len);
+            }
+        }
+        return frames;
+    }
+
+    std::vector<std::string> read_datagrams(std::size_t count) {
+        std::vector<std::string> frames;
+        while (frames.size() < count && readable(listen_fd)) {
+            char buf[4096];
+            auto n = ::recv(listen_fd, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                break;
+            }
+            frames.emplace_back(buf, static_cast<std::size_t>(n));
+        }
+        return frames;
+    }
+};
+
+std::string socket_path(const char* name) {
+    return (std::filesystem::temp_directory_path() /
+            (std::string("log_pp_") + name + ".sock"))
+        .string();
+}
+
+}  // namespace
+
+TEST(log_pp_socket_sink, syslog_frames_over_unix_stream) {
+    auto path = socket_path("syslog");
+    LocalCollector collector(path, SOCK_STREAM);
+    log_pp::SocketSink sink(std::make_shared<log_pp::TextEncoder>(),
+                            {.kind = log_pp::SocketKind::UnixStream,
+                             .address = path,
+                             .app_name = "test_app",
+                             .hostname = "host1"});
+
+    LOG_PP_INFO(sink, {"db"}, "hello {}", 0);
+    LOG_PP_ERROR(sink, "boom");
+    sink.flush();
+
+    auto frames = collector.read_octet_counted(2);
+    ASSERT_EQ(2u, frames.size());
+    EXPECT_EQ(0u, frames[0].rfind("<14>1 ", 0));
+    EXPECT_NE(std::string::npos,
+              frames[0].find(" host1 test_app " + std::to_string(::getpid()) +
+                             " db - [INFO] [db] hello 0"));
+    EXPECT_EQ('Z', frames[0][frames[0].find(" host1") - 1]);
+    EXPECT_EQ(0u, frames[1].rfind("<11>1 ", 0));
+    EXPECT_NE(std::string::npos, frames[1].find(" - - [ERROR] [] boom"));
+}
+
+TEST(log_pp_socket_sink, length_prefixed_datagrams_are_batched) {
+    auto path = socket_path("dgram");
+    LocalCollector collector(path, SOCK_DGRAM);
+    log_pp::SocketSink sink(std::make_shared<log_pp::TextEncoder>(),
+                            {.kind = log_pp::SocketKind::UnixDatagram,
+                             .address = path,
+                             .framing = log_pp::SocketFraming::LengthPrefixed});
+
+    for (int i = 0; i < 3; ++i) {
+        LOG_PP_WARN(sink, "n={}", i);
+    }
+    sink.flush();
+
+    auto frames = collector.read_datagrams(3);
+    ASSERT_EQ(3u, frames.size());
+    for (int i = 0; i < 3; ++i) {
+        std::string payload = "[WARNING] [] n=" + std::to_string(i);
+        std::string expected{'\0', '\0', '\0',
+                             static_cast<char>(payload.size())};
+        EXPECT_EQ(expected + payload, frames[static_cast<std::size_t>(i)]);
+    }
+}
+
+TEST(log_pp_socket_sink, rejected_datagrams_do_not_block_the_queue) {
+    auto path = socket_path("oversized");
+    LocalCollector collector(path, SOCK_DGRAM);
+    log_pp::SocketSink limited(
+        std::make_shared<log_pp::TextEncoder>(),
+        {.kind = log_pp::SocketKind::UnixDatagram,
+         .address = path,
+         .framing = log_pp::SocketFraming::LengthPrefixed,
+         .max_datagram = 16});
+    LOG_PP_INFO(limited, "longer than sixteen bytes");
+    EXPECT_EQ(1u, limited.dropped_count());
+
+    // Past the kernel's datagram limit, so sendmmsg fails with EMSGSIZE.
+    log_pp::SocketSink sink(
+        std::make_shared<log_pp::TextEncoder>(),
+        {.kind = log_pp::SocketKind::UnixDatagram,
+         .address = path,
+         .framing = log_pp::SocketFraming::LengthPrefixed,
+         .max_datagram = SIZE_MAX});
+    LOG_PP_INFO(sink, "{}", std::string(1024 * 1024, 'x'));
+    LOG_PP_INFO(sink, "after");
+    sink.flush();
+
+    auto frames = collector.read_datagrams(1);
+    ASSERT_EQ(1u, frames.size());
+    EXPECT_EQ(std::string({'\0', '\0', '\0', '\x0f'}) + "[INFO] [] after",
+              frames[0]);
+    EXPECT_EQ(1u, sink.dropped_count());
+}
+
+TEST(log_pp_socket_sink, spills_while_peer_is_down_and_reconnects) {
+    auto path = socket_path("reconnect");
+    ::unlink(path.c_str());
+    log_pp::SocketSink sink(std::make_shared<log_pp::TextEncoder>(),
+                            {.kind = log_pp::SocketKind::UnixStream,
+                             .address = path,
+                             .framing = log_pp::SocketFraming::LengthPrefixed,
+                             .spill_capacity = 3 * 23,
+                             .reconnect_min = std::chrono::milliseconds(5),
+                             .reconnect_max = std::chrono::milliseconds(20)});
+
+    // Each frame is 4 + 19 bytes, so only the last three are kept.
+    for (int i = 0; i < 6; ++i) {
+        LOG_PP_INFO(sink, "spilled {}", i);
+    }
+    EXPECT_EQ(3u, sink.dropped_count());
+
+    LocalCollector collector(path, SOCK_STREAM);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (sink.pending_count() != 0 &&
+           std::chrono::steady_clock::now() < deadline) {
+        sink.flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(0u, sink.pending_count());
+
+    ASSERT_TRUE(collector.readable(collector.listen_fd));
+    int conn = ::accept(collector.listen_fd, nullptr, nullptr);
+    std::string data;
+    while (data.size() < 69 && collector.readable(conn)) {
+        char buf[256];
+        auto n = ::read(conn, buf, sizeof(buf));
+        if (n <= 0) {
+            break;
+        }
+        data.append(buf, static_cast<std::size_t>(n));
+    }
+    ::close(conn);
+    ASSERT_EQ(69u, data.size());
+    EXPECT_EQ(std::string({'\0', '\0', '\0', '\x13'}), data.substr(0, 4));
+    EXPECT_EQ("[INFO] [] spilled 3", data.substr(4, 19));
+    EXPECT_EQ("[INFO] [] spilled 4", data.substr(27, 19));
+    EXPECT_EQ("[INFO] [] spilled 5", data.substr(50, 19));
+}
+
+TEST(log_pp_socket_sink, log_batch_sends_one_frame_per_record) {
+    auto path = socket_path("batch");
+    LocalCollector collector(path, SOCK_DGRAM);
+    log_pp::SocketSink sink(std::make_shared<log_pp::TextEncoder>(),
+                            {.kind = log_pp::SocketKind::UnixDatagram,
+                             .address = path,
+                             .framing = log_pp::SocketFraming::LengthPrefixed});
+
+    std::vector<log_pp::Record> records;
+    for (const char* message : {"a", "b", "c"}) {
+        records.push_back(log_pp::RecordBuilder{}
+                              .set_level(log_pp::Level::Info)
+                              .set_format_string(message)
+                              .build());
+    }
+    sink.log_batch(records);
+    sink.flush();
+
+    auto frames = collector.read_datagrams(3);
+    ASSERT_EQ(3u, frames.size());
+    EXPECT_EQ(std::string({'\0', '\0', '\0', '\x0b'}) + "[INFO] [] b",
+              frames[1]);
+}
+
+TEST(log_pp_socket_sink, destructor_gives_up_on_a_stalled_peer) {
+    auto path = socket_path("stalled");
+    LocalCollector collector(path, SOCK_STREAM);
+    auto sink = std::make_unique<log_pp::SocketSink>(
+        std::make_shared<log_pp::TextEncoder>(),
+        log_pp::SocketSinkOptions{
+            .kind = log_pp::SocketKind::UnixStream,
+            .address = path,
+            .framing = log_pp::SocketFraming::LengthPrefixed,
+            // One small frame per send, so the buffer fills between frames
+            // and the sender keeps waiting instead of resetting.
+            .max_batch = 1,
+            .flush_timeout = std::chrono::milliseconds(200)});
+
+    // Accept, then never read, so the socket buffer fills up.
+    std::string padding(1024, 'x');
+    LOG_PP_INFO(*sink, "{}", padding);
+    sink->flush();
+    ASSERT_TRUE(collector.readable(collector.listen_fd));
+    collector.conn_fd = ::accept(collector.listen_fd, nullptr, nullptr);
+    for (int i = 0; i < 2048; ++i) {
+        LOG_PP_INFO(*sink, "{}", padding);
+    }
+    sink->flush();
+    EXPECT_NE(0u, sink->pending_count());
+
+    auto start = std::chrono::steady_clock::now();
+    sink.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::seconds(2));
+}
+
+TEST(log_pp_socket_sink, destructor_reconnects_until_flush_timeout) {
+    auto path = socket_path("late_peer");
+    ::unlink(path.c_str());
+    auto sink = std::make_unique<log_pp::SocketSink>(
+        std::make_shared<log_pp::TextEncoder>(),
+        log_pp::SocketSinkOptions{
+            .kind = log_pp::SocketKind::UnixStream,
+            .address = path,
+            .framing = log_pp::SocketFraming::LengthPrefixed,
+            .reconnect_min = std::chrono::milliseconds(5),
+            .reconnect_max = std::chrono::milliseconds(20),
+            .flush_timeout = std::chrono::milliseconds(2000)});
+    LOG_PP_INFO(*sink, "late");
+
+    // The peer comes up only after shutdown started.
+    std::thread stopper([&] { sink.reset(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    LocalCollector collector(path, SOCK_STREAM);
+    stopper.join();
+
+    ASSERT_TRUE(collector.readable(collector.listen_fd));
+    collector.conn_fd = ::accept(collector.listen_fd, nullptr, nullptr);
+    ASSERT_TRUE(collector.readable(collector.conn_fd));
+    char buf[64];
+    auto n = ::read(collector.conn_fd, buf, sizeof(buf));
+    ASSERT_EQ(18, n);
+    EXPECT_EQ("[INFO] [] late", std::string(buf + 4, 14));
+}
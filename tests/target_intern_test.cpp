@@ -0,0 +1,185 @@
+#include <format>
+#include <memory>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "directive_filter.hpp"
+#include "log.hpp"
+#include "router_logger.hpp"
+#include "target_intern.hpp"
+
+namespace {
+
+struct CaptureLogger : public log_pp::BasicLogger<char> {
+    log_pp::TargetId last_id = log_pp::NO_TARGET_ID;
+    std::string last_message;
+    int calls = 0;
+
+    bool enabled(const log_pp::BasicMetadata<char>&) const noexcept override {
+        return true;
+    }
+
+    void log(const log_pp::BasicRecord<char>& record) noexcept override {
+        ++calls;
+        last_id = record.get_target_id();
+        last_message =
+            std::vformat(record.get_format_string(), record.get_args());
+    }
+
+    void flush() noexcept override {}
+};
+
+}  // namespace
+
+TEST(log_pp_target_intern, ids_are_dense_and_stable) {
+    using namespace std::string_view_literals;
+    EXPECT_EQ(0u, log_pp::intern_target(""sv));
+    EXPECT_EQ(log_pp::NO_TARGET_ID,
+              log_pp::detail::target_interner<char>().find("intern::new"sv));
+
+    auto before = log_pp::interned_target_count();
+    auto id = log_pp::intern_target("intern::new"sv);
+    EXPECT_EQ(before, id);
+    EXPECT_EQ(before + 1, log_pp::interned_target_count());
+    // Equal text from a different buffer maps to the same ID.
+    std::string copy = "intern::new";
+    EXPECT_EQ(id, log_pp::intern_target(std::string_view(copy)));
+    EXPECT_EQ(id, log_pp::detail::target_interner<char>().find(
+                      "intern::new"sv));
+    EXPECT_EQ("intern::new"sv, log_pp::target_name(id));
+    EXPECT_FALSE(log_pp::target_name(log_pp::NO_TARGET_ID).has_value());
+}
+
+TEST(log_pp_target_intern, concurrent_interning_agrees) {
+    constexpr int THREADS = 4;
+    constexpr int TARGETS = 64;
+    std::vector<std::vector<log_pp::TargetId>> ids(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < TARGETS; ++i) {
+                auto name = std::format("race::{}", i);
+                ids[t].push_back(
+                    log_pp::intern_target(std::string_view(name)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int i = 0; i < TARGETS; ++i) {
+        for (int t = 1; t < THREADS; ++t) {
+            EXPECT_EQ(ids[0][i], ids[t][i]);
+        }
+        EXPECT_EQ(std::format("race::{}", i), log_pp::target_name(ids[0][i]));
+    }
+}
+
+TEST(log_pp_target_intern, full_interner_rejects_new_targets) {
+    using namespace std::string_view_literals;
+    log_pp::detail::TargetInterner<char> interner;
+    std::vector<std::string> names;
+    for (std::size_t i = interner.size(); i < log_pp::MAX_TARGET_IDS; ++i) {
+        names.push_back(std::format("full::{}", i));
+        EXPECT_NE(log_pp::NO_TARGET_ID, interner.intern(names.back()));
+    }
+    EXPECT_EQ(log_pp::MAX_TARGET_IDS, interner.size());
+    EXPECT_EQ(log_pp::NO_TARGET_ID, interner.intern("full::extra"sv));
+    // Known targets still resolve.
+    EXPECT_EQ(1u, interner.intern(names.front()));
+}
+
+TEST(log_pp_target_intern, records_carry_target_ids) {
+    using namespace std::string_view_literals;
+    CaptureLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+
+    LOG_PP_INFO(logger, {"intern::plain"}, "plain");
+    EXPECT_EQ(log_pp::intern_target("intern::plain"sv), logger.last_id);
+
+    LOG_PP_INFO(logger, LOG_PP_TARGET("intern::literal"), "literal");
+    EXPECT_EQ(log_pp::intern_target("intern::literal"sv), logger.last_id);
+
+    std::string runtime = "intern::runtime";
+    LOG_PP_INFO(logger, {runtime}, "runtime");
+    EXPECT_EQ(log_pp::intern_target("intern::runtime"sv), logger.last_id);
+
+    LOG_PP_INFO(logger, "untargeted");
+    EXPECT_EQ(0u, logger.last_id);
+}
+
+TEST(log_pp_target_intern, const_array_targets_are_not_cached) {
+    using namespace std::string_view_literals;
+    struct Conn {
+        char name[16];
+    };
+    CaptureLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+    auto log_conn = [&](const Conn& conn) {
+        LOG_PP_INFO(logger, {conn.name}, "x");
+    };
+
+    log_conn(Conn{"conn::db"});
+    EXPECT_EQ(log_pp::intern_target("conn::db"sv), logger.last_id);
+    // Same statement, different text in the same kind of array.
+    log_conn(Conn{"conn::http"});
+    EXPECT_EQ(log_pp::intern_target("conn::http"sv), logger.last_id);
+    EXPECT_EQ("conn::http"sv, log_pp::target_name(logger.last_id));
+}
+
+TEST(log_pp_target_intern, callsites_cache_plain_targets) {
+    using namespace std::string_view_literals;
+    log_pp::Callsite site;
+    log_pp::CallsiteRef ref(site, std::source_location::current());
+
+    auto id = log_pp::callsite_target_id<char>({"intern::cached"}, ref);
+    EXPECT_EQ(log_pp::intern_target("intern::cached"sv), id);
+    EXPECT_EQ(id, site.target_id.load());
+    EXPECT_EQ(id, log_pp::callsite_target_id<char>({"intern::cached"}, ref));
+
+    // A stale cached ID is caught by the compare and replaced.
+    std::string other = "intern::other";
+    id = log_pp::callsite_target_id<char>({other}, ref);
+    EXPECT_EQ(log_pp::intern_target("intern::other"sv), id);
+    EXPECT_EQ(id, site.target_id.load());
+}
+
+TEST(log_pp_target_intern, filters_and_routers_use_id_cache) {
+    auto db = std::make_shared<CaptureLogger>();
+    auto other = std::make_shared<CaptureLogger>();
+    log_pp::RouterLogger router;
+    router.add_route("idb*", db);
+    router.set_fallback(other);
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+
+    for (int i = 0; i < 3; ++i) {
+        LOG_PP_INFO(router, {"idb::pool"}, "db {}", i);
+        LOG_PP_INFO(router, {"http"}, "http {}", i);
+    }
+    EXPECT_EQ(3, db->calls);
+    EXPECT_EQ(3, other->calls);
+
+    // A reload starts from an empty cache.
+    router.remove_route("idb*");
+    LOG_PP_INFO(router, {"idb::pool"}, "db");
+    EXPECT_EQ(3, db->calls);
+    EXPECT_EQ(4, other->calls);
+
+    log_pp::DirectiveFilter filter("warn,idb=trace");
+    auto metadata = log_pp::MetadataBuilder()
+                        .set_level(log_pp::Level::Debug)
+                        .set_target("idb::pool")
+                        .set_target_id(log_pp::intern_target(
+                            std::string_view("idb::pool")))
+                        .build();
+    EXPECT_TRUE(filter.enabled(metadata));
+    EXPECT_TRUE(filter.enabled(metadata));
+    filter.reload("warn");
+    EXPECT_FALSE(filter.enabled(metadata));
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
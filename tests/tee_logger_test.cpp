@@ -0,0 +1,148 @@
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+#include "tee_logger.hpp"
+
+namespace {
+
+struct CountingEncoder : public log_pp::Encoder {
+    mutable std::atomic<int> calls{0};
+
+    void encode(const log_pp::Record& record,
+                std::string& out) const override {
+        ++calls;
+        out += std::format("{}|{}|", record.get_level(), record.get_target());
+        out += std::vformat(record.get_format_string(), record.get_args());
+    }
+};
+
+struct CaptureSink : public log_pp::Sink {
+    std::vector<log_pp::SharedBuffer> buffers{};
+    std::vector<std::string> writes{};
+    int flushes = 0;
+
+    explicit CaptureSink(std::shared_ptr<const log_pp::Encoder> encoder)
+        : log_pp::Sink(std::move(encoder)) {}
+
+    void write(std::string_view bytes) override {
+        writes.emplace_back(bytes);
+    }
+
+    void write_shared(const log_pp::Record&,
+                      const log_pp::SharedBuffer& buffer) override {
+        buffers.push_back(buffer);
+        write(*buffer);
+    }
+
+    void flush() override { ++flushes; }
+};
+
+}  // namespace
+
+TEST(log_pp_tee, encodes_once_per_encoder_and_shares_buffer) {
+    auto encoder = std::make_shared<CountingEncoder>();
+    auto file = std::make_shared<CaptureSink>(encoder);
+    auto socket = std::make_shared<CaptureSink>(encoder);
+    log_pp::TeeLogger tee;
+    tee.add_sink(file);
+    tee.add_sink(socket);
+    EXPECT_EQ(2u, tee.sink_count());
+    EXPECT_EQ(1u, tee.encoder_count());
+
+    LOG_PP_INFO(tee, {"db"}, "query {}", 7);
+
+    EXPECT_EQ(1, encoder->calls.load());
+    ASSERT_EQ(1u, file->buffers.size());
+    ASSERT_EQ(1u, socket->buffers.size());
+    EXPECT_EQ(file->buffers[0].get(), socket->buffers[0].get());
+    EXPECT_EQ("INFO|db|query 7", file->writes[0]);
+}
+
+TEST(log_pp_tee, distinct_encoders_render_separately) {
+    auto first = std::make_shared<CountingEncoder>();
+    auto second = std::make_shared<CountingEncoder>();
+    auto a = std::make_shared<CaptureSink>(first);
+    auto b = std::make_shared<CaptureSink>(second);
+    log_pp::TeeLogger tee;
+    tee.add_sink(a);
+    tee.add_sink(b);
+    EXPECT_EQ(2u, tee.encoder_count());
+
+    LOG_PP_WARN(tee, "hello");
+
+    EXPECT_EQ(1, first->calls.load());
+    EXPECT_EQ(1, second->calls.load());
+    EXPECT_NE(a->buffers[0].get(), b->buffers[0].get());
+}
+
+TEST(log_pp_tee, enabled_combines_sink_filters) {
+    auto encoder = std::make_shared<CountingEncoder>();
+    auto verbose = std::make_shared<CaptureSink>(encoder);
+    auto quiet = std::make_shared<CaptureSink>(encoder);
+    quiet->set_level(log_pp::LevelFilter::Warn);
+    log_pp::TeeLogger tee;
+    tee.add_sink(verbose);
+    tee.add_sink(quiet);
+
+    LOG_PP_DEBUG(tee, "debug");
+    EXPECT_EQ(1u, verbose->writes.size());
+    EXPECT_EQ(0u, quiet->writes.size());
+
+    verbose->set_level(log_pp::LevelFilter::Error);
+    EXPECT_FALSE(tee.enabled(log_pp::MetadataBuilder{}
+                                 .set_level(log_pp::Level::Info)
+                                 .build()));
+    LOG_PP_INFO(tee, "info");
+    EXPECT_EQ(1, encoder->calls.load());
+}
+
+TEST(log_pp_tee, add_and_remove_sinks_at_runtime) {
+    auto encoder = std::make_shared<log_pp::TextEncoder>();
+    auto first = std::make_shared<CaptureSink>(encoder);
+    auto second = std::make_shared<CaptureSink>(encoder);
+    log_pp::TeeLogger tee;
+    tee.add_sink(first);
+
+    LOG_PP_INFO(tee, {"api"}, {{"id", 1}}, "one");
+    tee.add_sink(second);
+    LOG_PP_INFO(tee, "two");
+    EXPECT_TRUE(tee.remove_sink(first.get()));
+    EXPECT_FALSE(tee.remove_sink(first.get()));
+    LOG_PP_INFO(tee, "three");
+    tee.flush();
+
+    ASSERT_EQ(2u, first->writes.size());
+    EXPECT_EQ("[INFO] [api] id: 1, one\n", first->writes[0]);
+    ASSERT_EQ(2u, second->writes.size());
+    EXPECT_EQ("[INFO] [] three\n", second->writes[1]);
+    EXPECT_EQ(0, first->flushes);
+    EXPECT_EQ(1, second->flushes);
+}
+
+TEST(log_pp_tee, concurrent_logging_while_reconfiguring) {
+    auto encoder = std::make_shared<CountingEncoder>();
+    log_pp::TeeLogger tee;
+    std::atomic<bool> stop{false};
+
+    std::thread writer([&] {
+        while (!stop.load()) {
+            LOG_PP_INFO(tee, "spin");
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        auto sink = std::make_shared<CaptureSink>(encoder);
+        sink->set_level(log_pp::LevelFilter::Off);
+        tee.add_sink(sink);
+        tee.remove_sink(sink.get());
+    }
+    stop.store(true);
+    writer.join();
+
+    EXPECT_EQ(0u, tee.sink_count());
+}
@@ -0,0 +1,87 @@
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "json_encoder.hpp"
+#include "log.hpp"
+#include "pattern_formatter.hpp"
+#include "thread_info.hpp"
+
+namespace {
+
+// Keeps records for rendering later, like an asynchronous sink would.
+struct QueueLogger : public log_pp::BasicLogger<char> {
+    std::vector<log_pp::Record> records{};
+
+    bool enabled(const log_pp::BasicMetadata<char>&) const noexcept override {
+        return true;
+    }
+
+    void log(const log_pp::BasicRecord<char>& record) override {
+        records.push_back(record);
+    }
+
+    void flush() override {}
+};
+
+}  // namespace
+
+TEST(log_pp_thread_info, id_is_cached_per_thread) {
+    const auto& info = log_pp::current_thread();
+    EXPECT_NE(0u, info.id);
+    EXPECT_EQ(&info, &log_pp::current_thread());
+
+    uint64_t other_id = 0;
+    std::thread([&] { other_id = log_pp::current_thread().id; }).join();
+    EXPECT_NE(0u, other_id);
+    EXPECT_NE(info.id, other_id);
+}
+
+TEST(log_pp_thread_info, names_are_truncated_to_capacity) {
+    std::string name;
+    std::thread([&] {
+        log_pp::set_thread_name("a-rather-long-thread-name");
+        name = std::string(log_pp::current_thread().get_name());
+    }).join();
+    EXPECT_EQ("a-rather-long-t", name);
+    EXPECT_EQ(log_pp::ThreadInfo::NAME_CAPACITY, name.size());
+}
+
+TEST(log_pp_thread_info, records_keep_producer_identity_when_rendered_later) {
+    QueueLogger logger;
+    uint64_t worker_id = 0;
+    std::thread([&] {
+        log_pp::set_thread_name("worker");
+        worker_id = log_pp::current_thread().id;
+        LOG_PP_INFO(logger, "from worker");
+    }).join();
+    log_pp::set_thread_name("main");
+    LOG_PP_INFO(logger, "from main");
+    ASSERT_EQ(2u, logger.records.size());
+
+    log_pp::PatternFormatter formatter("%t %T %v");
+    std::string out;
+    formatter.encode(logger.records[0], out);
+    EXPECT_EQ(std::to_string(worker_id) + " worker from worker\n", out);
+
+    out.clear();
+    formatter.encode(logger.records[1], out);
+    EXPECT_EQ(std::to_string(log_pp::current_thread().id) +
+                  " main from main\n",
+              out);
+
+    out.clear();
+    log_pp::JsonEncoder{}.encode(logger.records[0], out);
+    EXPECT_NE(std::string::npos,
+              out.find(",\"thread\":" + std::to_string(worker_id) +
+                       ",\"thread_name\":\"worker\","));
+}
+
+TEST(log_pp_thread_info, hand_built_records_have_no_thread) {
+    auto record = log_pp::RecordBuilder{}.build();
+    EXPECT_FALSE(record.get_thread_id().has_value());
+    EXPECT_FALSE(record.get_thread_name().has_value());
+}
@@ -0,0 +1,97 @@
+#include <atomic>
+#include <optional>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+
+namespace {
+
+struct CountingLogger : public log_pp::BasicLogger<char> {
+    std::atomic<int> calls{0};
+
+    bool enabled(const log_pp::BasicMetadata<char>&) const noexcept override {
+        return true;
+    }
+
+    void log(const log_pp::BasicRecord<char>&) noexcept override {
+        calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void flush() noexcept override {}
+};
+
+}  // namespace
+
+TEST(log_pp_thread_level, guard_overrides_current_thread_only) {
+    CountingLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Warn);
+    {
+        log_pp::ThreadLevelGuard verbose(log_pp::LevelFilter::Trace);
+        EXPECT_EQ(log_pp::LevelFilter::Trace, log_pp::max_level());
+        LOG_PP_TRACE(logger, "here");
+        EXPECT_EQ(1, logger.calls.load());
+
+        std::thread other([&] {
+            EXPECT_EQ(log_pp::LevelFilter::Warn, log_pp::max_level());
+            LOG_PP_TRACE(logger, "elsewhere");
+        });
+        other.join();
+        EXPECT_EQ(1, logger.calls.load());
+    }
+    EXPECT_EQ(log_pp::LevelFilter::Warn, log_pp::max_level());
+    LOG_PP_TRACE(logger, "after");
+    EXPECT_EQ(1, logger.calls.load());
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+TEST(log_pp_thread_level, guards_nest_and_can_lower) {
+    CountingLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Info);
+    {
+        log_pp::ThreadLevelGuard quiet(log_pp::LevelFilter::Off);
+        LOG_PP_ERROR(logger, "dropped");
+        {
+            log_pp::ThreadLevelGuard verbose(log_pp::LevelFilter::Debug);
+            LOG_PP_DEBUG(logger, "kept");
+            // The global level still changes underneath the override.
+            log_pp::set_max_level(log_pp::LevelFilter::Error);
+            EXPECT_EQ(log_pp::LevelFilter::Debug, log_pp::max_level());
+        }
+        EXPECT_EQ(log_pp::LevelFilter::Off, log_pp::max_level());
+    }
+    EXPECT_EQ(log_pp::LevelFilter::Error, log_pp::max_level());
+    EXPECT_EQ(1, logger.calls.load());
+    EXPECT_FALSE(log_pp::set_thread_max_level(std::nullopt).has_value());
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
+
+TEST(log_pp_thread_level, guard_raises_statements_a_rule_covers) {
+    CountingLogger logger;
+    log_pp::set_max_level(log_pp::LevelFilter::Info);
+    log_pp::set_callsite_rules({
+        {.file = "tests/thread_level_test.cpp",
+         .level = log_pp::LevelFilter::Warn},
+    });
+    auto debug = [&] { LOG_PP_DEBUG(logger, "debug"); };
+    auto warn = [&] { LOG_PP_WARN(logger, "warn"); };
+
+    debug();
+    EXPECT_EQ(0, logger.calls.load());
+    {
+        // The more verbose of the rule and the override applies.
+        log_pp::ThreadLevelGuard verbose(log_pp::LevelFilter::Debug);
+        debug();
+        EXPECT_EQ(1, logger.calls.load());
+    }
+    {
+        log_pp::ThreadLevelGuard quiet(log_pp::LevelFilter::Off);
+        warn();
+        EXPECT_EQ(2, logger.calls.load());
+    }
+    debug();
+    EXPECT_EQ(2, logger.calls.load());
+    log_pp::set_callsite_rules({});
+    log_pp::set_max_level(log_pp::LevelFilter::Trace);
+}
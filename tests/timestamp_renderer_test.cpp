@@ -0,0 +1,92 @@
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "log.hpp"
+#include "pattern_formatter.hpp"
+#include "timestamp_renderer.hpp"
+
+namespace {
+
+using namespace std::chrono;
+
+// 2026-10-16T12:34:56.123456789Z
+const system_clock::time_point SAMPLE =
+    time_point_cast<system_clock::duration>(
+        sys_days(year(2026) / October / 16) + hours(12) + minutes(34) +
+        seconds(56) + nanoseconds(123'456'789));
+
+std::string render(const log_pp::TimestampRenderer& renderer,
+                   system_clock::time_point time) {
+    std::string out;
+    renderer.append(out, time);
+    return out;
+}
+
+}  // namespace
+
+TEST(log_pp_timestamp_renderer, renders_utc_with_precision) {
+    EXPECT_EQ("2026-10-16T12:34:56.123456Z",
+              render(log_pp::TimestampRenderer(), SAMPLE));
+    EXPECT_EQ("2026-10-16T12:34:56Z",
+              render(log_pp::TimestampRenderer(
+                         {.precision = log_pp::TimestampPrecision::Seconds}),
+                     SAMPLE));
+    EXPECT_EQ("2026-10-16T12:34:56.123Z",
+              render(log_pp::TimestampRenderer(
+                         {.precision = log_pp::TimestampPrecision::Millis}),
+                     SAMPLE));
+    if constexpr (system_clock::period::den >= 1'000'000'000) {
+        EXPECT_EQ("2026-10-16T12:34:56.123456789Z",
+                  render(log_pp::TimestampRenderer(
+                             {.precision = log_pp::TimestampPrecision::Nanos}),
+                         SAMPLE));
+    }
+    EXPECT_EQ("2026-10-16 12:34:56.123456",
+              render(log_pp::TimestampRenderer(
+                         {.separator = ' ', .show_offset = false}),
+                     SAMPLE));
+}
+
+TEST(log_pp_timestamp_renderer, applies_utc_offsets) {
+    log_pp::TimestampRenderer tokyo({.utc_offset = hours(9)});
+    EXPECT_EQ("2026-10-16T21:34:56.123456+09:00", render(tokyo, SAMPLE));
+
+    log_pp::TimestampRenderer west({.utc_offset = -(hours(13) + minutes(30))});
+    EXPECT_EQ("2026-10-15T23:04:56.123456-13:30", render(west, SAMPLE));
+}
+
+TEST(log_pp_timestamp_renderer, cache_follows_time_in_any_direction) {
+    log_pp::TimestampRenderer renderer(
+        {.precision = log_pp::TimestampPrecision::Millis});
+    auto midnight = sys_days(year(2024) / February / 28) + hours(24);
+    EXPECT_EQ("2024-02-29T00:00:00.000Z", render(renderer, midnight));
+    EXPECT_EQ("2024-02-29T00:00:00.999Z",
+              render(renderer, midnight + milliseconds(999)));
+    EXPECT_EQ("2024-02-29T00:00:01.000Z",
+              render(renderer, midnight + seconds(1)));
+    EXPECT_EQ("2024-02-29T00:01:00.000Z",
+              render(renderer, midnight + minutes(1)));
+    EXPECT_EQ("2024-02-28T23:59:59.999Z",
+              render(renderer, midnight - milliseconds(1)));
+    EXPECT_EQ("1969-12-31T23:59:59.500Z",
+              render(renderer, system_clock::time_point(milliseconds(-500))));
+}
+
+TEST(log_pp_timestamp_renderer, pattern_formatter_flags) {
+    auto record = log_pp::RecordBuilder{}
+                      .set_level(log_pp::Level::Info)
+                      .set_format_string("ready")
+                      .set_timestamp(log_pp::Timestamp{static_cast<uint64_t>(
+                          duration_cast<nanoseconds>(
+                              SAMPLE.time_since_epoch())
+                              .count())})
+                      .build();
+    log_pp::PatternFormatter formatter(
+        "%i|%H:%M%z|%v", {.precision = log_pp::TimestampPrecision::Millis,
+                          .utc_offset = hours(-4)});
+    std::string out;
+    formatter.encode(record, out);
+    EXPECT_EQ("2026-10-16T08:34:56.123-04:00|08:34-04:00|ready\n", out);
+}